@@ -0,0 +1,155 @@
+﻿/**
+ * @file cache.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief LRU/LFU 缓存头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdint.h>
+
+#include <status.h>
+
+typedef int ElemType;
+
+/* 淘汰策略. */
+typedef enum CachePolicy
+{
+    CACHE_LRU, // 淘汰最久未访问的项.
+    CACHE_LFU  // 淘汰访问次数最少的项, 次数相同时淘汰最久未访问的.
+} CachePolicy;
+
+/**
+ * @brief 缓存项被淘汰, 覆盖或删除时的回调, 用于释放 value.
+ * @param key 键.
+ * @param value 值.
+ * @param arg InitCache() 时传入的参数.
+ */
+typedef void (*CacheEvict)(ElemType key, void *value, void *arg);
+
+/* 缓存项. 所有链接都是下标, 0 表示空. */
+typedef struct CacheEntry
+{
+    ElemType key;
+    /* 散列链的后继. */
+    uint32_t hnext;
+    /* 所在频度桶中的前驱和后继. */
+    uint32_t prior, next;
+    /* 所在频度桶. */
+    uint32_t bucket;
+    void *value;
+} CacheEntry;
+
+/**
+ * 频度桶. 访问次数相同的缓存项按访问先后链在同一个桶里, 各桶按次数递增
+ * 链接, 空桶立即回收. LRU 策略只用一个桶.
+ */
+typedef struct CacheBucket
+{
+    unsigned long long freq;
+    /* 桶中最久和最近访问的项. */
+    uint32_t first, last;
+    /* 前后相邻的桶. 0 号桶是哨兵, 其 next 为次数最少的桶. */
+    uint32_t prior, next;
+} CacheBucket;
+
+/* 命中统计. */
+typedef struct CacheStat
+{
+    unsigned long long hits, misses, inserts, evictions;
+} CacheStat;
+
+/**
+ * 容量固定的缓存. 散列表把键映射到缓存项, 缓存项挂在频度桶中.
+ * LccateElem_D2() 每次访问都要线性查找再线性地重新插入; 这里查找是一次散列,
+ * 访问次数加一只需把项移到相邻的桶, 淘汰取第一个桶的第一项, 都是 O(1).
+ * 缓存项和桶在初始化时一次分配好, 运行中不再分配内存.
+ */
+typedef struct Cache
+{
+    CachePolicy policy;
+    /* 容量和当前项数. */
+    uint32_t capacity, count;
+    /* 缓存项数组, 0 号未用; free 为空闲项链, 以 next 链接. */
+    CacheEntry *entry;
+    uint32_t free;
+    /* 频度桶数组, 0 号为哨兵; freeBucket 为空闲桶链. */
+    CacheBucket *bucket;
+    uint32_t freeBucket;
+    /* 散列表, 2^hashBits 个链头. */
+    uint32_t *head;
+    int hashBits;
+    /* 回调及其参数. */
+    CacheEvict evict;
+    void *arg;
+    CacheStat stat;
+} Cache;
+
+/**
+ * @brief 构造一个空的缓存 C.
+ * @param C 指向未初始化过的缓存的指针.
+ * @param capacity 容量, 1 <= capacity < 2^31.
+ * @param policy 淘汰策略.
+ * @param evict 回调, 可以为 NULL.
+ * @param arg 传给回调的参数.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 容量不合法返回 ERROR.
+ */
+Status InitCache(Cache *C, uint32_t capacity, CachePolicy policy,
+                 CacheEvict evict, void *arg);
+
+/**
+ * @brief 销毁缓存 C, 对剩余的每一项调用回调.
+ * @param C 指向已存在缓存的指针.
+ */
+Status DestroyCache(Cache *C);
+
+/**
+ * @brief 查找键 key, 命中时计一次访问.
+ * @param C 缓存.
+ * @param key 键.
+ * @param value 用以返回值, 可以为 NULL.
+ * @return TRUE 命中返回 TRUE.
+ * @return FALSE 未命中返回 FALSE.
+ */
+Status CacheGet(Cache *C, ElemType key, void **value);
+
+/**
+ * @brief 放入键值对并计一次访问. 键已存在时替换值, 旧值交给回调; 缓存已满时
+ * 先按策略淘汰一项, 交给回调.
+ * @param C 缓存.
+ * @param key 键.
+ * @param value 值.
+ */
+Status CachePut(Cache *C, ElemType key, void *value);
+
+/**
+ * @brief 删除键 key, 值交给回调.
+ * @param C 缓存.
+ * @param key 键.
+ * @return OK 删除成功返回 OK.
+ * @return ERROR 键不存在返回 ERROR.
+ */
+Status CacheErase(Cache *C, ElemType key);
+
+/**
+ * @brief 返回键 key 的访问次数, 不计为访问. LRU 策略下总是 1.
+ * @param C 缓存.
+ * @param key 键.
+ * @return 访问次数, 键不存在时返回 0.
+ */
+unsigned long long CacheFrequency(const Cache *C, ElemType key);
+
+/**
+ * @brief 打印缓存的命中统计.
+ * @param C 缓存.
+ */
+void PrintCacheStat(const Cache *C);
+
+#endif /* CACHE_H */
@@ -12,6 +12,9 @@
 #ifndef CLINKLIST_H
 #define CLINKLIST_H
 
+#include <linearlist/linklist/listsort.h>
+#include <linearlist/linklist/nodepool.h>
+#include <linearlist/sqlist/listfile.h>
 #include <status.h>
 
 typedef int ElemType;
@@ -43,6 +46,46 @@ Status HeadInsert_C(CLinklist L, ElemType e);
  */
 Status TailInsert_C(CLinklist L, ElemType e);
 
+/**
+ * @brief 由数组 a 的 n 个元素依次建立单向循环链表 L. 全部结点一次连续分配, 在内存
+ * 中按表中顺序排列, 之后的遍历是顺序访存.
+ * @param L 指向未初始化过的单向循环链表的指针.
+ * @param a 数组.
+ * @param n 元素个数.
+ * @return OK 建立成功返回 OK.
+ * @return ERROR n < 0 时返回 ERROR.
+ */
+Status CreateList_C(CLinklist *L, const ElemType *a, int n);
+
+/**
+ * @brief 把单向循环链表 L 的元素依次复制到数组 a. 遍历时预取后面的结点.
+ * @param L 单向循环链表.
+ * @param a 数组.
+ * @param max 最多复制的元素个数.
+ * @return 复制的元素个数.
+ */
+int ListToArray_C(CLinklist L, ElemType *a, int max);
+
+/**
+ * @brief 把单向循环链表 L 存入文件, 格式见 listfile.h. 只存元素序列, 先数
+ * 出表长, 再沿链写出.
+ * @param L 单向循环链表.
+ * @param fp 以二进制写方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status SaveList_C(CLinklist L, FILE *fp);
+
+/**
+ * @brief 从文件读入单向循环链表 L, 任何一种线性表存的文件都可以读入. 全部结点一次
+ * 连续分配, 元素直接读进各结点的数据域, 再按顺序链接.
+ * @param L 指向未初始化过的单向循环链表的指针, 失败时不建立链表.
+ * @param fp 以二进制读方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 读取失败, 格式不符或校验和不符返回 ERROR.
+ */
+Status LoadList_C(CLinklist *L, FILE *fp);
+
 /**
  * @brief 按序号查找结点值.
  * @param L 单项循环链表.
@@ -75,6 +118,13 @@ Status ListInsert_C(CLinklist L, int i, ElemType e);
  * */
 Status ListDelete_C(CLinklist L, int i);
 
+/**
+ * @brief 销毁单向循环链表 L. 结点都从 L 的结点池中分配, 释放头结点时随结点池一并
+ * 释放, 与结点个数无关.
+ * @param L 指向已存在单向循环链表的指针, 销毁后置为 NULL.
+ */
+Status DestroyList_C(CLinklist *L);
+
 /**
  * @brief 返回 L 中数据元素个数.
  * @param L 单项循环链表.
@@ -88,6 +138,13 @@ int ListLength_C(CLinklist L);
  */
 void PrintList_C(CLinklist L);
 
+/**
+ * @brief 使单向循环链表元素非递减, 见 ListSortMode.
+ * @param L 单向循环链表.
+ * @param mode 排序方式.
+ */
+void Sort_C(CLinklist L, ListSortMode mode);
+
 /**
  * @brief 19, 在一个结点值均为正整数的单向循环链表中, 反复找出最小值并输出,然后
  * 将该结点从链表中删除, 直到链表为空, 在删除头结点.
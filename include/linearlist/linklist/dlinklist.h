@@ -12,6 +12,9 @@
 #ifndef DLINKLIST_H
 #define DLINKLIST_H
 
+#include <linearlist/linklist/listsort.h>
+#include <linearlist/linklist/nodepool.h>
+#include <linearlist/sqlist/listfile.h>
 #include <status.h>
 
 typedef int ElemType;
@@ -44,6 +47,46 @@ Status HeadInsert_D(DLinklist L, ElemType e);
  */
 Status TailInsert_D(DLinklist L, ElemType e);
 
+/**
+ * @brief 由数组 a 的 n 个元素依次建立双向链表 L. 全部结点一次连续分配, 在内存
+ * 中按表中顺序排列, 之后的遍历是顺序访存.
+ * @param L 指向未初始化过的双向链表的指针.
+ * @param a 数组.
+ * @param n 元素个数.
+ * @return OK 建立成功返回 OK.
+ * @return ERROR n < 0 时返回 ERROR.
+ */
+Status CreateList_D(DLinklist *L, const ElemType *a, int n);
+
+/**
+ * @brief 把双向链表 L 的元素依次复制到数组 a. 遍历时预取后面的结点.
+ * @param L 双向链表.
+ * @param a 数组.
+ * @param max 最多复制的元素个数.
+ * @return 复制的元素个数.
+ */
+int ListToArray_D(DLinklist L, ElemType *a, int max);
+
+/**
+ * @brief 把双向链表 L 存入文件, 格式见 listfile.h. 只存元素序列, 不存访问
+ * 频度, 读入后频度都为 0.
+ * @param L 双向链表.
+ * @param fp 以二进制写方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status SaveList_D(DLinklist L, FILE *fp);
+
+/**
+ * @brief 从文件读入双向链表 L, 任何一种线性表存的文件都可以读入. 全部结点一次
+ * 连续分配, 元素直接读进各结点的数据域, 再按顺序链接.
+ * @param L 指向未初始化过的双向链表的指针, 失败时不建立链表.
+ * @param fp 以二进制读方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 读取失败, 格式不符或校验和不符返回 ERROR.
+ */
+Status LoadList_D(DLinklist *L, FILE *fp);
+
 /**
  * @brief 按序号查找结点值.
  * @param L 双向链表.
@@ -87,6 +130,13 @@ Status ListInsert_D(DLinklist *L, int i, ElemType e);
  * */
 Status ListDelete_D(DLinklist *L, int i);
 
+/**
+ * @brief 销毁双向链表 L. 结点都从 L 的结点池中分配, 释放头结点时随结点池一并
+ * 释放, 与结点个数无关.
+ * @param L 指向已存在双向链表的指针, 销毁后置为 NULL.
+ */
+Status DestroyList_D(DLinklist *L);
+
 /**
  * @brief 返回双向链表 L 中数据元素个数.
  * @param L 双向链表.
@@ -100,4 +150,12 @@ int ListLength_D(DLinklist L);
  */
 void PrintList_D(DLinklist L);
 
+/**
+ * @brief 使双向链表元素非递减, 排序后重建前驱指针. freq 域属于结点, 要跟着
+ * 数据一起走, 所以总是归并重链, 忽略 LIST_SORT_ARRAY.
+ * @param L 双向链表.
+ * @param mode 排序方式.
+ */
+void Sort_D(DLinklist L, ListSortMode mode);
+
 #endif /* DLINKLIST_H */
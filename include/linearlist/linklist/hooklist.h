@@ -0,0 +1,636 @@
+﻿/**
+ * @file hooklist.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 侵入式链表头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef HOOKLIST_H
+#define HOOKLIST_H
+
+#include <stddef.h>
+
+/**
+ * 侵入式链表. 链表不再拥有结点, 而是把挂钩 (只有指针的小结构体) 嵌入到用户
+ * 自己的记录中, 记录加入链表时不需要再分配结点, 遍历时也不必再经过一次指针
+ * 间接访问数据. 一个记录嵌入几个挂钩就可以同时属于几个链表. 链表只管链接,
+ * 记录的内存由用户管理, 记录在链表中时不能释放.
+ *
+ * 挂钩上的操作对任何记录类型都适用; DEFINE_SLIST, DEFINE_CLIST 和
+ * DEFINE_DLIST 为具体的记录类型生成带类型的链表, 操作都是 static inline,
+ * 编译后与手写的链表操作相同, 也不需要各链表共用 ElemType.
+ */
+
+/* 由成员 member 的地址 ptr 得到包含它的 type 类型记录的地址. */
+#define CONTAINER_OF(ptr, type, member)                                        \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/* 单向挂钩, 用于单向链表和单向循环链表. */
+typedef struct SHook
+{
+    struct SHook *next;
+} SHook;
+
+/* 双向挂钩, 用于双向循环链表. */
+typedef struct DHook
+{
+    struct DHook *prior, *next;
+} DHook;
+
+/* 以 NULL 结尾的单向链表. */
+typedef struct SHookList
+{
+    SHook *first;
+} SHookList;
+
+/**
+ * @brief 构造一个空的单向挂钩链表.
+ * @param L 指向未初始化过的链表的指针.
+ */
+static inline void InitList_SH(SHookList *L)
+{
+    L->first = NULL;
+}
+
+/**
+ * @brief 判断链表是否为空.
+ * @param L 指向已初始化的链表的指针.
+ * @return 空表返回非零, 否则返回 0.
+ */
+static inline int ListEmpty_SH(const SHookList *L)
+{
+    return L->first == NULL;
+}
+
+/**
+ * @brief 把挂钩 x 插到表头, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void PushFront_SH(SHookList *L, SHook *x)
+{
+    x->next = L->first;
+    L->first = x;
+}
+
+/**
+ * @brief 摘下第一个挂钩, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @return 摘下的挂钩, 空表时返回 NULL, 表不变.
+ */
+static inline SHook *PopFront_SH(SHookList *L)
+{
+    SHook *x = L->first;
+
+    if (x)
+    {
+        L->first = x->next;
+    }
+
+    return x;
+}
+
+/**
+ * @brief 把挂钩 x 插到 pos 之后, O(1).
+ * @param pos 表中的挂钩.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void InsertAfter_SH(SHook *pos, SHook *x)
+{
+    x->next = pos->next;
+    pos->next = x;
+}
+
+/**
+ * @brief 摘下 pos 的后继, O(1).
+ * @param pos 表中的挂钩.
+ * @return 摘下的挂钩, pos 是最后一个时返回 NULL, 表不变.
+ */
+static inline SHook *RemoveAfter_SH(SHook *pos)
+{
+    SHook *x = pos->next;
+
+    if (x)
+    {
+        pos->next = x->next;
+    }
+
+    return x;
+}
+
+/**
+ * 单向循环链表. 只保存尾挂钩, 尾的后继就是第一个, 因此头插, 尾插和删除第一个
+ * 都是 O(1), 适合做队列.
+ */
+typedef struct CHookList
+{
+    SHook *tail;
+} CHookList;
+
+/**
+ * @brief 构造一个空的单向循环挂钩链表.
+ * @param L 指向未初始化过的链表的指针.
+ */
+static inline void InitList_CH(CHookList *L)
+{
+    L->tail = NULL;
+}
+
+/**
+ * @brief 判断链表是否为空.
+ * @param L 指向已初始化的链表的指针.
+ * @return 空表返回非零, 否则返回 0.
+ */
+static inline int ListEmpty_CH(const CHookList *L)
+{
+    return L->tail == NULL;
+}
+
+/**
+ * @brief 取第一个挂钩, 即尾的后继.
+ * @param L 指向已初始化的链表的指针.
+ * @return 第一个挂钩, 空表时返回 NULL.
+ */
+static inline SHook *First_CH(const CHookList *L)
+{
+    return L->tail ? L->tail->next : NULL;
+}
+
+/**
+ * @brief 取 x 的后继. 链表是循环的, 到尾时返回 NULL 以便遍历结束.
+ * @param L 指向 x 所在链表的指针.
+ * @param x 表中的挂钩.
+ * @return x 的后继, x 是尾时返回 NULL.
+ */
+static inline SHook *Next_CH(const CHookList *L, const SHook *x)
+{
+    return x == L->tail ? NULL : x->next;
+}
+
+/**
+ * @brief 把挂钩 x 插到表头, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void PushFront_CH(CHookList *L, SHook *x)
+{
+    if (L->tail)
+    {
+        x->next = L->tail->next;
+        L->tail->next = x;
+    }
+    else
+    {
+        x->next = x;
+        L->tail = x;
+    }
+}
+
+/**
+ * @brief 把挂钩 x 插到表尾, O(1). 先插到表头再让它成为尾.
+ * @param L 指向已初始化的链表的指针.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void PushBack_CH(CHookList *L, SHook *x)
+{
+    PushFront_CH(L, x);
+    L->tail = x;
+}
+
+/**
+ * @brief 摘下第一个挂钩, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @return 摘下的挂钩, 空表时返回 NULL, 表不变.
+ */
+static inline SHook *PopFront_CH(CHookList *L)
+{
+    SHook *x = First_CH(L);
+
+    if (x == L->tail)
+    {
+        L->tail = NULL;
+    }
+    else if (x)
+    {
+        L->tail->next = x->next;
+    }
+
+    return x;
+}
+
+/**
+ * @brief 把 M 的全部挂钩按原顺序接到 L 之后, O(1), M 变为空表.
+ * @param L 指向已初始化的链表的指针.
+ * @param M 指向另一个已初始化的链表的指针, 可以为空表.
+ */
+static inline void Splice_CH(CHookList *L, CHookList *M)
+{
+    if (!M->tail)
+    {
+        return;
+    }
+
+    if (L->tail)
+    {
+        SHook *first = L->tail->next;
+        L->tail->next = M->tail->next;
+        M->tail->next = first;
+    }
+    L->tail = M->tail;
+    M->tail = NULL;
+}
+
+/**
+ * 带头挂钩的双向循环链表. 头挂钩是哨兵, 空表时前驱和后继都指向自己, 插入和
+ * 删除不需要判断边界, 已知挂钩时删除为 O(1).
+ */
+typedef struct DHookList
+{
+    DHook head;
+} DHookList;
+
+/**
+ * @brief 构造一个空的双向循环挂钩链表, 头挂钩的前驱和后继都指向自己.
+ * @param L 指向未初始化过的链表的指针.
+ */
+static inline void InitList_DH(DHookList *L)
+{
+    L->head.prior = L->head.next = &L->head;
+}
+
+/**
+ * @brief 判断链表是否为空.
+ * @param L 指向已初始化的链表的指针.
+ * @return 空表返回非零, 否则返回 0.
+ */
+static inline int ListEmpty_DH(const DHookList *L)
+{
+    return L->head.next == &L->head;
+}
+
+/**
+ * @brief 取第一个挂钩.
+ * @param L 指向已初始化的链表的指针.
+ * @return 第一个挂钩, 空表时返回 NULL 而不是头挂钩.
+ */
+static inline DHook *First_DH(const DHookList *L)
+{
+    return ListEmpty_DH(L) ? NULL : L->head.next;
+}
+
+/**
+ * @brief 取最后一个挂钩.
+ * @param L 指向已初始化的链表的指针.
+ * @return 最后一个挂钩, 空表时返回 NULL 而不是头挂钩.
+ */
+static inline DHook *Last_DH(const DHookList *L)
+{
+    return ListEmpty_DH(L) ? NULL : L->head.prior;
+}
+
+/**
+ * @brief 取 x 的后继.
+ * @param L 指向 x 所在链表的指针.
+ * @param x 表中的挂钩.
+ * @return x 的后继, x 是最后一个时返回 NULL.
+ */
+static inline DHook *Next_DH(const DHookList *L, const DHook *x)
+{
+    return x->next == &L->head ? NULL : x->next;
+}
+
+/**
+ * @brief 取 x 的前驱.
+ * @param L 指向 x 所在链表的指针.
+ * @param x 表中的挂钩.
+ * @return x 的前驱, x 是第一个时返回 NULL.
+ */
+static inline DHook *Prior_DH(const DHookList *L, const DHook *x)
+{
+    return x->prior == &L->head ? NULL : x->prior;
+}
+
+/**
+ * @brief 把挂钩 x 插到 pos 之后, O(1).
+ * @param pos 表中的挂钩, 可以是头挂钩.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void InsertAfter_DH(DHook *pos, DHook *x)
+{
+    x->prior = pos;
+    x->next = pos->next;
+    pos->next->prior = x;
+    pos->next = x;
+}
+
+/**
+ * @brief 把挂钩 x 插到 pos 之前, O(1).
+ * @param pos 表中的挂钩, 可以是头挂钩.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void InsertBefore_DH(DHook *pos, DHook *x)
+{
+    InsertAfter_DH(pos->prior, x);
+}
+
+/**
+ * @brief 把挂钩 x 插到表头, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void PushFront_DH(DHookList *L, DHook *x)
+{
+    InsertAfter_DH(&L->head, x);
+}
+
+/**
+ * @brief 把挂钩 x 插到表尾, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @param x 不在任何链表中的挂钩.
+ */
+static inline void PushBack_DH(DHookList *L, DHook *x)
+{
+    InsertAfter_DH(L->head.prior, x);
+}
+
+/**
+ * @brief 从所在链表中摘下 x, O(1), 不需要知道是哪个链表. 摘下后 x 自成一环,
+ * 所以对已摘下的挂钩再次调用没有影响.
+ * @param x 表中的挂钩或已摘下的挂钩, 不能是头挂钩.
+ */
+static inline void Remove_DH(DHook *x)
+{
+    x->prior->next = x->next;
+    x->next->prior = x->prior;
+    x->prior = x->next = x;
+}
+
+/**
+ * @brief 摘下第一个挂钩, O(1).
+ * @param L 指向已初始化的链表的指针.
+ * @return 摘下的挂钩, 空表时返回 NULL, 表不变.
+ */
+static inline DHook *PopFront_DH(DHookList *L)
+{
+    DHook *x = First_DH(L);
+
+    if (x)
+    {
+        Remove_DH(x);
+    }
+
+    return x;
+}
+
+/**
+ * @brief 把 M 的全部挂钩按原顺序接到 L 之后, O(1), M 变为空表.
+ * @param L 指向已初始化的链表的指针.
+ * @param M 指向另一个已初始化的链表的指针, 可以为空表.
+ */
+static inline void Splice_DH(DHookList *L, DHookList *M)
+{
+    if (ListEmpty_DH(M))
+    {
+        return;
+    }
+
+    DHook *first = M->head.next, *last = M->head.prior;
+
+    first->prior = L->head.prior;
+    L->head.prior->next = first;
+    last->next = &L->head;
+    L->head.prior = last;
+
+    InitList_DH(M);
+}
+
+/**
+ * 带类型链表的遍历. Name 为 DEFINE_*LIST 中的链表名, x 为已声明的记录指针.
+ * 遍历过程中不能摘下 x.
+ */
+#define FOREACH_HOOK(Name, L, x)                                               \
+    for ((x) = First_##Name(L); (x); (x) = Next_##Name((L), (x)))
+
+/**
+ * 生成记录类型 T 的单向链表类型 Name, 挂钩为 T 中类型为 SHook 的成员
+ * member. 生成的操作以 _Name 为后缀, 参数和返回值与对应的 _SH 操作相同,
+ * 只是挂钩换成了记录指针 T *:
+ *
+ *   void Init(Name *L), int Empty(const Name *L): 同 InitList_SH(),
+ *   ListEmpty_SH().
+ *   T *Entry(const SHook *h): 由挂钩得到记录, h 为 NULL 时返回 NULL.
+ *   T *First(const Name *L): 第一个记录, 空表时返回 NULL.
+ *   T *Next(const Name *L, const T *x): x 的后继, x 是最后一个时返回 NULL.
+ *   void PushFront(Name *L, T *x): 把不在本链表中的 x 插到表头.
+ *   T *PopFront(Name *L): 摘下第一个记录, 空表时返回 NULL, 表不变.
+ *   void InsertAfter(T *pos, T *x): 把 x 插到表中的 pos 之后.
+ *   T *RemoveAfter(T *pos): 摘下 pos 的后继, pos 是最后一个时返回 NULL.
+ */
+#define DEFINE_SLIST(Name, T, member)                                          \
+    typedef struct Name                                                        \
+    {                                                                          \
+        SHookList list;                                                        \
+    } Name;                                                                    \
+                                                                               \
+    static inline void Init_##Name(Name *L)                                    \
+    {                                                                          \
+        InitList_SH(&L->list);                                                 \
+    }                                                                          \
+                                                                               \
+    static inline int Empty_##Name(const Name *L)                              \
+    {                                                                          \
+        return ListEmpty_SH(&L->list);                                         \
+    }                                                                          \
+                                                                               \
+    static inline T *Entry_##Name(const SHook *h)                              \
+    {                                                                          \
+        return h ? CONTAINER_OF(h, T, member) : NULL;                          \
+    }                                                                          \
+                                                                               \
+    static inline T *First_##Name(const Name *L)                               \
+    {                                                                          \
+        return Entry_##Name(L->list.first);                                    \
+    }                                                                          \
+                                                                               \
+    static inline T *Next_##Name(const Name *L, const T *x)                    \
+    {                                                                          \
+        (void)L;                                                               \
+        return Entry_##Name(x->member.next);                                   \
+    }                                                                          \
+                                                                               \
+    static inline void PushFront_##Name(Name *L, T *x)                         \
+    {                                                                          \
+        PushFront_SH(&L->list, &x->member);                                    \
+    }                                                                          \
+                                                                               \
+    static inline T *PopFront_##Name(Name *L)                                  \
+    {                                                                          \
+        return Entry_##Name(PopFront_SH(&L->list));                            \
+    }                                                                          \
+                                                                               \
+    static inline void InsertAfter_##Name(T *pos, T *x)                        \
+    {                                                                          \
+        InsertAfter_SH(&pos->member, &x->member);                              \
+    }                                                                          \
+                                                                               \
+    static inline T *RemoveAfter_##Name(T *pos)                                \
+    {                                                                          \
+        return Entry_##Name(RemoveAfter_SH(&pos->member));                     \
+    }
+
+/**
+ * 生成记录类型 T 的单向循环链表类型 Name, 挂钩为 T 中类型为 SHook 的成员
+ * member. 操作以 _Name 为后缀, 与对应的 _CH 操作相同:
+ *
+ *   Init, Empty, Entry, First, PushFront: 同 DEFINE_SLIST.
+ *   T *Next(const Name *L, const T *x): x 的后继, x 是尾时返回 NULL.
+ *   void PushBack(Name *L, T *x): 把不在本链表中的 x 插到表尾.
+ *   T *PopFront(Name *L): 摘下第一个记录, 空表时返回 NULL, 表不变.
+ *   void Splice(Name *L, Name *M): 把 M 的全部记录接到 L 之后, M 变为空表.
+ *
+ * 没有 InsertAfter 和 RemoveAfter.
+ */
+#define DEFINE_CLIST(Name, T, member)                                          \
+    typedef struct Name                                                        \
+    {                                                                          \
+        CHookList list;                                                        \
+    } Name;                                                                    \
+                                                                               \
+    static inline void Init_##Name(Name *L)                                    \
+    {                                                                          \
+        InitList_CH(&L->list);                                                 \
+    }                                                                          \
+                                                                               \
+    static inline int Empty_##Name(const Name *L)                              \
+    {                                                                          \
+        return ListEmpty_CH(&L->list);                                         \
+    }                                                                          \
+                                                                               \
+    static inline T *Entry_##Name(const SHook *h)                              \
+    {                                                                          \
+        return h ? CONTAINER_OF(h, T, member) : NULL;                          \
+    }                                                                          \
+                                                                               \
+    static inline T *First_##Name(const Name *L)                               \
+    {                                                                          \
+        return Entry_##Name(First_CH(&L->list));                               \
+    }                                                                          \
+                                                                               \
+    static inline T *Next_##Name(const Name *L, const T *x)                    \
+    {                                                                          \
+        return Entry_##Name(Next_CH(&L->list, &x->member));                    \
+    }                                                                          \
+                                                                               \
+    static inline void PushFront_##Name(Name *L, T *x)                         \
+    {                                                                          \
+        PushFront_CH(&L->list, &x->member);                                    \
+    }                                                                          \
+                                                                               \
+    static inline void PushBack_##Name(Name *L, T *x)                          \
+    {                                                                          \
+        PushBack_CH(&L->list, &x->member);                                     \
+    }                                                                          \
+                                                                               \
+    static inline T *PopFront_##Name(Name *L)                                  \
+    {                                                                          \
+        return Entry_##Name(PopFront_CH(&L->list));                            \
+    }                                                                          \
+                                                                               \
+    static inline void Splice_##Name(Name *L, Name *M)                         \
+    {                                                                          \
+        Splice_CH(&L->list, &M->list);                                         \
+    }
+
+/**
+ * 生成记录类型 T 的双向循环链表类型 Name, 挂钩为 T 中类型为 DHook 的成员
+ * member. 操作以 _Name 为后缀, 与对应的 _DH 操作相同:
+ *
+ *   Init, Empty, Entry, First, Next, PushFront, PushBack, PopFront, Splice:
+ *   同 DEFINE_CLIST, First 和 PopFront 在空表时返回 NULL.
+ *   T *Last(const Name *L): 最后一个记录, 空表时返回 NULL.
+ *   T *Prior(const Name *L, const T *x): x 的前驱, x 是第一个时返回 NULL.
+ *   void InsertAfter(T *pos, T *x), void InsertBefore(T *pos, T *x): 把 x
+ *   插到表中的 pos 之后或之前.
+ *   void Remove(T *x): 从所在链表中摘下 x, O(1); 对已摘下的 x 没有影响.
+ */
+#define DEFINE_DLIST(Name, T, member)                                          \
+    typedef struct Name                                                        \
+    {                                                                          \
+        DHookList list;                                                        \
+    } Name;                                                                    \
+                                                                               \
+    static inline void Init_##Name(Name *L)                                    \
+    {                                                                          \
+        InitList_DH(&L->list);                                                 \
+    }                                                                          \
+                                                                               \
+    static inline int Empty_##Name(const Name *L)                              \
+    {                                                                          \
+        return ListEmpty_DH(&L->list);                                         \
+    }                                                                          \
+                                                                               \
+    static inline T *Entry_##Name(const DHook *h)                              \
+    {                                                                          \
+        return h ? CONTAINER_OF(h, T, member) : NULL;                          \
+    }                                                                          \
+                                                                               \
+    static inline T *First_##Name(const Name *L)                               \
+    {                                                                          \
+        return Entry_##Name(First_DH(&L->list));                               \
+    }                                                                          \
+                                                                               \
+    static inline T *Last_##Name(const Name *L)                                \
+    {                                                                          \
+        return Entry_##Name(Last_DH(&L->list));                                \
+    }                                                                          \
+                                                                               \
+    static inline T *Next_##Name(const Name *L, const T *x)                    \
+    {                                                                          \
+        return Entry_##Name(Next_DH(&L->list, &x->member));                    \
+    }                                                                          \
+                                                                               \
+    static inline T *Prior_##Name(const Name *L, const T *x)                   \
+    {                                                                          \
+        return Entry_##Name(Prior_DH(&L->list, &x->member));                   \
+    }                                                                          \
+                                                                               \
+    static inline void PushFront_##Name(Name *L, T *x)                         \
+    {                                                                          \
+        PushFront_DH(&L->list, &x->member);                                    \
+    }                                                                          \
+                                                                               \
+    static inline void PushBack_##Name(Name *L, T *x)                          \
+    {                                                                          \
+        PushBack_DH(&L->list, &x->member);                                     \
+    }                                                                          \
+                                                                               \
+    static inline void InsertAfter_##Name(T *pos, T *x)                        \
+    {                                                                          \
+        InsertAfter_DH(&pos->member, &x->member);                              \
+    }                                                                          \
+                                                                               \
+    static inline void InsertBefore_##Name(T *pos, T *x)                       \
+    {                                                                          \
+        InsertBefore_DH(&pos->member, &x->member);                             \
+    }                                                                          \
+                                                                               \
+    static inline void Remove_##Name(T *x)                                     \
+    {                                                                          \
+        Remove_DH(&x->member);                                                 \
+    }                                                                          \
+                                                                               \
+    static inline T *PopFront_##Name(Name *L)                                  \
+    {                                                                          \
+        return Entry_##Name(PopFront_DH(&L->list));                            \
+    }                                                                          \
+                                                                               \
+    static inline void Splice_##Name(Name *L, Name *M)                         \
+    {                                                                          \
+        Splice_DH(&L->list, &M->list);                                         \
+    }
+
+#endif /* HOOKLIST_H */
@@ -0,0 +1,147 @@
+﻿/**
+ * @file lflinklist.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 无锁有序单向链表头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef LFLINKLIST_H
+#define LFLINKLIST_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include <status.h>
+
+typedef int ElemType;
+
+/* 每个线程回收前缓存的空闲结点数上限, 超过的直接 free(). */
+#define LF_NODE_CACHE 256
+/* 每退休多少个结点尝试推进一次全局纪元. */
+#define LF_RETIRE_BATCH 64
+
+/**
+ * 无锁链表结点. next 的最低位是删除标记: 置位表示该结点已被逻辑删除, 此后
+ * next 不再改变, 任何以该结点为前驱的 CAS 都会失败.
+ */
+typedef struct LFNode
+{
+    ElemType data;
+    _Atomic(uintptr_t) next;
+} LFNode;
+
+/**
+ * 线程记录. 每个访问链表的线程持有一个, 用于基于纪元的内存回收: 摘下的结点
+ * 按退休时的纪元放入三个袋子之一, 等全局纪元前进三次, 所有可能还持有它的
+ * 线程都已离开, 才放入空闲结点缓存或释放.
+ */
+typedef struct LFThread
+{
+    /* 线程进入临界区时为 (纪元 << 1) | 1, 离开时为 0. */
+    _Atomic(uint64_t) state;
+    /* 记录是否已被某个线程占用. */
+    atomic_int inUse;
+    /* 所有记录组成的链表, 记录只增不减. */
+    struct LFThread *next;
+    /* 上次进入时看到的全局纪元. */
+    uint64_t epoch;
+    /* 三个纪元的待回收结点. 单独用数组保存, 不能借用结点的 next, 因为别的
+     * 线程可能还在沿着它遍历. */
+    LFNode **retired[3];
+    int retiredLength[3], retiredSize[3];
+    /* 退休结点计数, 用于定期推进纪元. */
+    unsigned int retiredCount;
+    /* 空闲结点缓存, 以 next 链接. */
+    LFNode *cache;
+    int cacheCount;
+} LFThread;
+
+/**
+ * 无锁有序集合链表 (Harris-Michael). 元素严格递增, 不允许重复. 插入和删除
+ * 都用 CAS 完成: 删除先在被删结点的 next 上置删除标记, 再把它从前驱摘下;
+ * 遍历时遇到带标记的结点顺手摘除. 查找不写任何共享数据.
+ */
+typedef struct LFList
+{
+    /* 头结点, 数据域不用. */
+    LFNode head;
+    /* 全局纪元. */
+    _Atomic(uint64_t) epoch;
+    /* 线程记录链表. */
+    _Atomic(LFThread *) threads;
+} LFList;
+
+/**
+ * @brief 构造一个空的无锁链表 L. 不是线程安全的.
+ * @param L 指向未初始化过的链表的指针.
+ */
+Status InitList_LF(LFList *L);
+
+/**
+ * @brief 销毁无锁链表 L, 释放全部结点和线程记录. 调用时不能再有线程访问 L.
+ * @param L 指向已存在链表的指针.
+ */
+Status DestroyList_LF(LFList *L);
+
+/**
+ * @brief 为当前线程取得一个线程记录, 优先复用已注销的记录. 线程访问 L 前
+ * 调用一次, 之后各操作都传入该记录.
+ * @param L 无锁链表.
+ * @return 线程记录.
+ */
+LFThread *RegisterThread_LF(LFList *L);
+
+/**
+ * @brief 注销线程记录. 记录中尚未回收的结点留给下一个使用者.
+ * @param L 无锁链表.
+ * @param T 线程记录.
+ */
+void UnregisterThread_LF(LFList *L, LFThread *T);
+
+/**
+ * @brief 插入元素 e, 无锁.
+ * @param L 无锁链表.
+ * @param T 当前线程的记录.
+ * @param e 要插入的元素.
+ * @return OK 插入成功返回 OK.
+ * @return ERROR e 已存在返回 ERROR.
+ */
+Status Insert_LF(LFList *L, LFThread *T, ElemType e);
+
+/**
+ * @brief 删除元素 e, 无锁.
+ * @param L 无锁链表.
+ * @param T 当前线程的记录.
+ * @param e 要删除的元素.
+ * @return OK 删除成功返回 OK.
+ * @return ERROR e 不存在返回 ERROR.
+ */
+Status Delete_LF(LFList *L, LFThread *T, ElemType e);
+
+/**
+ * @brief 查找元素 e, 只读, 无等待.
+ * @param L 无锁链表.
+ * @param T 当前线程的记录.
+ * @param e 要查找的元素.
+ * @return TRUE 存在返回 TRUE.
+ * @return FALSE 不存在返回 FALSE.
+ */
+Status Contains_LF(LFList *L, LFThread *T, ElemType e);
+
+/**
+ * @brief 返回未被删除的元素个数. 只在没有并发修改时准确.
+ * @param L 无锁链表.
+ */
+int ListLength_LF(LFList *L);
+
+/**
+ * @brief 打印无锁链表. 只在没有并发修改时使用.
+ * @param L 无锁链表.
+ */
+void PrintList_LF(LFList *L);
+
+#endif /* LFLINKLIST_H */
@@ -12,6 +12,9 @@
 #ifndef LINKLIST_H
 #define LINKLIST_H
 
+#include <linearlist/linklist/listsort.h>
+#include <linearlist/linklist/nodepool.h>
+#include <linearlist/sqlist/listfile.h>
 #include <status.h>
 
 typedef int ElemType;
@@ -43,6 +46,46 @@ Status HeadInsert_L(Linklist L, ElemType e);
  */
 Status TailInsert_L(Linklist L, ElemType e);
 
+/**
+ * @brief 由数组 a 的 n 个元素依次建立单向链表 L. 全部结点一次连续分配, 在内存
+ * 中按表中顺序排列, 之后的遍历是顺序访存.
+ * @param L 指向未初始化过的单向链表的指针.
+ * @param a 数组.
+ * @param n 元素个数.
+ * @return OK 建立成功返回 OK.
+ * @return ERROR n < 0 时返回 ERROR.
+ */
+Status CreateList_L(Linklist *L, const ElemType *a, int n);
+
+/**
+ * @brief 把单向链表 L 的元素依次复制到数组 a. 遍历时预取后面的结点.
+ * @param L 单向链表.
+ * @param a 数组.
+ * @param max 最多复制的元素个数.
+ * @return 复制的元素个数.
+ */
+int ListToArray_L(Linklist L, ElemType *a, int max);
+
+/**
+ * @brief 把单向链表 L 存入文件, 格式见 listfile.h. 存下的只是元素序列, 与
+ * 链接方式无关, 所以也可以作为顺序表映射. 先数出表长, 再沿链写出.
+ * @param L 单向链表.
+ * @param fp 以二进制写方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status SaveList_L(Linklist L, FILE *fp);
+
+/**
+ * @brief 从文件读入单向链表 L, 任何一种线性表存的文件都可以读入. 全部结点一次
+ * 连续分配, 元素直接读进各结点的数据域, 再按顺序链接.
+ * @param L 指向未初始化过的单向链表的指针, 失败时不建立链表.
+ * @param fp 以二进制读方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 读取失败, 格式不符或校验和不符返回 ERROR.
+ */
+Status LoadList_L(Linklist *L, FILE *fp);
+
 /**
  * @brief 按序号查找结点值.
  * @param L 单向链表.
@@ -76,6 +119,13 @@ Status ListInsert_L(Linklist L, int i, ElemType e);
  * */
 Status ListDelete_L(Linklist L, int i);
 
+/**
+ * @brief 销毁单向链表 L. 结点都从 L 的结点池中分配, 释放头结点时随结点池一并
+ * 释放, 与结点个数无关.
+ * @param L 指向已存在单向链表的指针, 销毁后置为 NULL.
+ */
+Status DestroyList_L(Linklist *L);
+
 /**
  * @brief 返回单向链表 L 中数据元素个数.
  * @param L 单向链表.
@@ -108,11 +158,19 @@ void Reverse_L1(Linklist L);
 void Reverse_L2(Linklist L);
 
 /**
- * @brief 6, 使单向链表元素递增. 直接插入排序. 
+ * @brief 6, 使单向链表元素递增. 用 Sort_L() 自动选择排序方式.
  * @param L 待排序单向链表.
  * */
 void Sort(Linklist L);
 
+/**
+ * @brief 使单向链表元素非递减. 归并方式只改链接, 数组方式只写回数据域,
+ * 见 ListSortMode.
+ * @param L 待排序单向链表.
+ * @param mode 排序方式.
+ */
+void Sort_L(Linklist L, ListSortMode mode);
+
 /**
  * @brief 7, 删除单向链表中所有介于给定的两个值之间的元素的元素.
  * @param L 待删除元素单向链表.
@@ -173,7 +231,34 @@ Linklist GetCommon(Linklist A, Linklist B);
 void Union(Linklist A, Linklist B);
 
 /**
- * @brief 16, 判断序列 B 是否是序列 A 的连续子序列.
+ * @brief 求交集, 结果放入新链表, 不破坏原表. A, B 的元素严格递增. 先把两表
+ * 复制到数组, 用 IntersectArray() 求解, 大小悬殊时倍增查找, 相近时按块比较.
+ * @see GetCommon(), 逐结点比较, 允许重复元素.
+ * @param A 单向链表.
+ * @param B 单向链表.
+ * @return 交集.
+ */
+Linklist Intersect_L(Linklist A, Linklist B);
+
+/**
+ * @brief 求并集, 结果放入新链表, 不破坏原表. A, B 的元素严格递增.
+ * @param A 单向链表.
+ * @param B 单向链表.
+ * @return 并集.
+ */
+Linklist Union_L(Linklist A, Linklist B);
+
+/**
+ * @brief 求差集 A - B, 结果放入新链表, 不破坏原表. A, B 的元素严格递增.
+ * @param A 单向链表.
+ * @param B 单向链表.
+ * @return 差集.
+ */
+Linklist Difference_L(Linklist A, Linklist B);
+
+/**
+ * @brief 16, 判断序列 B 是否是序列 A 的连续子序列. 以 B 为模式构造 KMP 匹配器,
+ * A 的结点逐个推入, 不需要回退, 时间复杂度 O(len1 + len2).
  * @param A 单向链表.
  * @param B 单向链表.
  * @return TRUE B 是 A 的连续子序列.
@@ -181,6 +266,16 @@ void Union(Linklist A, Linklist B);
  */
 Status Pattern(Linklist A, Linklist B);
 
+/**
+ * @brief 找出 B 在 A 中的全部出现位置 (可以重叠).
+ * @param A 单向链表.
+ * @param B 单向链表, 不为空.
+ * @param pos 用以返回各次出现的起始位序, 至多存 max 个, 可以为 NULL.
+ * @param max pos 的容量.
+ * @return 出现的总次数, 可能大于 max.
+ */
+int PatternAll(Linklist A, Linklist B, int *pos, int max);
+
 /**
  * @brief 21, 查找单向链表中倒数第 k 个位置上的结点. 若查找成功, 算法输出这个结点 data
  * 域的值, 并返回 1, 否则返回 0.
@@ -0,0 +1,63 @@
+﻿/**
+ * @file listsort.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 链表排序头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef LISTSORT_H
+#define LISTSORT_H
+
+#include <stddef.h>
+#include <status.h>
+
+typedef int ElemType;
+
+/**
+ * 链表排序方式.
+ *
+ * LIST_SORT_MERGE 自底向上归并, 只改链接不搬数据, 额外空间为 O(1) (64 个链头),
+ * 稳定, 结点连同其他数据域一起移动.
+ * LIST_SORT_ARRAY 把数据收集到数组中排好序再按原顺序写回, 链接不变. 数组顺序
+ * 访问, 大表时比在链上归并快得多, 但需要 O(n) 额外空间, 而且只搬数据域.
+ * LIST_SORT_AUTO 结点数不少于 LIST_SORT_ARRAY_MIN 时用数组方式, 否则归并.
+ */
+typedef enum ListSortMode
+{
+    LIST_SORT_AUTO,
+    LIST_SORT_MERGE,
+    LIST_SORT_ARRAY
+} ListSortMode;
+
+/**
+ * 自动选择数组方式的最少结点数. 实测 (sortbench) 一千个结点时两种方式相差不到
+ * 两成, 此时归并不需额外空间更划算; 上万个结点起数组方式快 3 倍以上, 链在内存中
+ * 顺序分布时快近 10 倍.
+ */
+#define LIST_SORT_ARRAY_MIN (1 << 12)
+
+/**
+ * @brief 把数组 a 排成非递减顺序. 元素较多时用按 11 位分组的 LSD 基数排序,
+ * 较少时用内省排序 (快速排序, 递归过深时改用堆排序, 小段插入排序).
+ * @param a 数组.
+ * @param n 元素个数.
+ */
+void SortValues(ElemType *a, int n);
+
+/**
+ * @brief 把 first 开始, 到 end 之前为止的一段链排成非递减顺序. 四种链表的结点
+ * 都以 ElemType 数据域开头, 后继指针在结点中的偏移为 nextOffset, 因此共用
+ * 同一份实现.
+ * @param first 第一个结点, 等于 end 时为空段.
+ * @param end 段尾之后的结点, 可以为 NULL.
+ * @param nextOffset 后继指针在结点中的偏移, 用 offsetof() 取得.
+ * @param mode 排序方式.
+ * @return 排序后的第一个结点, 最后一个结点的后继仍为 end.
+ */
+void *SortChain(void *first, void *end, size_t nextOffset, ListSortMode mode);
+
+#endif /* LISTSORT_H */
@@ -0,0 +1,154 @@
+﻿/**
+ * @file nodepool.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 链表结点池.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <stddef.h>
+
+#include <status.h>
+
+/* 第一块 slab 容纳的结点数. 之后每块加倍, 直到 NODE_SLAB_MAX. */
+#define NODE_SLAB_MIN 64
+/* 一块 slab 最多容纳的结点数. */
+#define NODE_SLAB_MAX 65536
+
+/* 预取结点, 沿链遍历时提前发出下一个结点的访存. */
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_NODE(p) __builtin_prefetch(p)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define PREFETCH_NODE(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define PREFETCH_NODE(p) ((void)(p))
+#endif
+
+typedef struct NodeSlab NodeSlab;
+
+/**
+ * 结点池. 每个链表有自己的结点池, 结点从成块分配的 slab 中顺序切出, 释放的
+ * 结点挂在池内的空闲链表上优先复用. 同一链表的结点大多相邻, 遍历时缓存友好;
+ * 销毁链表时只需释放各块 slab, 与结点个数无关.
+ *
+ * 结点在链表间转移时 (如合并两个链表), 两个结点池也随之合并: 被合并的池把
+ * slab 和空闲结点交给另一个池, 自己只作为转发到后者的存根, 类似并查集. 池的
+ * 引用计数包括直接持有它的链表和转发到它的存根, 计数归零时才释放.
+ */
+typedef struct NodePool
+{
+    /* 合并后转发到的结点池, 未被合并时为 NULL. */
+    struct NodePool *forward;
+    /* 引用计数. */
+    int refcount;
+    /* 结点字节数. */
+    size_t nodeSize;
+    /* 空闲结点链表, 以结点开头的指针链接. */
+    void *freeList;
+    /* 当前 slab 中尚未切出的部分 [cursor, limit). */
+    char *cursor, *limit;
+    /* 全部 slab. */
+    NodeSlab *slabs;
+    /* 下一块 slab 容纳的结点数. */
+    size_t slabNodes;
+} NodePool;
+
+/**
+ * @brief 创建结点池, 引用计数为 1.
+ * @param nodeSize 结点字节数.
+ * @return 结点池.
+ */
+NodePool *CreateNodePool(size_t nodeSize);
+
+/**
+ * @brief 增加结点池的引用计数.
+ * @param P 结点池.
+ */
+void RetainNodePool(NodePool *P);
+
+/**
+ * @brief 减少结点池的引用计数, 归零时释放池中全部 slab. 时间复杂度与 slab
+ * 块数成正比, 而块数随结点数对数增长.
+ * @param P 结点池.
+ */
+void ReleaseNodePool(NodePool *P);
+
+/**
+ * @brief 从结点池分配一个结点, 优先复用空闲结点. 均摊 O(1).
+ * @param P 结点池.
+ * @return 未初始化的结点.
+ */
+void *NodePoolAlloc(NodePool *P);
+
+/**
+ * @brief 从结点池一次分配 count 个内存上连续的结点, 用于批量建表. 当前 slab
+ * 剩余的空间足够时从中切出, 否则为它们单独分配一块恰好大小的 slab, 当前
+ * slab 不受影响. 结点大小按指针对齐后与结点结构体大小相同, 返回值可以直接
+ * 当作结构体数组使用, 各结点也可以逐个归还.
+ * @param P 结点池.
+ * @param count 结点个数, 大于 0.
+ * @return 未初始化的第一个结点.
+ */
+void *NodePoolAllocArray(NodePool *P, size_t count);
+
+/**
+ * @brief 把结点归还给结点池.
+ * @param P 结点池, 与分配该结点的池相同或已与之合并.
+ * @param node 结点.
+ */
+void NodePoolFree(NodePool *P, void *node);
+
+/**
+ * @brief 返回结点池向系统申请的字节数, 包括 slab 块头, 空闲结点和当前 slab
+ * 中尚未切出的部分, 用于估计链表每个元素实际占用的内存. 时间复杂度与 slab
+ * 块数成正比.
+ * @param P 结点池.
+ * @return 字节数.
+ */
+size_t NodePoolBytes(NodePool *P);
+
+/**
+ * @brief 合并两个结点池, 此后从任一个池分配的结点可以归还给另一个.
+ * @param A 结点池.
+ * @param B 结点池, 结点大小与 A 相同.
+ */
+void MergeNodePool(NodePool *A, NodePool *B);
+
+/**
+ * @brief 分配一个链表头结点, 并为它创建新的结点池. 头结点之前隐藏保存着
+ * 结点池的指针, 所以链表类型不变, 也不必在每个结点中保存池的指针.
+ * @param nodeSize 结点字节数.
+ * @return 未初始化的头结点.
+ */
+void *NewListHead(size_t nodeSize);
+
+/**
+ * @brief 分配一个与 head 所在链表共用结点池的头结点, 用于从一个链表中拆出
+ * 另一个链表.
+ * @param head 已存在链表的头结点.
+ * @return 未初始化的头结点.
+ */
+void *ShareListHead(const void *head);
+
+/**
+ * @brief 返回链表的结点池.
+ * @param head 由 NewListHead() 或 ShareListHead() 分配的头结点.
+ * @return 结点池.
+ */
+NodePool *ListHeadPool(const void *head);
+
+/**
+ * @brief 释放头结点, 并释放其对结点池的引用. 最后一个引用释放时, 链表中剩余
+ * 的结点随 slab 一并释放, 无需逐个 free().
+ * @param head 头结点.
+ */
+void FreeListHead(void *head);
+
+#endif /* NODEPOOL_H */
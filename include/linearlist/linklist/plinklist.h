@@ -0,0 +1,164 @@
+﻿/**
+ * @file plinklist.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 持久化单向链表头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef PLINKLIST_H
+#define PLINKLIST_H
+
+#include <stdatomic.h>
+
+#include <status.h>
+
+typedef int ElemType;
+
+/**
+ * 持久化链表结点. ref 为指向该结点的引用个数, 包括各版本的表头和前驱结点的
+ * next. ref 大于 1 的结点被多个版本共享, 此后不再修改; 只被一个版本引用的
+ * 结点可以原地修改.
+ */
+typedef struct PNode
+{
+    ElemType data;
+    atomic_int ref;
+    struct PNode *next;
+} PNode;
+
+/**
+ * 持久化单向链表的一个版本. 各版本共享公共的后缀, 快照只增加第一个结点的
+ * 引用计数, O(1). 修改某个版本时, 从表头到修改位置之间被共享的结点先复制
+ * 一份 (路径复制), 没有被共享的结点直接原地修改, 所以没有快照时与普通单向
+ * 链表一样快.
+ *
+ * 共享结点不会被修改, 引用计数是原子的, 因此不同线程可以各自持有并读写
+ * 不同的版本, 不需要加锁. 同一个版本 (PList 变量本身) 不能被多个线程同时
+ * 修改.
+ */
+typedef struct PList
+{
+    PNode *head;
+    int length;
+} PList;
+
+/**
+ * @brief 构造一个空的持久化链表 L.
+ * @param L 指向未初始化过的持久化链表的指针.
+ */
+Status InitList_P(PList *L);
+
+/**
+ * @brief 由数组 a 的 n 个元素依次建立持久化链表 L.
+ * @param L 指向未初始化过的持久化链表的指针.
+ * @param a 数组.
+ * @param n 元素个数.
+ * @return OK 建立成功返回 OK.
+ * @return ERROR n < 0 时返回 ERROR.
+ */
+Status CreateList_P(PList *L, const ElemType *a, int n);
+
+/**
+ * @brief 为 L 的当前版本建立快照 S, O(1). 之后修改 L 或 S 互不影响.
+ *
+ * 线程: 建立快照与修改 L 不能同时进行. 修改 L 时, 表头和引用计数为 1 的
+ * 结点都是原地改写的, 另一个线程同时读 L 的表头并增加引用计数是数据竞争,
+ * 快照可能看到修改到一半的表, 也可能在 L 判定结点未被共享之后才共享它.
+ * 原子的引用计数只保证各线程分别持有不同版本时互不干扰. 所以快照应由修改
+ * L 的线程建立, 或与修改 L 的操作用同一把锁互斥; 没有线程修改 L 时, 多个
+ * 线程可以同时为 L 建立快照. 建立后 S 可以交给其他线程使用.
+ * @param L 已存在的持久化链表.
+ * @param S 指向未初始化过的持久化链表的指针.
+ */
+Status Snapshot_P(const PList *L, PList *S);
+
+/**
+ * @brief 销毁版本 L. 只释放不再被其他版本引用的结点.
+ * @param L 指向已存在持久化链表的指针.
+ */
+Status DestroyList_P(PList *L);
+
+/**
+ * @brief 头插法, O(1), 新结点的后继与其他版本共享.
+ * @param L 已存在的持久化链表.
+ * @param e 要插入的数据元素.
+ */
+Status HeadInsert_P(PList *L, ElemType e);
+
+/**
+ * @brief 尾插法, O(n).
+ * @param L 已存在的持久化链表.
+ * @param e 要插入的数据元素.
+ */
+Status TailInsert_P(PList *L, ElemType e);
+
+/**
+ * @brief 用 e 返回 L 中第 i 个数据元素.
+ * @param L 持久化链表.
+ * @param i 序号, 取值范围 1 <= i <= length.
+ * @param e 存放获得的数据元素.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR i 不合法返回 ERROR.
+ */
+Status GetElem_P(const PList *L, int i, ElemType *e);
+
+/**
+ * @brief 把 L 中第 i 个数据元素改为 e, 前 i 个结点中被共享的先复制.
+ * @param L 已存在的持久化链表.
+ * @param i 序号, 取值范围 1 <= i <= length.
+ * @param e 新的值.
+ */
+Status SetElem_P(PList *L, int i, ElemType e);
+
+/**
+ * @brief 按值查找.
+ * @param L 持久化链表.
+ * @param e 要查找的值.
+ * @return 返回第一个值为 e 的元素的位序, 不存在时返回 0.
+ */
+int LocateElem_P(const PList *L, ElemType e);
+
+/**
+ * @brief 在 L 第 i 个元素之前插入数据元素 e, 前 i - 1 个结点中被共享的先复制.
+ * @param L 已存在的持久化链表.
+ * @param i 插入的位置. 取值范围 1 <= i <= length+1.
+ * @param e 要插入的元素.
+ */
+Status ListInsert_P(PList *L, int i, ElemType e);
+
+/**
+ * @brief 删除 L 中第 i 个元素, 并用 e 返回其值. 前 i - 1 个结点中被共享的
+ * 先复制, 第 i 个结点仍被其他版本引用时保留.
+ * @param L 已存在的持久化链表.
+ * @param i 删除的位置. 取值范围 1 <= i <= length.
+ * @param e 存放删除的元素, 可以为 NULL.
+ */
+Status ListDelete_P(PList *L, int i, ElemType *e);
+
+/**
+ * @brief 把 L 的元素依次复制到数组 a.
+ * @param L 持久化链表.
+ * @param a 数组.
+ * @param max 最多复制的元素个数.
+ * @return 复制的元素个数.
+ */
+int ListToArray_P(const PList *L, ElemType *a, int max);
+
+/**
+ * @brief 返回 L 中数据元素个数, O(1).
+ * @param L 持久化链表.
+ * @return L 的数据元素个数.
+ */
+int ListLength_P(const PList *L);
+
+/**
+ * @brief 打印持久化链表.
+ * @param L 待打印持久化链表.
+ */
+void PrintList_P(const PList *L);
+
+#endif /* PLINKLIST_H */
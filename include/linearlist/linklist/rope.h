@@ -0,0 +1,166 @@
+﻿/**
+ * @file rope.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 按位序平衡的分块序列 (绳) 头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef ROPE_H
+#define ROPE_H
+
+#include <linearlist/linklist/nodepool.h>
+#include <status.h>
+
+typedef int ElemType;
+
+/* 每个结点存放的元素个数, 使结点恰好占 256 字节, 即四个缓存行. */
+#define RNODE_CAPACITY \
+    ((256 - 2 * sizeof(void *) - 3 * sizeof(int)) / sizeof(ElemType))
+
+/**
+ * 绳的结点. 每个结点存放一小段连续的元素, 同时是树堆 (treap) 中的一个结点:
+ * 中序遍历各结点的元素段依次相接就是整个序列, 优先级满足堆序, 使树高期望
+ * 为 O(log(n / RNODE_CAPACITY)). 结点不存关键字, 按子树元素个数定位, 即
+ * 隐式键树堆.
+ */
+typedef struct RNode
+{
+    struct RNode *left, *right;
+    /* 随机优先级, 父结点不小于子结点. */
+    unsigned int priority;
+    /* 本结点的元素个数, 1 <= count <= RNODE_CAPACITY. */
+    int count;
+    /* 子树中的元素总数. */
+    int size;
+    ElemType elem[RNODE_CAPACITY];
+} RNode;
+
+/**
+ * 绳. 按位序查找, 插入, 删除, 在任意位序处拆分以及两条绳的拼接都是期望
+ * O(logn). 元素在结点中连续存放, 插入删除只在一个结点内移动元素; 结点满时
+ * 对半分裂; 不足四分之一满时与相邻结点合并, 合计放不下就平分两者的元素.
+ * 拆分和拼接后也这样处理断开处的结点, 所以绳多于一个结点时每个结点至少
+ * 四分之一满.
+ */
+typedef struct Rope
+{
+    RNode *root;
+    /* 结点池. 拆分出的绳与原绳共用, 拼接时两个池合并. */
+    NodePool *pool;
+    /* 优先级的随机数状态. */
+    unsigned long long seed;
+} Rope;
+
+/**
+ * @brief 构造一条空绳 R.
+ * @param R 指向未初始化过的绳的指针.
+ */
+Status InitList_R(Rope *R);
+
+/**
+ * @brief 由数组 a 的 n 个元素建立绳 R, 结点装满到四分之三, O(n).
+ * @param R 指向未初始化过的绳的指针.
+ * @param a 数组.
+ * @param n 元素个数.
+ * @return OK 建立成功返回 OK.
+ * @return ERROR n < 0 时返回 ERROR.
+ */
+Status CreateList_R(Rope *R, const ElemType *a, int n);
+
+/**
+ * @brief 销毁绳 R, 结点随结点池一并释放.
+ * @param R 指向已存在绳的指针.
+ */
+Status DestroyList_R(Rope *R);
+
+/**
+ * @brief 头插法, 期望 O(logn).
+ * @param R 已存在的绳.
+ * @param e 要插入的数据元素.
+ */
+Status HeadInsert_R(Rope *R, ElemType e);
+
+/**
+ * @brief 尾插法, 期望 O(logn).
+ * @param R 已存在的绳.
+ * @param e 要插入的数据元素.
+ */
+Status TailInsert_R(Rope *R, ElemType e);
+
+/**
+ * @brief 用 e 返回 R 中第 i 个数据元素, 期望 O(logn).
+ * @param R 绳.
+ * @param i 序号, 取值范围 1 <= i <= length.
+ * @param e 存放获得的数据元素.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR i 不合法返回 ERROR.
+ */
+Status GetElem_R(const Rope *R, int i, ElemType *e);
+
+/**
+ * @brief 按值查找, 按序逐个结点比较, O(n).
+ * @param R 绳.
+ * @param e 要查找的值.
+ * @return 返回第一个值为 e 的元素的位序, 不存在时返回 0.
+ */
+int LocateElem_R(const Rope *R, ElemType e);
+
+/**
+ * @brief 在绳 R 第 i 个元素之前插入数据元素 e, 期望 O(logn).
+ * @param R 已存在的绳.
+ * @param i 插入的位置. 取值范围 1 <= i <= length+1.
+ * @param e 要插入的元素.
+ */
+Status ListInsert_R(Rope *R, int i, ElemType e);
+
+/**
+ * @brief 删除绳 R 中第 i 个元素, 并用 e 返回其值, 期望 O(logn).
+ * @param R 已存在的绳.
+ * @param i 删除的位置. 取值范围 1 <= i <= length.
+ * @param e 存放删除的元素, 可以为 NULL.
+ */
+Status ListDelete_R(Rope *R, int i, ElemType *e);
+
+/**
+ * @brief 把绳 R 第 i 个元素之后的部分拆到新绳 T 中, R 保留前 i 个元素,
+ * 期望 O(logn). T 与 R 共用结点池.
+ * @param R 已存在的绳.
+ * @param i 拆分的位置. 取值范围 0 <= i <= length.
+ * @param T 指向未初始化过的绳的指针.
+ */
+Status Split_R(Rope *R, int i, Rope *T);
+
+/**
+ * @brief 把绳 T 接到绳 R 之后, 期望 O(logn). T 变为空绳, 仍需销毁.
+ * @param R 已存在的绳.
+ * @param T 已存在的绳, 不同于 R.
+ */
+Status Concat_R(Rope *R, Rope *T);
+
+/**
+ * @brief 把绳 R 的元素依次复制到数组 a.
+ * @param R 绳.
+ * @param a 数组.
+ * @param max 最多复制的元素个数.
+ * @return 复制的元素个数.
+ */
+int ListToArray_R(const Rope *R, ElemType *a, int max);
+
+/**
+ * @brief 返回绳 R 中数据元素个数, O(1).
+ * @param R 绳.
+ * @return R 的数据元素个数.
+ */
+int ListLength_R(const Rope *R);
+
+/**
+ * @brief 打印绳.
+ * @param R 待打印的绳.
+ */
+void PrintList_R(const Rope *R);
+
+#endif /* ROPE_H */
@@ -0,0 +1,148 @@
+﻿/**
+ * @file skiplist.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 跳表头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <linearlist/linklist/nodepool.h>
+#include <status.h>
+
+typedef int ElemType;
+
+/* 跳表的最大层数. 每层结点数约为下一层的 1/4, 32 层足够 2^64 个元素. */
+#define SKIPLIST_MAX_LEVEL 32
+
+/**
+ * 跳表结点. 各层的后继指针数组直接放在结点末尾, 与数据在同一次分配中,
+ * 查找时不必再经过一次间接访问.
+ */
+typedef struct SKNode
+{
+    ElemType data;
+    /* 结点层数, 1 <= level <= SKIPLIST_MAX_LEVEL. */
+    int level;
+    /* next[i] 为第 i 层的后继, 0 <= i < level. */
+    struct SKNode *next[];
+} SKNode;
+
+/**
+ * 跳表. 元素按非递减顺序排列, 允许重复. 第 0 层是包含全部元素的有序单向链表,
+ * 上面每层是下一层的稀疏索引, 查找, 插入和删除的期望时间为 O(logn).
+ * 同一层数的结点大小相同, 各层数的结点分别从各自的结点池中分配.
+ */
+typedef struct SkipList
+{
+    /* 头结点, 拥有全部 SKIPLIST_MAX_LEVEL 层. */
+    SKNode *head;
+    /* 当前最高层数. */
+    int level;
+    /* 元素个数. */
+    int length;
+    /* pool[i] 分配 i + 1 层的结点, 用到时才创建. */
+    NodePool *pool[SKIPLIST_MAX_LEVEL];
+} SkipList;
+
+/* 范围扫描游标, 依次给出 (min, max) 内的元素. */
+typedef struct SKCursor
+{
+    /* 下一个要给出的结点. */
+    SKNode *node;
+    /* 扫描上界, 不含. */
+    ElemType max;
+} SKCursor;
+
+/**
+ * @brief 构造一个空的跳表 S.
+ * @param S 指向未初始化过的跳表的指针.
+ */
+Status InitList_SK(SkipList *S);
+
+/**
+ * @brief 销毁跳表 S, 结点随结点池一并释放.
+ * @param S 指向已存在跳表的指针.
+ */
+Status DestroyList_SK(SkipList *S);
+
+/**
+ * @brief 插入元素 e, 排在相等的元素之后. 新结点的层数由线程局部的 xorshift
+ * 随机数决定, 每层以 1/4 的概率继续上升.
+ * @param S 指向已存在跳表的指针.
+ * @param e 要插入的元素.
+ */
+Status Insert_SK(SkipList *S, ElemType e);
+
+/**
+ * @brief 删除一个值为 e 的元素.
+ * @param S 指向已存在跳表的指针.
+ * @param e 要删除的元素.
+ * @return OK 删除成功返回 OK.
+ * @return ERROR 不存在值为 e 的元素时返回 ERROR.
+ */
+Status Delete_SK(SkipList *S, ElemType e);
+
+/**
+ * @brief 按值查找.
+ * @param S 跳表.
+ * @param e 要查找的值.
+ * @return 返回第一个值为 e 的结点, 不存在时返回 NULL.
+ */
+SKNode *LocateElem_SK(const SkipList *S, ElemType e);
+
+/**
+ * @brief 返回第一个值不小于 e 的结点, 不存在时返回 NULL.
+ * @param S 跳表.
+ * @param e 要查找的值.
+ */
+SKNode *LowerBound_SK(const SkipList *S, ElemType e);
+
+/**
+ * @brief 删除所有值在 (min, max) 之间的元素, 与 RangeDelete() 相同不含两端.
+ * 先 O(logn) 找到区间起点在各层的前驱, 再逐层把前驱直接接到区间之后, 时间
+ * 复杂度 O(logn + k), k 为删除的元素个数.
+ * @param S 指向已存在跳表的指针.
+ * @param min 下界.
+ * @param max 上界.
+ * @return 删除的元素个数.
+ */
+int RangeDelete_SK(SkipList *S, ElemType min, ElemType max);
+
+/**
+ * @brief 打开一个范围扫描游标, 依次给出值在 (min, max) 之间的元素. 扫描期间
+ * 不能修改跳表.
+ * @param S 跳表.
+ * @param min 下界, 不含.
+ * @param max 上界, 不含.
+ * @return 游标.
+ */
+SKCursor RangeScan_SK(const SkipList *S, ElemType min, ElemType max);
+
+/**
+ * @brief 从游标取下一个元素.
+ * @param C 指向游标的指针.
+ * @param e 用以返回元素.
+ * @return TRUE 取得元素返回 TRUE.
+ * @return FALSE 扫描结束返回 FALSE.
+ */
+Status CursorNext_SK(SKCursor *C, ElemType *e);
+
+/**
+ * @brief 返回跳表中元素个数, O(1).
+ * @param S 跳表.
+ */
+int ListLength_SK(const SkipList *S);
+
+/**
+ * @brief 按顺序打印跳表第 0 层.
+ * @param S 跳表.
+ */
+void PrintList_SK(const SkipList *S);
+
+#endif /* SKIPLIST_H */
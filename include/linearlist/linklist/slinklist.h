@@ -0,0 +1,154 @@
+﻿/**
+ * @file slinklist.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 静态双向链表头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef SLINKLIST_H
+#define SLINKLIST_H
+
+#include <stdint.h>
+
+#include <linearlist/sqlist/listfile.h>
+#include <status.h>
+
+typedef int ElemType;
+
+/* 静态链表的初始容量, 含 0 号头结点. */
+#define SLIST_INIT_SIZE 64
+
+/* 链接用 32 位下标. 0 号单元是头结点, 下标 0 也表示链的终点. */
+typedef uint32_t SIndex;
+
+/* 空闲结点的 prior 置为此值, 表中结点的 prior 总小于数组容量. */
+#define SLIST_FREE UINT32_MAX
+
+/* 静态链表的结点, 共 12 字节, 不到 DNode 的一半. */
+typedef struct SNode
+{
+    ElemType data;
+    SIndex next, prior;
+} SNode;
+
+/**
+ * 静态双向链表. 全部结点存放在一个数组中, 以下标代替指针. 0 号头结点的
+ * next 指向第一个结点, prior 指向最后一个结点, 链在两端都回到 0, 所以头插和
+ * 尾插都是 O(1). 删除的结点以 next 链成空闲链, 插入时优先复用; 数组用满时
+ * 以 realloc() 加倍. 整个表只占一块连续内存.
+ */
+typedef struct SLinklist
+{
+    SNode *node;
+    /* 元素个数. */
+    int length;
+    /* 数组容量, 含头结点. */
+    SIndex listsize;
+    /* 从未使用过的第一个下标, [top, listsize) 均空闲. */
+    SIndex top;
+    /* 空闲链的第一个结点, 0 表示空闲链为空. */
+    SIndex free;
+} SLinklist;
+
+/**
+ * @brief 构造一个空的静态链表 L.
+ * @param L 指向未初始化过的静态链表的指针.
+ */
+Status InitList_S(SLinklist *L);
+
+/**
+ * @brief 销毁静态链表 L.
+ * @param L 指向已存在静态链表的指针.
+ */
+Status DestroyList_S(SLinklist *L);
+
+/**
+ * @brief 头插法.
+ * @param L 指向已存在静态链表的指针.
+ * @param e 要插入的数据元素.
+ */
+Status HeadInsert_S(SLinklist *L, ElemType e);
+
+/**
+ * @brief 尾插法, O(1).
+ * @param L 指向已存在静态链表的指针.
+ * @param e 要插入的数据元素.
+ */
+Status TailInsert_S(SLinklist *L, ElemType e);
+
+/**
+ * @brief 按序号查找结点, 从离 i 较近的一端开始走.
+ * @param L 静态链表.
+ * @param i 序号. 取值范围 0 <= i <= length, 0 为头结点.
+ * @return 返回结点下标, 序号不合法时返回 -1.
+ */
+long GetElem_S(SLinklist L, int i);
+
+/**
+ * @brief 按值查找.
+ * @param L 静态链表.
+ * @param e 要查找的值.
+ * @return 返回第一个值为 e 的结点的下标, 不存在时返回 0.
+ */
+SIndex LocateElem_S(SLinklist L, ElemType e);
+
+/**
+ * @brief 在静态链表 L 第 i 个元素之前插入数据元素 e.
+ * @param L 指向已存在静态链表的指针.
+ * @param i 插入的位置. 取值范围 1 <= i <= length+1.
+ * @param e 要插入的元素.
+ */
+Status ListInsert_S(SLinklist *L, int i, ElemType e);
+
+/**
+ * @brief 删除静态链表 L 中第 i 个元素, 结点挂到空闲链上.
+ * @param L 指向已存在静态链表的指针.
+ * @param i 删除的位置. 取值范围 1 <= i <= length.
+ */
+Status ListDelete_S(SLinklist *L, int i);
+
+/**
+ * @brief 删除下标为 k 的结点, O(1). k 不在表中 (如已被删除) 时返回 ERROR,
+ * 表和空闲链都不变.
+ * @param L 指向已存在静态链表的指针.
+ * @param k 结点下标, 由 GetElem_S() 或 LocateElem_S() 得到.
+ */
+Status NodeDelete_S(SLinklist *L, SIndex k);
+
+/**
+ * @brief 返回静态链表 L 中数据元素个数, O(1).
+ * @param L 静态链表.
+ */
+int ListLength_S(SLinklist L);
+
+/**
+ * @brief 打印静态链表.
+ * @param L 待打印静态链表.
+ */
+void PrintList_S(SLinklist L);
+
+/**
+ * @brief 将静态链表写入文件, 格式见 listfile.h, 与其他线性表的文件通用.
+ * 只沿链写出元素, 下标和空闲链不保存.
+ * @param L 静态链表.
+ * @param fp 以二进制写方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status SaveList_S(SLinklist L, FILE *fp);
+
+/**
+ * @brief 读入线性表文件, 格式见 listfile.h. 元素依次存放在 1..n 号结点,
+ * 空闲链为空, 所以保存前取得的下标读回后不再有效.
+ * @param L 指向未初始化过的静态链表的指针.
+ * @param fp 以二进制读方式打开的文件.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 读取失败或数据损坏返回 ERROR.
+ */
+Status LoadList_S(SLinklist *L, FILE *fp);
+
+#endif /* SLINKLIST_H */
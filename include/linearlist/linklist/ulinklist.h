@@ -0,0 +1,122 @@
+﻿/**
+ * @file ulinklist.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 单向展开链表头文件.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef ULINKLIST_H
+#define ULINKLIST_H
+
+#include <linearlist/linklist/nodepool.h>
+#include <status.h>
+
+typedef int ElemType;
+
+/* 每个结点存放的元素个数, 使结点恰好占 128 字节, 即两个缓存行. */
+#define UNODE_CAPACITY ((128 - sizeof(void *) - sizeof(int)) / sizeof(ElemType))
+
+/* 展开链表的结点: 一个小数组存放连续的若干元素. */
+typedef struct UNode
+{
+    struct UNode *next;
+    /* 结点中的元素个数, 1 <= count <= UNODE_CAPACITY. */
+    int count;
+    ElemType elem[UNODE_CAPACITY];
+} UNode;
+
+/**
+ * 展开链表. 每个结点存放至多 UNODE_CAPACITY 个元素, 结点满时对半分裂, 删除后
+ * 不足半满时与后继合并. 与每个元素一个结点的 Linklist 相比, 指针和分配开销
+ * 分摊到一组元素上, 按位序定位时每个结点只跳一次, 结点内顺序访问.
+ */
+typedef struct UList
+{
+    /* 第一个和最后一个结点, 空表时为 NULL. */
+    UNode *first, *last;
+    /* 元素个数. */
+    int length;
+    /* 结点个数. */
+    int nodes;
+    /* 结点池. */
+    NodePool *pool;
+} UList, *ULinklist;
+
+/**
+ * @brief 构造一个空的展开链表 L.
+ * @param L 指向未初始化过的展开链表的指针.
+ */
+Status InitList_U(ULinklist *L);
+
+/**
+ * @brief 销毁展开链表 L, 结点随结点池一并释放.
+ * @param L 指向已存在展开链表的指针, 销毁后置为 NULL.
+ */
+Status DestroyList_U(ULinklist *L);
+
+/**
+ * @brief 头插法. 第一个结点满时在它前面新建结点, 所以连续头插时结点都是满的.
+ * @param L 已存在展开链表.
+ * @param e 要插入的数据元素.
+ */
+Status HeadInsert_U(ULinklist L, ElemType e);
+
+/**
+ * @brief 尾插法, O(1). 最后一个结点满时在它后面新建结点.
+ * @param L 已存在展开链表.
+ * @param e 要插入的数据元素.
+ */
+Status TailInsert_U(ULinklist L, ElemType e);
+
+/**
+ * @brief 用 e 返回 L 中第 i 个数据元素. 逐结点累加元素个数定位, 时间复杂度
+ * O(n / UNODE_CAPACITY).
+ * @param L 展开链表.
+ * @param i 序号, 取值范围 1 <= i <= length.
+ * @param e 存放获得的数据元素.
+ */
+Status GetElem_U(ULinklist L, int i, ElemType *e);
+
+/**
+ * @brief 按值查找.
+ * @param L 展开链表.
+ * @param e 要查找的值.
+ * @return 返回第一个值为 e 的元素的位序, 不存在时返回 0.
+ */
+int LocateElem_U(ULinklist L, ElemType e);
+
+/**
+ * @brief 在展开链表 L 第 i 个元素之前插入数据元素 e. 所在结点满时先对半分裂.
+ * @param L 已存在展开链表.
+ * @param i 插入的位置. 取值范围 1 <= i <= length+1.
+ * @param e 要插入的元素.
+ */
+Status ListInsert_U(ULinklist L, int i, ElemType e);
+
+/**
+ * @brief 删除展开链表 L 中第 i 个元素, 并用 e 返回其值. 所在结点不足半满时
+ * 与后继结点合并, 结点变空时摘除.
+ * @param L 已存在展开链表.
+ * @param i 删除的位置. 取值范围 1 <= i <= length.
+ * @param e 存放删除的元素, 可以为 NULL.
+ */
+Status ListDelete_U(ULinklist L, int i, ElemType *e);
+
+/**
+ * @brief 返回展开链表 L 中数据元素个数, O(1).
+ * @param L 展开链表.
+ * @return L 的数据元素个数.
+ */
+int ListLength_U(ULinklist L);
+
+/**
+ * @brief 打印展开链表.
+ * @param L 待打印展开链表.
+ */
+void PrintList_U(ULinklist L);
+
+#endif /* ULINKLIST_H */
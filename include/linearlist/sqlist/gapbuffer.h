@@ -0,0 +1,111 @@
+﻿/**
+ * @file gapbuffer.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 间隙缓冲区.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef GAPBUFFER_H
+#define GAPBUFFER_H
+
+#include <linearlist/sqlist/sqlist.h>
+
+/**
+ * 间隙缓冲区. 元素顺序存放, 但在编辑位置 (光标) 处留出一段空闲的间隙:
+ * elem[0, gapStart) 和 elem[gapEnd, listsize) 依次为表中的元素. 在光标处插入
+ * 只需填入间隙, 删除只需扩大间隙; 光标移动 d 个位置时搬移 d 个元素. 所以在
+ * 同一位置附近连续编辑时, 每次插入删除的均摊时间为 O(1), 而不是 SqList 的
+ * O(n).
+ */
+typedef struct GapBuffer
+{
+    /* 存储空间基址. */
+    ElemType *elem;
+    /* 间隙起点, 即间隙之前的元素个数. */
+    int gapStart;
+    /* 间隙之后第一个元素的下标. */
+    int gapEnd;
+    /* 当前分配的存储容量. */
+    int listsize;
+} GapBuffer;
+
+/**
+ * @brief 构造一个空的间隙缓冲区 G.
+ * @param G 指向未初始化过的间隙缓冲区的指针.
+ * */
+Status InitList_GB(GapBuffer *G);
+
+/**
+ * @brief 销毁间隙缓冲区 G.
+ * @param G 指向已存在的间隙缓冲区的指针.
+ * */
+Status DestroyList_GB(GapBuffer *G);
+
+/**
+ * @brief 返回 G 中数据元素个数.
+ * @param G 已存在的间隙缓冲区.
+ * */
+int ListLength_GB(GapBuffer G);
+
+/**
+ * @brief 用 e 返回 G 中第 i 个数据元素的值.
+ * @param G 已存在的间隙缓冲区.
+ * @param i 位置索引, 取值范围 1 <= i <= length.
+ * @param e 存放获得的数据元素.
+ * */
+Status GetElem_GB(GapBuffer G, int i, ElemType *e);
+
+/**
+ * @brief 在 G 中第 i 个位置以前插入数据元素 e. 先把间隙移到该位置.
+ * @param G 指向已存在的间隙缓冲区的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param e 待插入元素.
+ * */
+Status ListInsert_GB(GapBuffer *G, int i, ElemType e);
+
+/**
+ * @brief 在 G 中第 i 个位置以前依次插入数组 e 中的 n 个元素.
+ * @param G 指向已存在的间隙缓冲区的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param e 待插入元素, 不能位于 G 的存储空间内.
+ * @param n 待插入元素个数.
+ * */
+Status ListInsertRange_GB(GapBuffer *G, int i, const ElemType *e, int n);
+
+/**
+ * @brief 删除 G 的第 i 个数据元素, 并用 e 返回其值.
+ * @param G 指向已存在的间隙缓冲区的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length.
+ * @param e 存放删除数据元素.
+ * */
+Status ListDelete_GB(GapBuffer *G, int i, ElemType *e);
+
+/**
+ * @brief 删除 G 中从第 i 个开始的 n 个数据元素.
+ * @param G 指向已存在的间隙缓冲区的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length.
+ * @param n 删除元素个数, 取值范围 0 <= n <= length - i + 1.
+ * */
+Status ListDeleteRange_GB(GapBuffer *G, int i, int n);
+
+/**
+ * @brief 将 G 中从第 i 个开始的 n 个数据元素依次复制到 dst. 间隙两侧各用一次
+ * memcpy 顺序读出.
+ * @param G 已存在的间隙缓冲区.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param n 元素个数, 取值范围 0 <= n <= length - i + 1.
+ * @param dst 输出数组.
+ * */
+Status ListCopy_GB(GapBuffer G, int i, int n, ElemType *dst);
+
+/**
+ * @brief 按前后顺序输出 G 的所有数据元素.
+ * @param G 已存在的间隙缓冲区.
+ * */
+void PrintList_GB(GapBuffer G);
+
+#endif /* GAPBUFFER_H */
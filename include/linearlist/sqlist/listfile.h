@@ -0,0 +1,184 @@
+﻿/**
+ * @file listfile.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 线性表二进制文件格式头文件.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef LISTFILE_H
+#define LISTFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <status.h>
+
+typedef int ElemType;
+
+/* 文件格式版本号, 格式改变时递增, 读取时拒绝不认识的版本. */
+#define LIST_FILE_VERSION 1
+
+/**
+ * 线性表文件. 各种线性表都存成同一种格式: 元素序列, 与链接方式无关, 所以
+ * 单向链表存的文件也可以作为顺序表映射. 整数按本机字节序存储, 由 byteOrder
+ * 字段识别.
+ *
+ *   文件头 64 字节, 见 ListFileHeader. 元素紧随其后, 映射后按缓存行对齐.
+ *   count 个元素, 每个 elemSize 字节.
+ *   8 字节校验和, 见 UpdateChecksum(). 放在末尾, 写链表时可以边遍历边计算.
+ */
+typedef struct ListFileHeader
+{
+    /* "LSTF". */
+    char magic[4];
+    uint16_t version;
+    /* 文件头字节数, 即元素的起始偏移. */
+    uint16_t headerSize;
+    /* sizeof(ElemType). */
+    uint32_t elemSize;
+    /* 写入 0x01020304, 读出的值不同说明字节序不同. */
+    uint32_t byteOrder;
+    /* 元素个数. */
+    uint64_t count;
+    /* 以上字段的校验和. */
+    uint64_t headerChecksum;
+    uint8_t reserved[32];
+} ListFileHeader;
+
+/* 流式校验和的状态. */
+typedef struct ListChecksum
+{
+    /* 四路独立累加, 每路每次吸收 8 字节. */
+    uint64_t acc[4];
+    /* 已吸收的元素个数. */
+    uint64_t count;
+    /* 尚未凑满 32 字节的元素. */
+    uint32_t pending[8];
+    int pendingCount;
+} ListChecksum;
+
+/* 映射到内存的线性表文件. */
+typedef struct ListFileMap
+{
+    /* 映射的起始地址和字节数. */
+    void *base;
+    size_t size;
+    /* 元素, 位于 base 之后 headerSize 字节处. */
+    ElemType *elem;
+    size_t count;
+} ListFileMap;
+
+/**
+ * @brief 初始化校验和.
+ * @param C 校验和状态.
+ */
+void InitChecksum(ListChecksum *C);
+
+/**
+ * @brief 吸收 n 个元素. 每 32 字节四路各做一次乘法和循环移位, 四路互不依赖,
+ * 速度接近内存带宽. 分多次吸收与一次吸收的结果相同.
+ * @param C 校验和状态.
+ * @param e 元素.
+ * @param n 元素个数.
+ */
+void UpdateChecksum(ListChecksum *C, const ElemType *e, size_t n);
+
+/**
+ * @brief 返回校验和, 状态不变.
+ * @param C 校验和状态.
+ * @return 64 位校验和.
+ */
+uint64_t FinishChecksum(const ListChecksum *C);
+
+/**
+ * @brief 写出文件头.
+ * @param fp 以二进制写方式打开的文件.
+ * @param count 元素个数.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status WriteListHeader(FILE *fp, size_t count);
+
+/**
+ * @brief 写出数组 e 的 n 个元素和校验和, 元素只用一次 fwrite.
+ * @param fp 以二进制写方式打开的文件, 已写出文件头.
+ * @param e 元素.
+ * @param n 元素个数, 与文件头中的相同.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status WriteListArray(FILE *fp, const ElemType *e, size_t n);
+
+/**
+ * @brief 沿链写出从 first 到 end 之前的各结点的数据域和校验和. 数据先攒到
+ * 缓冲区中, 成批计算校验和并写出.
+ * @param fp 以二进制写方式打开的文件, 已写出文件头.
+ * @param first 第一个结点, 数据域在偏移 0 处.
+ * @param end 段尾之后的结点, 可以为 NULL.
+ * @param nextOffset 后继指针在结点中的偏移.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status WriteListChain(FILE *fp, const void *first, const void *end,
+                      size_t nextOffset);
+
+/**
+ * @brief 与 WriteListChain() 相同, 但结点存放在数组中, 以 32 位下标链接,
+ * 下标 0 为链的终点, 用于静态链表.
+ * @param fp 以二进制写方式打开的文件, 已写出文件头.
+ * @param base 结点数组, 数据域在结点偏移 0 处.
+ * @param stride 结点大小.
+ * @param first 第一个结点的下标, 为 0 时不写出元素.
+ * @param nextOffset 后继下标在结点中的偏移.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 写入失败返回 ERROR.
+ */
+Status WriteListSlots(FILE *fp, const void *base, size_t stride,
+                      uint32_t first, size_t nextOffset);
+
+/**
+ * @brief 读入并检查文件头.
+ * @param fp 以二进制读方式打开的文件.
+ * @param count 用以返回元素个数.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 读取失败, 不是本格式, 版本, 元素大小或字节序不符返回 ERROR.
+ */
+Status ReadListHeader(FILE *fp, size_t *count);
+
+/**
+ * @brief 读入 count 个元素和校验和, 第 k 个元素存到 dst + k * stride 处,
+ * 所以可以直接读进连续分配的链表结点的数据域. stride 为 sizeof(ElemType)
+ * 时一次 fread 读进数组.
+ * @param fp 以二进制读方式打开的文件, 已读入文件头.
+ * @param dst 目标地址, count 为 0 时可以为 NULL.
+ * @param count 元素个数, 与文件头中的相同.
+ * @param stride 相邻元素的目标地址之差.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 读取失败或校验和不符返回 ERROR.
+ */
+Status ReadListData(FILE *fp, void *dst, size_t count, size_t stride);
+
+/**
+ * @brief 把线性表文件映射到内存, 元素不经复制直接使用. 映射是写时复制的
+ * 私有映射, 修改元素不会写回文件. 不支持 mmap 的平台上退回到整个读入内存.
+ * @param path 文件路径.
+ * @param verify 为 TRUE 时检查元素的校验和, 需要读一遍全部元素; 为 FALSE
+ * 时只检查文件头和文件大小, 元素按需从页缓存中调入.
+ * @param M 用以返回映射.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 打开或映射失败, 格式不符或校验和不符返回 ERROR.
+ */
+Status MapListFile(const char *path, Status verify, ListFileMap *M);
+
+/**
+ * @brief 解除 MapListFile() 建立的映射.
+ * @param M 映射.
+ */
+void UnmapListFile(ListFileMap *M);
+
+#endif /* LISTFILE_H */
@@ -0,0 +1,133 @@
+﻿/**
+ * @file piecetable.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 片段表.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef PIECETABLE_H
+#define PIECETABLE_H
+
+#include <linearlist/sqlist/sqlist.h>
+
+/* 片段所在的缓冲区. */
+#define PIECE_ORIGINAL 0 // 只读的原始缓冲区.
+#define PIECE_ADD 1      // 只追加的新增缓冲区.
+
+/* 片段: 某个缓冲区中从 start 开始的 length 个连续元素. */
+typedef struct Piece
+{
+    int buffer;
+    int start;
+    int length;
+} Piece;
+
+/**
+ * 片段表. 原始元素存放在只读的原始缓冲区, 插入的元素一律追加到新增缓冲区的
+ * 末尾, 表本身是一串片段, 依次拼接即为表中的元素. 插入和删除只需拆分或修改
+ * 片段, 不搬移任何元素. 在上次插入的位置之后继续插入时, 新元素在新增缓冲区中
+ * 与上一片段相连, 直接延长该片段即可. 另外缓存最近访问的片段及其起始位置,
+ * 光标附近的定位不必从头扫描.
+ */
+typedef struct PieceTable
+{
+    /* 原始缓冲区. */
+    ElemType *original;
+    /* 新增缓冲区, 已用 addLength 个, 容量 addSize. */
+    ElemType *add;
+    int addLength;
+    int addSize;
+    /* 片段数组, 已用 pieceCount 个, 容量 pieceSize. 不含空片段. */
+    Piece *piece;
+    int pieceCount;
+    int pieceSize;
+    /* 表中元素个数. */
+    int length;
+    /* 缓存: 第 cursorPiece 个片段的第一个元素之前有 cursorPos 个元素. */
+    int cursorPiece;
+    int cursorPos;
+} PieceTable;
+
+/**
+ * @brief 以数组 e 中的 n 个元素为原始内容构造片段表 P.
+ * @param P 指向未初始化过的片段表的指针.
+ * @param e 原始元素, 可以为 NULL (n 为 0 时).
+ * @param n 原始元素个数.
+ * */
+Status InitList_PT(PieceTable *P, const ElemType *e, int n);
+
+/**
+ * @brief 销毁片段表 P.
+ * @param P 指向已存在的片段表的指针.
+ * */
+Status DestroyList_PT(PieceTable *P);
+
+/**
+ * @brief 返回 P 中数据元素个数.
+ * @param P 已存在的片段表.
+ * */
+int ListLength_PT(PieceTable P);
+
+/**
+ * @brief 用 e 返回 P 中第 i 个数据元素的值. 会更新 P 的片段缓存, 所以按顺序
+ * 逐个读取时每次为 O(1).
+ * @param P 指向已存在的片段表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length.
+ * @param e 存放获得的数据元素.
+ * */
+Status GetElem_PT(PieceTable *P, int i, ElemType *e);
+
+/**
+ * @brief 在 P 中第 i 个位置以前插入数据元素 e.
+ * @param P 指向已存在的片段表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param e 待插入元素.
+ * */
+Status ListInsert_PT(PieceTable *P, int i, ElemType e);
+
+/**
+ * @brief 在 P 中第 i 个位置以前依次插入数组 e 中的 n 个元素.
+ * @param P 指向已存在的片段表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param e 待插入元素.
+ * @param n 待插入元素个数.
+ * */
+Status ListInsertRange_PT(PieceTable *P, int i, const ElemType *e, int n);
+
+/**
+ * @brief 删除 P 的第 i 个数据元素, 并用 e 返回其值.
+ * @param P 指向已存在的片段表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length.
+ * @param e 存放删除数据元素.
+ * */
+Status ListDelete_PT(PieceTable *P, int i, ElemType *e);
+
+/**
+ * @brief 删除 P 中从第 i 个开始的 n 个数据元素.
+ * @param P 指向已存在的片段表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length.
+ * @param n 删除元素个数, 取值范围 0 <= n <= length - i + 1.
+ * */
+Status ListDeleteRange_PT(PieceTable *P, int i, int n);
+
+/**
+ * @brief 将 P 中从第 i 个开始的 n 个数据元素依次复制到 dst, 每个片段一次
+ * memcpy.
+ * @param P 指向已存在的片段表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param n 元素个数, 取值范围 0 <= n <= length - i + 1.
+ * @param dst 输出数组.
+ * */
+Status ListCopy_PT(PieceTable *P, int i, int n, ElemType *dst);
+
+/**
+ * @brief 按前后顺序输出 P 的所有数据元素.
+ * @param P 已存在的片段表.
+ * */
+void PrintList_PT(PieceTable P);
+
+#endif /* PIECETABLE_H */
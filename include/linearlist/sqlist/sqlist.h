@@ -14,12 +14,12 @@
 
 #include <status.h>
 
+#include <linearlist/sqlist/listfile.h>
+
 /* 顺序表存储空间的初始分配量.*/
 #define LIST_INIT_SIZE 100
-/* 顺序表存储空间的分配增量.*/
+/* 顺序表存储空间的最小分配增量. 空间不足时按倍增扩充, 至少增加这么多.*/
 #define LIST_INCREMENT 10
-/* 顺序表的最大长度.*/
-#define LIST_MAX_SIZE 200
 
 typedef int ElemType;
 
@@ -32,6 +32,9 @@ typedef struct SqList
     int length;
     /* 当前分配的存储容量. */
     int listsize;
+    /* 为 TRUE 时 elem 指向 MapList_Sq() 映射的文件, 不是 malloc() 分配的,
+     * 需要 realloc() 或 free() 的操作返回 ERROR. */
+    Status mapped;
 } SqList;
 
 /**
@@ -61,6 +64,23 @@ int ListLength_Sq(SqList L);
  * */
 int LocateElem_Sq(SqList L, ElemType e, Status (*Compare)(ElemType, ElemType));
 
+/**
+ * @brief 返回 L 中第 1 个值等于 e 的数据元素的位序, 不存在时返回 0. 不经过
+ * 比较函数, 支持 AVX2 时每次比较 32 个元素.
+ * @param L 已存在的顺序表.
+ * @param e 待查找数据元素.
+ * */
+int LocateEqual_Sq(SqList L, ElemType e);
+
+/**
+ * @brief 返回 L 中第 1 个值在 [s, t] 内的数据元素的位序, 不存在或 s > t 时
+ * 返回 0.
+ * @param L 已存在的顺序表.
+ * @param s 区间下界.
+ * @param t 区间上界.
+ * */
+int LocateRange_Sq(SqList L, ElemType s, ElemType t);
+
 /**
  * 用 e 返回 L 中第 i 个数据元素的值.
  * @param L 已存在的顺序表.
@@ -85,6 +105,80 @@ Status ListInsert_Sq(SqList *L, int i, ElemType e);
  * */
 Status ListDelete_Sq(SqList *L, int i, ElemType *e);
 
+/**
+ * @brief 保证 L 的存储容量不小于 n. 容量不足时按倍增扩充, 所以连续插入 n 个
+ * 元素的均摊时间为 O(n).
+ * @param L 指向已存在的顺序表的指针.
+ * @param n 需要的存储容量.
+ * */
+Status ListReserve_Sq(SqList *L, int n);
+
+/**
+ * @brief 将 L 的存储容量缩减为当前长度 (至少为 1), 释放多余空间.
+ * @param L 指向已存在的顺序表的指针.
+ * */
+Status ListShrink_Sq(SqList *L);
+
+/**
+ * @brief 在顺序表 L 中第 i 个位置以前依次插入数组 e 中的 n 个元素. 第 i 个
+ * 元素及以后的元素只用一次 memmove 整体后移.
+ * @param L 指向已存在的顺序表的指针.
+ * @param i 位置索引, 取值范围 1 <= i <= length + 1.
+ * @param e 待插入元素, 不能位于 L 的存储空间内.
+ * @param n 待插入元素个数.
+ * */
+Status ListInsertRange_Sq(SqList *L, int i, const ElemType *e, int n);
+
+/**
+ * @brief 删除 L 中从第 i 个开始的 n 个数据元素, 之后的元素只用一次 memmove
+ * 整体前移.
+ * @param L 指向已存在的顺序表的指针.
+ * @param i 索引位置, 取值范围 1 <= i <= length.
+ * @param n 删除元素个数, 取值范围 0 <= n <= length - i + 1.
+ * */
+Status ListDeleteRange_Sq(SqList *L, int i, int n);
+
+/**
+ * @brief 将数组 e 中的 n 个元素追加到 L 的表尾.
+ * @param L 指向已存在的顺序表的指针.
+ * @param e 待追加元素, 不能位于 L 的存储空间内.
+ * @param n 待追加元素个数.
+ * */
+Status ListAppend_Sq(SqList *L, const ElemType *e, int n);
+
+/**
+ * @brief 把 L 存入文件, 格式见 listfile.h. 元素只用一次 fwrite 写出.
+ * @param L 已存在的顺序表.
+ * @param fp 以二进制写方式打开的文件.
+ * */
+Status SaveList_Sq(SqList L, FILE *fp);
+
+/**
+ * @brief 从文件读入线性表, 替换 L 原有的元素. 任何一种线性表存的文件都可以
+ * 读入. 失败时 L 为空表.
+ * @param L 指向已存在的顺序表的指针.
+ * @param fp 以二进制读方式打开的文件.
+ * */
+Status LoadList_Sq(SqList *L, FILE *fp);
+
+/**
+ * @brief 把线性表文件映射为顺序表 L, 不复制元素, 所以加载时间与表长基本
+ * 无关. 映射得到的 L 可以读写和删除元素, 修改不写回文件, 但存储空间不是
+ * malloc() 分配的, L.mapped 为 TRUE: 需要扩充容量的插入, ListShrink_Sq()
+ * 和 DestoryList_Sq() 都返回 ERROR, 只能用 UnmapList_Sq() 释放. 需要插入时
+ * 先用 ListAppend_Sq() 复制到普通顺序表中.
+ * @param L 未初始化过的顺序表的指针.
+ * @param path 文件路径.
+ * @param verify 为 TRUE 时检查元素的校验和, 见 MapListFile().
+ * */
+Status MapList_Sq(SqList *L, const char *path, Status verify);
+
+/**
+ * @brief 解除 MapList_Sq() 建立的映射. L 不是映射得到的时返回 ERROR.
+ * @param L 指向 MapList_Sq() 得到的顺序表的指针.
+ * */
+Status UnmapList_Sq(SqList *L);
+
 /**
  * 输出操作. 按前后顺序输出顺序表 L 的所有数据元素.
  * @param L 已存在的顺序表.
@@ -150,11 +244,23 @@ Status DeleteSame(SqList *L);
 
 /**
  * 王道数据结构 2.2.4
- * 将两个有序顺序表合并为一个新的有序表, 并由函数返回结果顺序表.
+ * 将两个有序顺序表合并为一个新的有序表, 并由函数返回结果顺序表. C 的存储
+ * 空间按结果长度一次分配到位, 长度不受限制.
  * @param A 待合并有序顺序表.
  * @param B 待合并有序顺序表.
- * @param C 结果有序顺序表.
+ * @param C 结果有序顺序表, 已初始化, 不能与 A 或 B 相同.
  * */
 Status Merge(SqList A, SqList B, SqList *C);
 
+/**
+ * @brief 用 threads 个线程并行合并两个有序顺序表. 输出按长度等分为 threads
+ * 段, 各线程在归并路径的对角线上二分查找本段的起点, 然后独立归并, 彼此之间
+ * 无需同步. 结果与 Merge() 相同, 相等元素中 A 的在前.
+ * @param A 待合并有序顺序表.
+ * @param B 待合并有序顺序表.
+ * @param C 结果有序顺序表, 已初始化, 不能与 A 或 B 相同.
+ * @param threads 线程数, 至少为 1. 每个线程至少分到 65536 个元素.
+ * */
+Status MergeParallel(SqList A, SqList B, SqList *C, int threads);
+
 #endif /* SQLIST_H */
@@ -0,0 +1,217 @@
+﻿/**
+ * @file sqsearch.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 子序列查找.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef SQSEARCH_H
+#define SQSEARCH_H
+
+#include <linearlist/sqlist/sqlist.h>
+
+/**
+ * 在数组中查找连续子序列 (模式). SearchArray() 和 SearchBytes() 在 x86 上
+ * 用 AVX2 同时比较 8 个 (字节为 32 个) 候选位置的首尾元素, 只有首尾都相等
+ * 的位置才逐个比较; 验证的代价超过已扫描长度的两倍时, 从当前位置改用
+ * Two-Way 算法, 所以最坏情况仍是线性的. Two-Way 只需 O(1) 额外空间.
+ * 找全部匹配时用 KMP, 逐个元素推进, 也适合链表这样只能顺序访问的序列.
+ */
+
+/**
+ * @brief 求 KMP 的前缀函数: fail[i] 为 p[0..i] 的最长真前缀, 同时也是其后缀
+ * 的长度.
+ * @param p 模式, m 个元素.
+ * @param fail 输出数组, m 个元素.
+ */
+void PrefixFunction(const ElemType *p, int m, int *fail);
+
+/**
+ * @brief 求 Z 函数: z[i] 为 s 与 s[i..n) 的最长公共前缀长度, z[0] = n.
+ * 对 "模式 + 分隔符 + 文本" 求 Z 函数, 值等于模式长度的位置即匹配.
+ * @param s 序列, n 个元素.
+ * @param z 输出数组, n 个元素.
+ */
+void ZFunction(const ElemType *s, int n, int *z);
+
+/**
+ * @brief 在 t 中从 from 起查找 p 第一次出现的位置.
+ * @param t 文本, n 个元素.
+ * @param p 模式, m 个元素. m 为 0 时返回 from.
+ * @param from 起始下标.
+ * @return 匹配的起始下标, 不存在时返回 -1.
+ */
+int SearchArray(const ElemType *t, int n, const ElemType *p, int m, int from);
+
+/**
+ * @brief 同 SearchArray(), 在字节串中查找.
+ */
+int SearchBytes(const char *t, int n, const char *p, int m, int from);
+
+/**
+ * @brief 找出 p 在 t 中的全部出现位置 (可以重叠), KMP, O(n + m).
+ * @param t 文本, n 个元素.
+ * @param p 模式, m 个元素, m >= 1.
+ * @param pos 用以返回匹配的起始下标, 至多存 max 个, 可以为 NULL.
+ * @param max pos 的容量.
+ * @return 匹配的总次数, 可能大于 max.
+ */
+int SearchAllArray(const ElemType *t, int n, const ElemType *p, int m,
+                   int *pos, int max);
+
+/**
+ * @brief 同 SearchAllArray(), 在字节串中查找.
+ */
+int SearchAllBytes(const char *t, int n, const char *p, int m, int *pos,
+                   int max);
+
+/**
+ * 流式 KMP 匹配器. 文本逐个元素推入, 不需要回退, 适合链表和输入流.
+ */
+typedef struct SeqMatcher
+{
+    /* 模式及其前缀函数. */
+    ElemType *pattern;
+    int *fail;
+    int length;
+    /* 当前已匹配的长度. */
+    int state;
+} SeqMatcher;
+
+/**
+ * @brief 由模式 p 构造匹配器, 复制 p.
+ * @param M 指向未初始化过的匹配器的指针.
+ * @param p 模式, m 个元素.
+ * @param m 模式长度, m >= 1.
+ * @return ERROR 模式为空时返回 ERROR.
+ */
+Status InitMatcher(SeqMatcher *M, const ElemType *p, int m);
+
+/**
+ * @brief 推入一个文本元素.
+ * @param M 匹配器.
+ * @param e 文本元素.
+ * @return TRUE 以 e 结尾的一段文本与模式匹配时返回 TRUE.
+ * @return FALSE 否则返回 FALSE.
+ */
+Status MatcherPush(SeqMatcher *M, ElemType e);
+
+/**
+ * @brief 清除匹配状态, 开始新的文本.
+ * @param M 匹配器.
+ */
+void ResetMatcher(SeqMatcher *M);
+
+/**
+ * @brief 销毁匹配器.
+ * @param M 指向匹配器的指针.
+ */
+Status DestroyMatcher(SeqMatcher *M);
+
+/**
+ * @brief Aho-Corasick 报告匹配的回调.
+ * @param pattern 模式编号.
+ * @param end 匹配的最后一个元素在流中的下标.
+ * @param arg ACFeed() 或 ACPush() 传入的参数.
+ */
+typedef void (*ACMatch)(int pattern, long long end, void *arg);
+
+/* Aho-Corasick 自动机的结点, 即字典树的结点. */
+typedef struct ACNode
+{
+    /* 失败链接: 本结点所代表串的最长真后缀所在的结点. */
+    int fail;
+    /* 沿失败链接第一个有模式结束的结点, 0 表示没有. */
+    int output;
+    /* 在此结束的模式编号, -1 表示没有. 重复的模式只记录先加入的编号. */
+    int pattern;
+    /* 孩子边在边数组中的区间 [edge, edge + edgeCount). */
+    int edge, edgeCount;
+} ACNode;
+
+/* 字典树的边. 构造完成后按 (parent, symbol) 排序, 同一结点的边连续存放. */
+typedef struct ACEdge
+{
+    int parent;
+    ElemType symbol;
+    int child;
+    /* 构造期间同一结点的下一条边. */
+    int sibling;
+} ACEdge;
+
+/**
+ * 多模式匹配的 Aho-Corasick 自动机. 字母表是整个 ElemType, 所以孩子边不用
+ * 稠密数组, 构造完成后排序存放, 转移时二分查找. 文本可以一次给出, 也可以
+ * 逐个元素推入.
+ */
+typedef struct ACAutomaton
+{
+    /* 结点数组, 0 号为根. */
+    ACNode *node;
+    int nodeCount, nodeSize;
+    /* 边数组. */
+    ACEdge *edge;
+    int edgeCount, edgeSize;
+    /* 流的当前状态和已推入的元素个数. */
+    int state;
+    long long position;
+    /* 是否已调用 ACBuild(). */
+    Status built;
+} ACAutomaton;
+
+/**
+ * @brief 构造一个空的自动机.
+ * @param A 指向未初始化过的自动机的指针.
+ */
+Status InitAC(ACAutomaton *A);
+
+/**
+ * @brief 加入一个模式. 必须在 ACBuild() 之前调用.
+ * @param A 自动机.
+ * @param p 模式, m 个元素.
+ * @param m 模式长度, m >= 1.
+ * @param id 模式编号, 匹配时原样报告, id >= 0.
+ * @return ERROR 参数不合法或已构造完成时返回 ERROR.
+ */
+Status ACAddPattern(ACAutomaton *A, const ElemType *p, int m, int id);
+
+/**
+ * @brief 排列孩子边, 按层求失败链接和输出链接.
+ * @param A 自动机.
+ */
+Status ACBuild(ACAutomaton *A);
+
+/**
+ * @brief 向流中推入一个元素, 报告所有在此结束的匹配.
+ * @param A 已构造完成的自动机.
+ * @param e 元素.
+ * @param match 回调.
+ * @param arg 传给回调的参数.
+ * @return 在此结束的匹配个数.
+ */
+int ACPush(ACAutomaton *A, ElemType e, ACMatch match, void *arg);
+
+/**
+ * @brief 向流中推入 n 个元素.
+ * @return 匹配个数.
+ */
+long long ACFeed(ACAutomaton *A, const ElemType *t, int n, ACMatch match,
+                 void *arg);
+
+/**
+ * @brief 清除流状态, 开始新的文本.
+ * @param A 自动机.
+ */
+void ACReset(ACAutomaton *A);
+
+/**
+ * @brief 销毁自动机.
+ * @param A 指向自动机的指针.
+ */
+Status DestroyAC(ACAutomaton *A);
+
+#endif /* SQSEARCH_H */
@@ -0,0 +1,86 @@
+﻿/**
+ * @file sqset.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 有序集合的交, 并, 差.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef SQSET_H
+#define SQSET_H
+
+#include <linearlist/sqlist/sqlist.h>
+
+/* 两个集合大小之比超过此值时改用倍增查找. */
+#define SET_GALLOP_RATIO 32
+
+/**
+ * 以下各函数的输入都是严格递增的整数数组 (集合), 输出同样严格递增, 输出数组
+ * 不能与输入重叠.
+ *
+ * 两个集合大小相近时逐块比较: 交集每次取 a, b 各一块 (AVX2 为 8 个, SSE2 为
+ * 4 个), 把 b 块循环移位后与 a 块逐一比较, 一次得到 a 块中所有在 b 块中出现
+ * 的元素, 然后前进块尾较小的一方. 大小悬殊时对小集合中的每个元素在大集合中
+ * 倍增查找 (galloping): 从上次的位置起以 1, 2, 4, ... 为步长跳到第一个不小于
+ * 它的元素之后, 再在最后一步内二分, 时间复杂度 O(m log(n / m)).
+ */
+
+/**
+ * @brief 求交集 c = a ∩ b.
+ * @param a 集合, m 个元素.
+ * @param b 集合, n 个元素.
+ * @param c 输出数组, 至少 min(m, n) 个元素.
+ * @return 交集的元素个数.
+ */
+int IntersectArray(const ElemType *a, int m, const ElemType *b, int n,
+                   ElemType *c);
+
+/**
+ * @brief 求并集 c = a ∪ b. 大小悬殊时, 大集合中相邻两个小集合元素之间的部分
+ * 整段复制.
+ * @param a 集合, m 个元素.
+ * @param b 集合, n 个元素.
+ * @param c 输出数组, 至少 m + n 个元素.
+ * @return 并集的元素个数.
+ */
+int UnionArray(const ElemType *a, int m, const ElemType *b, int n, ElemType *c);
+
+/**
+ * @brief 求差集 c = a - b.
+ * @param a 集合, m 个元素.
+ * @param b 集合, n 个元素.
+ * @param c 输出数组, 至少 m 个元素.
+ * @return 差集的元素个数.
+ */
+int DifferenceArray(const ElemType *a, int m, const ElemType *b, int n,
+                    ElemType *c);
+
+/**
+ * @brief 求顺序表的交集 C = A ∩ B, 不破坏原表. A, B 的元素严格递增.
+ * @param A 顺序表.
+ * @param B 顺序表.
+ * @param C 指向已初始化的顺序表的指针, 容量不足时重新分配.
+ */
+Status Intersect_Sq(SqList A, SqList B, SqList *C);
+
+/**
+ * @brief 求顺序表的并集 C = A ∪ B, 不破坏原表. A, B 的元素严格递增.
+ * @param A 顺序表.
+ * @param B 顺序表.
+ * @param C 指向已初始化的顺序表的指针, 容量不足时重新分配.
+ * @return ERROR 结果长度溢出时返回 ERROR.
+ */
+Status Union_Sq(SqList A, SqList B, SqList *C);
+
+/**
+ * @brief 求顺序表的差集 C = A - B, 不破坏原表. A, B 的元素严格递增.
+ * @param A 顺序表.
+ * @param B 顺序表.
+ * @param C 指向已初始化的顺序表的指针, 容量不足时重新分配.
+ */
+Status Difference_Sq(SqList A, SqList B, SqList *C);
+
+#endif /* SQSET_H */
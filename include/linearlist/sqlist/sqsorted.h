@@ -0,0 +1,112 @@
+﻿/**
+ * @file sqsorted.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 有序顺序表的查找.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef SQSORTED_H
+#define SQSORTED_H
+
+#include <linearlist/sqlist/sqlist.h>
+
+/**
+ * 有序顺序表的只读 Eytzinger 影子布局. 把有序表按完全二叉树的层序 (BFS 序)
+ * 重新排列: tree[k] 的孩子是 tree[2k] 和 tree[2k + 1], 根为 tree[1]. 查找
+ * 路径上相邻几层的结点在内存中相邻, 可以提前几层预取, 适合查找密集的阶段.
+ * 原表修改后影子布局失效, 需要重新构造.
+ */
+typedef struct SqEytzinger
+{
+    /* 层序排列的元素, tree[1..length], 按 64 字节对齐. */
+    ElemType *tree;
+    /* rank[k] 为 tree[k] 在原表中的位序. */
+    int *rank;
+    /* 元素个数. */
+    int length;
+    /* tree 所在的原始分配. */
+    void *block;
+} SqEytzinger;
+
+/**
+ * @brief 若 L 中元素按非递减排列, 则返回 TRUE, 否则返回 FALSE.
+ * @param L 已存在的顺序表.
+ * */
+Status ListSorted_Sq(SqList L);
+
+/**
+ * @brief 返回有序表 L 中第 1 个不小于 e 的元素的位序, 不存在时返回
+ * length + 1. 二分查找不含分支, 比较结果用条件传送选择下一段, 同时预取
+ * 两个可能的下一个中点.
+ * @param L 已存在的有序顺序表.
+ * @param e 待查找数据元素.
+ * */
+int LowerBound_Sq(SqList L, ElemType e);
+
+/**
+ * @brief 返回有序表 L 中第 1 个大于 e 的元素的位序, 不存在时返回 length + 1.
+ * @param L 已存在的有序顺序表.
+ * @param e 待查找数据元素.
+ * */
+int UpperBound_Sq(SqList L, ElemType e);
+
+/**
+ * @brief 对 n 个关键字分别求 LowerBound_Sq(). 表长相同时各次二分的步数相同,
+ * 所以每 16 个关键字一组同步推进, 组内的访存互不依赖, 可以同时等待.
+ * @param L 已存在的有序顺序表.
+ * @param e 待查找的 n 个数据元素.
+ * @param n 关键字个数.
+ * @param pos 用以返回 n 个位序.
+ * */
+Status LowerBoundBatch_Sq(SqList L, const ElemType *e, int n, int *pos);
+
+/**
+ * @brief 在有序表 L 中按 e 的位置插入 e, 相等的元素插在已有元素之后.
+ * @param L 指向已存在的有序顺序表的指针.
+ * @param e 待插入数据元素.
+ * */
+Status SortedInsert_Sq(SqList *L, ElemType e);
+
+/**
+ * @brief 由有序表 L 构造 Eytzinger 影子布局. 时间复杂度 O(n).
+ * @param E 用以返回影子布局.
+ * @param L 已存在的有序顺序表.
+ * */
+Status InitEytzinger_Sq(SqEytzinger *E, SqList L);
+
+/**
+ * @brief 销毁影子布局.
+ * @param E 指向影子布局的指针.
+ * */
+Status DestroyEytzinger_Sq(SqEytzinger *E);
+
+/**
+ * @brief 同 LowerBound_Sq(), 在影子布局中查找. 每步预取 4 层之后的 16 个
+ * 后代, 它们恰好占一个缓存行.
+ * @param E 影子布局.
+ * @param e 待查找数据元素.
+ * */
+int EytzingerLowerBound_Sq(const SqEytzinger *E, ElemType e);
+
+/**
+ * @brief 同 UpperBound_Sq(), 在影子布局中查找.
+ * @param E 影子布局.
+ * @param e 待查找数据元素.
+ * */
+int EytzingerUpperBound_Sq(const SqEytzinger *E, ElemType e);
+
+/**
+ * @brief 同 LowerBoundBatch_Sq(), 在影子布局中查找.
+ * @param E 影子布局.
+ * @param e 待查找的 n 个数据元素.
+ * @param n 关键字个数.
+ * @param pos 用以返回 n 个位序.
+ * */
+Status EytzingerLowerBoundBatch_Sq(const SqEytzinger *E, const ElemType *e,
+                                   int n, int *pos);
+
+#endif /* SQSORTED_H */
@@ -0,0 +1,139 @@
+﻿/**
+ * @file ringqueue.h
+ * @author tianshihao4944@126.com
+ * @brief 环形缓冲队列.
+ * @version 0.2
+ * @date 2020-11-22
+ * @copyright Copyright (c) 2020
+ */
+
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include <stddef.h>
+
+#include <status.h>
+
+/* 未指定容量时的初始容量. */
+#define RING_QUEUE_INIT_SIZE 16
+
+/* 队列存储类型为 int. */
+typedef int QueueElemType;
+
+/**
+ * @brief 环形缓冲队列的存储类型. 与 SqQueue 相比:
+ * 1. 容量为 2 的幂, 下标与 mask 按位与即得槽位, 不用取模;
+ * 2. head 和 tail 是只增不减的计数, 元素个数为 tail - head, 不必牺牲一个
+ *    单元来区分队空和队满, 计数回绕后差值仍然正确;
+ * 3. 队满时容量加倍, 入队均摊 O(1); 也可以固定容量, 队满时入队返回 ERROR.
+ */
+typedef struct RingQueue
+{
+    /* 存储空间. */
+    QueueElemType *base;
+
+    /* 容量减一. */
+    size_t mask;
+
+    /* 已出队的元素个数, 队头元素在 base[head & mask]. */
+    size_t head;
+
+    /* 已入队的元素个数, 下一个元素存入 base[tail & mask]. */
+    size_t tail;
+
+    /* 为 TRUE 时容量固定, 不自动扩充. */
+    Status fixed;
+} RingQueue;
+
+/**
+ * @brief 初始化环形缓冲队列, 构造一个空队列.
+ * @param Q 指向环形缓冲队列的指针.
+ * @param capacity 初始容量, 向上取为 2 的幂; 为 0 时使用 RING_QUEUE_INIT_SIZE.
+ * @param fixed 为 TRUE 时容量固定, 为 FALSE 时队满自动扩充.
+ * @return OK 构造成功返回 OK.
+ * @return ERROR 容量过大返回 ERROR.
+ */
+Status InitQueueRing(RingQueue *Q, size_t capacity, Status fixed);
+
+/**
+ * @brief 判队列空.
+ * @param Q 环形缓冲队列.
+ * @return TRUE 队列为空返回 TRUE.
+ * @return FALSE 队列不空返回 FALSE.
+ */
+Status QueueEmptyRing(RingQueue Q);
+
+/**
+ * @brief 判队列满. 不固定容量的队列满时, 下一次入队会扩充容量.
+ * @param Q 环形缓冲队列.
+ * @return TRUE 队列已满返回 TRUE.
+ * @return FALSE 队列未满返回 FALSE.
+ */
+Status QueueFullRing(RingQueue Q);
+
+/**
+ * @brief 保证队列的容量不小于 n, 不足时扩充为不小于 n 的 2 的幂. 固定容量的
+ * 队列也可以用它预先扩充. 已知元素个数的上界时 (如广度优先遍历时的顶点数),
+ * 预先扩充可以避免入队时扩充.
+ * @param Q 指向环形缓冲队列的指针.
+ * @param n 需要的容量.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 容量过大返回 ERROR.
+ */
+Status ReserveQueueRing(RingQueue *Q, size_t n);
+
+/**
+ * @brief 元素入队. 队满时, 不固定容量的队列先把容量加倍, 固定容量的队列返回
+ * ERROR.
+ * @param Q 指向环形缓冲队列的指针.
+ * @param e 入队的数据元素.
+ * @return OK 入队成功返回 OK.
+ * @return ERROR 固定容量的队列已满返回 ERROR.
+ */
+Status EnQueueRing(RingQueue *Q, QueueElemType e);
+
+/**
+ * @brief 元素出队, 并用 e 返回.
+ * @param Q 指向环形缓冲队列的指针.
+ * @param e 用以返回队头元素.
+ * @return OK 出队成功返回 OK.
+ * @return ERROR 队列为空返回 ERROR.
+ */
+Status DeQueueRing(RingQueue *Q, QueueElemType *e);
+
+/**
+ * @brief 读队头元素. 若队列不空, 则用 e 返回 Q 的队头元素, 并返回 OK;
+ * 否则返回 ERROR.
+ * @param Q 环形缓冲队列.
+ * @param e 存储队头元素.
+ */
+Status GetHeadRing(RingQueue Q, QueueElemType *e);
+
+/**
+ * @brief 返回队列中数据元素个数.
+ * @param Q 环形缓冲队列.
+ * @return size_t 队列中元素个数.
+ */
+size_t QueueLengthRing(RingQueue Q);
+
+/**
+ * @brief 返回队列的容量.
+ * @param Q 环形缓冲队列.
+ * @return size_t 队列容量.
+ */
+size_t QueueCapacityRing(RingQueue Q);
+
+/**
+ * @brief 销毁环形缓冲队列, 释放其内存空间.
+ * @param Q 指向环形缓冲队列的指针.
+ * @return Status 销毁成功返回 OK.
+ */
+Status DestoryQueueRing(RingQueue *Q);
+
+/**
+ * @brief 打印队列数据.
+ * @param Q 环形缓冲队列.
+ */
+void PrintQueueRing(RingQueue Q);
+
+#endif /* RINGQUEUE_H */
@@ -0,0 +1,116 @@
+﻿/**
+ * @file spscqueue.h
+ * @author tianshihao4944@126.com
+ * @brief 单生产者单消费者无锁环形队列.
+ * @version 0.2
+ * @date 2020-11-22
+ * @copyright Copyright (c) 2020
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include <status.h>
+
+/* 缓存行字节数, 两端各自写的字段分放在不同的缓存行上. */
+#define SPSC_CACHE_LINE 64
+
+/* 队列存储类型为 int. */
+typedef int QueueElemType;
+
+/**
+ * @brief 单生产者单消费者无锁环形队列. 一个线程只入队, 另一个线程只出队, 不用
+ * 锁也不用 CAS:
+ * 1. tail 只由生产者写, head 只由消费者写. 生产者写入元素后以 release 语义
+ *    推进 tail, 消费者以 acquire 语义读 tail 后再读元素, 反之亦然, 所以读到
+ *    的元素一定已经写完, 腾出的槽位一定已经读完;
+ * 2. head 和 tail 放在不同的缓存行上, 两端各写各的, 不会来回争抢同一缓存行;
+ * 3. 每端缓存对方的位置, 只有按缓存的位置看来队满 (或队空) 时才重新读对方的
+ *    位置, 大多数操作不碰对方的缓存行;
+ * 4. 批量入队和出队一次推进位置, 多个元素只付一次原子操作的代价.
+ * 容量为 2 的幂, 与 RingQueue 一样用只增不减的计数和掩码, 不牺牲单元. 容量
+ * 固定, 队满时入队返回 ERROR, 由调用者决定等待还是丢弃.
+ *
+ * 结构体按缓存行对齐, 放在栈上或静态存储区时由编译器保证; 动态分配时要用
+ * aligned_alloc().
+ */
+typedef struct SpscQueue
+{
+    /* 存储空间和容量减一, 初始化后不变, 两端只读. */
+    QueueElemType *base;
+    size_t mask;
+
+    /* 生产者的缓存行: 已入队的元素个数, 以及缓存的 head. */
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t tail;
+    size_t headCache;
+
+    /* 消费者的缓存行: 已出队的元素个数, 以及缓存的 tail. */
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t head;
+    size_t tailCache;
+} SpscQueue;
+
+/**
+ * @brief 初始化队列. 必须在两个线程开始使用之前完成.
+ * @param Q 指向队列的指针.
+ * @param capacity 容量, 向上取为 2 的幂, 至少为 1.
+ * @return OK 构造成功返回 OK.
+ * @return ERROR 容量过大返回 ERROR.
+ */
+Status InitQueueSpsc(SpscQueue *Q, size_t capacity);
+
+/**
+ * @brief 销毁队列, 释放其内存空间. 必须在两个线程都不再使用之后调用.
+ * @param Q 指向队列的指针.
+ * @return Status 销毁成功返回 OK.
+ */
+Status DestoryQueueSpsc(SpscQueue *Q);
+
+/**
+ * @brief 元素入队, 只能由生产者调用.
+ * @param Q 指向队列的指针.
+ * @param e 入队的数据元素.
+ * @return OK 入队成功返回 OK.
+ * @return ERROR 队列已满返回 ERROR.
+ */
+Status EnQueueSpsc(SpscQueue *Q, QueueElemType e);
+
+/**
+ * @brief 元素出队, 只能由消费者调用.
+ * @param Q 指向队列的指针.
+ * @param e 用以返回队头元素.
+ * @return OK 出队成功返回 OK.
+ * @return ERROR 队列为空返回 ERROR.
+ */
+Status DeQueueSpsc(SpscQueue *Q, QueueElemType *e);
+
+/**
+ * @brief 批量入队, 只能由生产者调用. 依次入队 e 中前若干个元素, 直到队满或
+ * 全部入队, 只推进一次 tail.
+ * @param Q 指向队列的指针.
+ * @param e 入队的数据元素.
+ * @param n 元素个数.
+ * @return size_t 实际入队的元素个数, 队满时为 0.
+ */
+size_t EnQueueBatchSpsc(SpscQueue *Q, const QueueElemType *e, size_t n);
+
+/**
+ * @brief 批量出队, 只能由消费者调用. 至多出队 n 个元素存入 e, 只推进一次
+ * head.
+ * @param Q 指向队列的指针.
+ * @param e 用以返回出队的元素.
+ * @param n 至多出队的元素个数.
+ * @return size_t 实际出队的元素个数, 队空时为 0.
+ */
+size_t DeQueueBatchSpsc(SpscQueue *Q, QueueElemType *e, size_t n);
+
+/**
+ * @brief 返回队列中元素个数. 另一端同时在操作时只是一个近似值.
+ * @param Q 指向队列的指针.
+ * @return size_t 队列中元素个数.
+ */
+size_t QueueLengthSpsc(SpscQueue *Q);
+
+#endif /* SPSCQUEUE_H */
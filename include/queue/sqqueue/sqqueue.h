@@ -13,7 +13,7 @@
 #include <status.h>
 
 // 队列的最大尺寸为 100.  实际能存储的元素数量为QUEUE_MAX_SIZE-1
-#define MAX_SIZE 100
+#define QUEUE_MAX_SIZE 100
 
 // 队列存储类型为 int.
 typedef int QueueElemType;
@@ -8,84 +8,246 @@
 #ifndef HUFFMANTREE_H
 #define HUFFMANTREE_H
 
-#include <stdio.h>
-#include <stdlib.h>
-
-typedef struct HTNode
-{
-    unsigned int weight;
-    unsigned int parent, lchild, rchild;
-} HTNode, *HuffmanTree; // 动态分配数组存储赫夫曼树.
-
-typedef char **HuffmanCode; // 动态分配数组存储赫夫曼编码表.
-
-// 从赫夫曼树的第 1 到 第 i - 1 个元素中找到最小的两个的索引.
-void Select(HuffmanTree HT, int range, int &s1, int &s2)
-{
-    // 赫夫曼树的 0 号空间未用.
-    for (int i = 1; i <= i - 1; ++i)
-    {
-        // 更新最小.
-        if (HT[i].weight < HT[*s1].weight)
-        {
-            *s1 = i;
-        }
-        // 更新次小.
-        else if ((HT[i].weight >= HT[*s1].weight) && (HT[i].weight < HT[*s2].weight))
-        {
-            *s2 = i;
-        }
-    }
-} // Select
-
-// 数组 *w 为 n 个结点的权重.
-void HuffmanCoding(HuffmanTree &HT, HuffmanCode &HC, int *w, int n)
-{
-    if (n <= 1)
-    {
-        return;
-    }
-
-    // 叶结点有 n 个, 所有结点有 2 * n - 1 个
-    int node_number = 2 * n - 1;
-
-    // 为赫夫曼树分配内存, 0号空间未用.
-    (*HT) = (HTNode *)malloc(sizeof(node_number + 1) * sizeof(HTNode));
-
-    // 初始化前面的结点
-    for (HuffmanTree p = *HT, i = 1; i <= n; ++i, ++p, ++w)
-    {
-        (*p).weight = w[i];
-        (*p).lchild = 0;
-        (*p).rchild = 0;
-        (*p).parent = 0;
-    }
-
-    // 初始化后面的结点
-    for (int i = n + 1; i < = m; ++i)
-    {
-        (*p).weight = 0;
-        (*p).lchild = 0;
-        (*p).rchild = 0;
-        (*p).parent = 0;
-    }
-    // 建立赫夫曼树
-    for (int i = n + 1; i <= node_number; ++i)
-    {
-        // 从 HT[1, i - 1]  中选择 parent 为 0, 且 weight 最小的两个结点,
-        // 其序号分别为 s1, s2.
-        int s1 = 1, s2 = 1;
-
-        Select(*HT, i - 1, &s1, &s2);
-
-        // 新建结点, 编号为 i, 为 s1 和 s2 的父结点
-        *HT[s1].parent = i;
-        *HT[s2].parent = i;
-        *HT[i].lchild = s1;
-        *HT[i].rchild = s2;
-        *HT[i].weight = *HT[s1].weight + *HT[s2].weight;
-    }
-
-} // HuffmanCoding
-
-#endif // HUFFMANTREE_H
+#include <stddef.h>
+#include <status.h>
+
+/* 赫夫曼树支持的最大字母表大小. */
+#define HUFFMAN_MAX_SYMBOLS 65536
+/* 范式赫夫曼编码允许的最大码长. */
+#define HUFFMAN_MAX_CODE_LENGTH 24
+/* 译码一级查找表的位数. 2^11 个 8 字节表项, 正好放进 L1 缓存. */
+#define HUFFMAN_TABLE_BITS 11
+
+/* 结点权值. 用 64 位保存, 以免数百万个频度累加后溢出. */
+typedef unsigned long long HTWeight;
+
+/**
+ * @brief 赫夫曼树结点. 0 号单元未用, 下标 1 到 n 为叶结点, n + 1 到 2n - 1
+ * 为内部结点, 2n - 1 为根. parent, lchild, rchild 为 0 表示不存在.
+ */
+typedef struct HTNode {
+  HTWeight weight;
+  unsigned int parent, lchild, rchild;
+} HTNode, *HuffmanTree;  // 动态分配数组存储赫夫曼树.
+
+typedef char **HuffmanCode;  // 动态分配数组存储赫夫曼编码表.
+
+/* 范式赫夫曼编码的符号类型, 字母表最多 HUFFMAN_MAX_SYMBOLS 个符号. */
+typedef unsigned short HuffmanSymbol;
+
+/**
+ * @brief 范式赫夫曼编码. 码字只由码长决定: 码长短的在前, 码长相同的按符号
+ * 递增依次取连续的码字, 所以存储或传输时只需要保存码长.
+ * @note 码流低位先出, code 中保存的是位反转后的码字.
+ */
+typedef struct CanonicalHuffman {
+  int n;                 /* 字母表大小. */
+  int maxLength;         /* 实际最大码长. */
+  unsigned char *length; /* 各符号码长, 0 表示该符号不出现. */
+  unsigned int *code;    /* 各符号位反转后的码字. */
+} CanonicalHuffman;
+
+/**
+ * @brief 查表译码器. 一级表以码流低 tableBits 位为下标, 每个表项一次给出至多
+ * 3 个完整的符号; 码长超过 tableBits 的符号由表项指向的二级表继续译出.
+ */
+typedef struct HuffmanDecoder {
+  int tableBits;             /* 一级表位数. */
+  int tableSize;             /* 一级表和全部二级表的表项总数. */
+  unsigned long long *table; /* 一级表, 其后紧跟各二级表. */
+} HuffmanDecoder;
+
+/**
+ * @brief 由 n 个叶结点的权值 w[0..n-1] 构造赫夫曼树 HT, 叶结点 i + 1 对应
+ * 权值 w[i].
+ * @note 先将叶结点按权值基数排序, 再用双队列法合并: 新生成的内部结点权值单调
+ * 不减, 所以内部结点本身就是第二个有序队列, 每次只需比较两个队头. 排序和合并
+ * 都是 O(n).
+ * @param HT 用以返回赫夫曼树.
+ * @param w 叶结点权值.
+ * @param n 叶结点个数, 1 <= n <= HUFFMAN_MAX_SYMBOLS.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 参数不合法返回 ERROR.
+ */
+Status CreateHuffmanTree(HuffmanTree *HT, const HTWeight *w, int n);
+
+/**
+ * @brief 求赫夫曼树中各叶结点的深度, 即码长. 内部结点的下标总大于其孩子,
+ * 所以从根向下扫描一遍即可, 时间复杂度 O(n).
+ * @note 只有一个叶结点时, 约定其码长为 1.
+ * @param HT 赫夫曼树.
+ * @param n 叶结点个数.
+ * @param length 用以返回码长, length[i] 为权值 w[i] 对应叶结点的码长.
+ * @return OK 操作成功返回 OK.
+ */
+Status HuffmanCodeLengths(HuffmanTree HT, int n, unsigned int *length);
+
+/**
+ * @brief 求赫夫曼树的带权路径长度 WPL.
+ * @param HT 赫夫曼树.
+ * @param n 叶结点个数.
+ * @return 带权路径长度.
+ */
+HTWeight HuffmanWPL(HuffmanTree HT, int n);
+
+/**
+ * @brief 构造赫夫曼树 HT, 并求出 n 个字符的赫夫曼编码 HC. HC[1..n] 为以
+ * '\0' 结尾的 '0'/'1' 串, HC[0] 未用.
+ * @param HT 用以返回赫夫曼树.
+ * @param HC 用以返回赫夫曼编码表.
+ * @param w n 个字符的权值.
+ * @param n 字符个数.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 参数不合法返回 ERROR.
+ */
+Status HuffmanCoding(HuffmanTree *HT, HuffmanCode *HC, const HTWeight *w,
+                     int n);
+
+/**
+ * @brief 销毁赫夫曼树.
+ * @param HT 指向赫夫曼树的指针.
+ * @return OK 操作成功返回 OK.
+ */
+Status DestroyHuffmanTree(HuffmanTree *HT);
+
+/**
+ * @brief 销毁赫夫曼编码表.
+ * @param HC 指向赫夫曼编码表的指针.
+ * @param n 字符个数.
+ * @return OK 操作成功返回 OK.
+ */
+Status DestroyHuffmanCode(HuffmanCode *HC, int n);
+
+/**
+ * @brief 求码长不超过 maxLength 的最优前缀码码长 (package-merge 算法). 先按
+ * 普通赫夫曼树求码长, 不超过限制时直接返回; 否则从最深一层起, 逐层把上一层
+ * 的元素两两打包, 与叶结点归并, 在最上层取前 2m - 2 个元素, 再逐层向下统计
+ * 每个叶结点被选中的次数, 即为其码长. 时间复杂度 O(m * maxLength).
+ * @param w 各符号权值, 权值为 0 的符号码长为 0.
+ * @param n 字母表大小, 1 <= n <= HUFFMAN_MAX_SYMBOLS.
+ * @param maxLength 最大码长, 1 <= maxLength <= HUFFMAN_MAX_CODE_LENGTH, 且
+ * 2^maxLength 不小于非零权值符号的个数.
+ * @param length 用以返回码长.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 参数不合法返回 ERROR.
+ */
+Status LimitedCodeLengths(const HTWeight *w, int n, int maxLength,
+                          unsigned char *length);
+
+/**
+ * @brief 由码长构造范式赫夫曼编码.
+ * @param H 用以返回范式赫夫曼编码.
+ * @param length 各符号码长, 不超过 HUFFMAN_MAX_CODE_LENGTH.
+ * @param n 字母表大小.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 码长超限, 不满足 Kraft 不等式或全为 0 时返回 ERROR.
+ */
+Status CreateCanonicalHuffman(CanonicalHuffman *H, const unsigned char *length,
+                              int n);
+
+/**
+ * @brief 由权值直接构造码长不超过 maxLength 的范式赫夫曼编码.
+ * @param H 用以返回范式赫夫曼编码.
+ * @param w 各符号权值.
+ * @param n 字母表大小.
+ * @param maxLength 最大码长.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 参数不合法返回 ERROR.
+ */
+Status BuildCanonicalHuffman(CanonicalHuffman *H, const HTWeight *w, int n,
+                             int maxLength);
+
+/**
+ * @brief 销毁范式赫夫曼编码.
+ * @param H 指向范式赫夫曼编码的指针.
+ * @return OK 操作成功返回 OK.
+ */
+Status DestroyCanonicalHuffman(CanonicalHuffman *H);
+
+/**
+ * @brief 编码 count 个符号时输出缓冲区至少需要的字节数. 编码器每次整块写出
+ * 8 个字节, 所以比实际码流多留了余量, 对 HuffmanEncodeBytes4() 同样适用.
+ * @param count 符号个数.
+ * @param maxLength 最大码长.
+ * @return 所需字节数.
+ */
+size_t HuffmanEncodeBound(size_t count, int maxLength);
+
+/**
+ * @brief 将 count 个符号编码为紧凑的位流, 低位先出.
+ * @param H 范式赫夫曼编码, src 中每个符号的码长都不为 0.
+ * @param src 待编码符号.
+ * @param count 符号个数.
+ * @param dst 输出缓冲区, 大小不小于 HuffmanEncodeBound().
+ * @return 码流的字节数.
+ */
+size_t HuffmanEncode(const CanonicalHuffman *H, const HuffmanSymbol *src,
+                     size_t count, unsigned char *dst);
+
+/**
+ * @brief 同 HuffmanEncode(), 符号为字节, 字母表大小不超过 256.
+ */
+size_t HuffmanEncodeBytes(const CanonicalHuffman *H, const unsigned char *src,
+                          size_t count, unsigned char *dst);
+
+/**
+ * @brief 将字节序列等分为 4 段, 各自编码为独立的位流. 输出以 3 个 4 字节小端
+ * 整数开头, 依次为前 3 段码流的字节数, 之后紧跟 4 段码流.
+ * @note 单条位流的译码受查表延迟限制, 4 条位流可以交错译码.
+ * @param H 范式赫夫曼编码, 字母表大小不超过 256.
+ * @param src 待编码字节.
+ * @param count 字节数.
+ * @param dst 输出缓冲区, 大小不小于 HuffmanEncodeBound().
+ * @return 输出的字节数.
+ */
+size_t HuffmanEncodeBytes4(const CanonicalHuffman *H, const unsigned char *src,
+                           size_t count, unsigned char *dst);
+
+/**
+ * @brief 由范式赫夫曼编码构造查表译码器.
+ * @param D 用以返回译码器.
+ * @param H 范式赫夫曼编码.
+ * @return OK 操作成功返回 OK.
+ */
+Status CreateHuffmanDecoder(HuffmanDecoder *D, const CanonicalHuffman *H);
+
+/**
+ * @brief 从位流 src 中译出 count 个符号.
+ * @param D 译码器.
+ * @param src 码流.
+ * @param srcSize 码流字节数.
+ * @param dst 输出缓冲区, 至少 count 个符号.
+ * @param count 要译出的符号个数.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 码流非法或长度不足返回 ERROR.
+ */
+Status HuffmanDecode(const HuffmanDecoder *D, const unsigned char *src,
+                     size_t srcSize, HuffmanSymbol *dst, size_t count);
+
+/**
+ * @brief 同 HuffmanDecode(), 符号为字节, 字母表大小不超过 256.
+ */
+Status HuffmanDecodeBytes(const HuffmanDecoder *D, const unsigned char *src,
+                          size_t srcSize, unsigned char *dst, size_t count);
+
+/**
+ * @brief 译出 HuffmanEncodeBytes4() 产生的 4 段码流, 4 个读取器交错执行.
+ * @param D 译码器.
+ * @param src 码流.
+ * @param srcSize 码流字节数.
+ * @param dst 输出缓冲区, 至少 count 个字节.
+ * @param count 要译出的字节数.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 码流非法或长度不足返回 ERROR.
+ */
+Status HuffmanDecodeBytes4(const HuffmanDecoder *D, const unsigned char *src,
+                           size_t srcSize, unsigned char *dst, size_t count);
+
+/**
+ * @brief 销毁译码器.
+ * @param D 指向译码器的指针.
+ * @return OK 操作成功返回 OK.
+ */
+Status DestroyHuffmanDecoder(HuffmanDecoder *D);
+
+#endif  // HUFFMANTREE_H
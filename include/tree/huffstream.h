@@ -0,0 +1,149 @@
+﻿/**
+ * @file huffstream.h
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 基于范式赫夫曼编码的分块流式压缩.
+ * @version 0.1
+ * @date 2020-04-28
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef HUFFSTREAM_H
+#define HUFFSTREAM_H
+
+#include <huffmantree.h>
+
+/**
+ * 容器格式, 所有整数均为小端序:
+ *
+ *   文件头 16 字节: "HUFZ", 版本号 u32, 块大小 u32, 保留 u32.
+ *   若干数据块, 每块一个 16 字节块头: 原始长度 u32, 负载长度 u32, 原始数据的
+ *     CRC-32 u32, 类型 u8, 保留 3 字节; 之后是负载. 各块互相独立, 各有自己的
+ *     码表, 可以并行压缩和解压.
+ *   结束块: 类型为 HUFFSTREAM_END, 负载为块索引: 块数 u32, 各块块头在文件中
+ *     的偏移 u64[块数], CRC 字段为索引的 CRC-32.
+ *   文件尾 20 字节: 结束块的偏移 u64, 原始数据总长度 u64, "HUFX".
+ *
+ * 顺序解压只需向后读, 遇到结束块即停止, 所以可以用于管道; 随机访问时先读
+ * 文件尾, 再由索引直接定位到任意块.
+ */
+
+/* 默认块大小. */
+#define HUFFSTREAM_BLOCK_SIZE (128 * 1024)
+/* 允许的最大块大小. */
+#define HUFFSTREAM_MAX_BLOCK_SIZE (16 * 1024 * 1024)
+/* 块内码表的最大码长, 与一级译码表位数相同, 译码时不需要二级表. */
+#define HUFFSTREAM_MAX_CODE_LENGTH HUFFMAN_TABLE_BITS
+
+/* 块头长度. */
+#define HUFFSTREAM_FRAME_HEADER 16
+
+/* 块类型. */
+#define HUFFSTREAM_STORED 0  // 不压缩, 负载即原始数据.
+#define HUFFSTREAM_RLE 1     // 只有一种字节, 负载为该字节.
+#define HUFFSTREAM_HUFFMAN 2 // 128 字节的码长表 (每个 4 位) 加 4 段码流.
+#define HUFFSTREAM_END 0xff  // 结束块, 负载为块索引.
+
+/* 压缩或解压的统计信息. */
+typedef struct HuffstreamStat {
+  unsigned long long rawBytes;    /* 原始数据字节数. */
+  unsigned long long packedBytes; /* 压缩文件字节数. */
+  unsigned int blocks;            /* 数据块个数. */
+} HuffstreamStat;
+
+/**
+ * @brief 计算 CRC-32 (多项式 0xEDB88320), 每次处理 8 个字节.
+ * @param crc 之前的校验值, 初始为 0.
+ * @param data 数据.
+ * @param size 字节数.
+ * @return 新的校验值.
+ */
+unsigned int Crc32(unsigned int crc, const unsigned char *data, size_t size);
+
+/**
+ * @brief 压缩一个原始长度为 rawSize 的块时, 块头加负载最多需要的字节数.
+ * @param rawSize 原始长度.
+ * @return 所需字节数.
+ */
+size_t HuffstreamFrameBound(size_t rawSize);
+
+/**
+ * @brief 压缩一个数据块, 写出块头和负载. 压缩后不比原始数据小时按原样存储.
+ * @param src 原始数据.
+ * @param rawSize 原始长度, 不超过 HUFFSTREAM_MAX_BLOCK_SIZE.
+ * @param dst 输出缓冲区, 大小不小于 HuffstreamFrameBound().
+ * @return 块头加负载的字节数.
+ */
+size_t HuffstreamCompressBlock(const unsigned char *src, size_t rawSize,
+                               unsigned char *dst);
+
+/**
+ * @brief 解压一个数据块, 并校验 CRC-32.
+ * @param frame 块头和负载.
+ * @param frameSize frame 的字节数.
+ * @param dst 输出缓冲区.
+ * @param capacity 输出缓冲区字节数.
+ * @param rawSize 用以返回原始长度.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 数据损坏或缓冲区不足返回 ERROR.
+ */
+Status HuffstreamDecompressBlock(const unsigned char *frame, size_t frameSize,
+                                 unsigned char *dst, size_t capacity,
+                                 size_t *rawSize);
+
+/**
+ * @brief 从 in 读入全部数据, 分块压缩后写入 out. 每批读入 threads * 8 个块,
+ * 由 threads 个线程并行压缩, 再按顺序写出.
+ * @param in 输入文件.
+ * @param out 输出文件, 不要求可定位.
+ * @param blockSize 块大小, 0 表示使用 HUFFSTREAM_BLOCK_SIZE.
+ * @param threads 线程数, 至少为 1.
+ * @param stat 用以返回统计信息, 可以为 NULL.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 参数不合法或读写失败返回 ERROR.
+ */
+Status HuffstreamCompress(FILE *in, FILE *out, size_t blockSize, int threads,
+                          HuffstreamStat *stat);
+
+/**
+ * @brief 顺序读入压缩文件, 并行解压后写入 out.
+ * @param in 压缩文件, 不要求可定位.
+ * @param out 输出文件.
+ * @param threads 线程数, 至少为 1.
+ * @param stat 用以返回统计信息, 可以为 NULL.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 数据损坏或读写失败返回 ERROR.
+ */
+Status HuffstreamDecompress(FILE *in, FILE *out, int threads,
+                            HuffstreamStat *stat);
+
+/**
+ * @brief 读取可定位压缩文件的块索引.
+ * @param in 压缩文件.
+ * @param offset 用以返回各块块头的偏移, 共 count + 1 项, 最后一项为结束块的
+ * 偏移, 由调用者 free().
+ * @param count 用以返回块数.
+ * @param rawBytes 用以返回原始数据总长度.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 文件不完整或损坏返回 ERROR.
+ */
+Status HuffstreamReadIndex(FILE *in, unsigned long long **offset,
+                           unsigned int *count, unsigned long long *rawBytes);
+
+/**
+ * @brief 借助块索引, 只读取并解压第 k 块.
+ * @param in 压缩文件.
+ * @param offset HuffstreamReadIndex() 返回的块索引.
+ * @param k 块号, 0 <= k < 块数.
+ * @param dst 输出缓冲区, 不小于文件头中的块大小.
+ * @param capacity 输出缓冲区字节数.
+ * @param rawSize 用以返回该块原始长度.
+ * @return OK 操作成功返回 OK.
+ * @return ERROR 数据损坏或读写失败返回 ERROR.
+ */
+Status HuffstreamReadBlock(FILE *in, const unsigned long long *offset,
+                           unsigned int k, unsigned char *dst,
+                           size_t capacity, size_t *rawSize);
+
+#endif  // HUFFSTREAM_H
@@ -0,0 +1,346 @@
+﻿/**
+ * @file lfbench.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 无锁有序链表的多线程压力与吞吐量测试.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include <linearlist/linklist/lflinklist.h>
+#include <linearlist/linklist/linklist.h>
+
+/* 最多的读线程或写线程数. */
+#define LFBENCH_MAX_THREADS 64
+
+/* 测试参数和共享状态. */
+typedef struct Bench
+{
+    int mutex;
+    int keys;
+    atomic_int stop;
+    /* 无锁链表. */
+    LFList lf;
+    /* 对照组: 一把全局互斥锁保护的有序单向链表. */
+    Linklist L;
+    pthread_mutex_t lock;
+} Bench;
+
+/* 每个线程的计数. */
+typedef struct Worker
+{
+    Bench *bench;
+    int writer;
+    unsigned int seed;
+    long long ops, inserted, deleted;
+    pthread_t thread;
+} Worker;
+
+static double Now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int NextKey(Worker *w)
+{
+    w->seed ^= w->seed << 13;
+    w->seed ^= w->seed >> 17;
+    w->seed ^= w->seed << 5;
+
+    return (int)(w->seed % (unsigned int)w->bench->keys);
+}
+
+/* 有序单向链表中查找, 调用者持锁. */
+static Status ContainsLocked(Linklist L, ElemType e)
+{
+    LNode *p = L->next;
+
+    while (p && p->data < e)
+    {
+        p = p->next;
+    }
+
+    return p && p->data == e;
+}
+
+/* 有序单向链表中插入不重复的 e, 调用者持锁. */
+static Status InsertLocked(Linklist L, ElemType e)
+{
+    LNode *pre = L;
+
+    while (pre->next && pre->next->data < e)
+    {
+        pre = pre->next;
+    }
+    if (pre->next && pre->next->data == e)
+    {
+        return ERROR;
+    }
+
+    LNode *s = NodePoolAlloc(ListHeadPool(L));
+    s->data = e;
+    s->next = pre->next;
+    pre->next = s;
+
+    return OK;
+}
+
+/* 有序单向链表中删除 e, 调用者持锁. */
+static Status DeleteLocked(Linklist L, ElemType e)
+{
+    LNode *pre = L;
+
+    while (pre->next && pre->next->data < e)
+    {
+        pre = pre->next;
+    }
+    if (!pre->next || pre->next->data != e)
+    {
+        return ERROR;
+    }
+
+    LNode *p = pre->next;
+    pre->next = p->next;
+    NodePoolFree(ListHeadPool(L), p);
+
+    return OK;
+}
+
+/* 读线程只查找, 写线程交替插入和删除随机元素. */
+static void *Run(void *arg)
+{
+    Worker *w = arg;
+    Bench *b = w->bench;
+    LFThread *T = b->mutex ? NULL : RegisterThread_LF(&b->lf);
+
+    while (!atomic_load_explicit(&b->stop, memory_order_relaxed))
+    {
+        int key = NextKey(w);
+        Status s;
+
+        if (!w->writer)
+        {
+            if (b->mutex)
+            {
+                pthread_mutex_lock(&b->lock);
+                s = ContainsLocked(b->L, key);
+                pthread_mutex_unlock(&b->lock);
+            }
+            else
+            {
+                s = Contains_LF(&b->lf, T, key);
+            }
+            (void)s;
+        }
+        else if (w->ops & 1)
+        {
+            if (b->mutex)
+            {
+                pthread_mutex_lock(&b->lock);
+                s = DeleteLocked(b->L, key);
+                pthread_mutex_unlock(&b->lock);
+            }
+            else
+            {
+                s = Delete_LF(&b->lf, T, key);
+            }
+            w->deleted += s == OK;
+        }
+        else
+        {
+            if (b->mutex)
+            {
+                pthread_mutex_lock(&b->lock);
+                s = InsertLocked(b->L, key);
+                pthread_mutex_unlock(&b->lock);
+            }
+            else
+            {
+                s = Insert_LF(&b->lf, T, key);
+            }
+            w->inserted += s == OK;
+        }
+
+        ++w->ops;
+    }
+
+    if (T)
+    {
+        UnregisterThread_LF(&b->lf, T);
+    }
+
+    return NULL;
+}
+
+/* 检查链表严格递增, 返回元素个数, 不满足时返回 -1. */
+static int Check(Bench *b)
+{
+    int count = 0;
+    long long last = -1;
+
+    if (b->mutex)
+    {
+        for (LNode *p = b->L->next; p; p = p->next, ++count)
+        {
+            if (p->data <= last)
+            {
+                return -1;
+            }
+            last = p->data;
+        }
+    }
+    else
+    {
+        for (LFNode *p = (LFNode *)atomic_load(&b->lf.head.next); p;
+             p = (LFNode *)atomic_load(&p->next), ++count)
+        {
+            if (p->data <= last || (atomic_load(&p->next) & 1))
+            {
+                return -1;
+            }
+            last = p->data;
+        }
+    }
+
+    return count;
+}
+
+static void Usage()
+{
+    fprintf(stderr,
+            "usage: lfbench [-m] [-r readers] [-w writers] [-k keys] "
+            "[-s seconds]\n"
+            "  -m  use a mutex-protected Linklist instead of the lock-free "
+            "list\n");
+}
+
+int main(int argc, char *argv[])
+{
+    static Bench b;
+    static Worker worker[2 * LFBENCH_MAX_THREADS];
+    int readers = 2, writers = 2;
+    double seconds = 1.0;
+
+    b.keys = 1000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-m") == 0)
+        {
+            b.mutex = 1;
+        }
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+        {
+            readers = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+        {
+            writers = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+        {
+            b.keys = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            seconds = atof(argv[++i]);
+        }
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    if (readers < 0 || readers > LFBENCH_MAX_THREADS || writers < 0 ||
+        writers > LFBENCH_MAX_THREADS || readers + writers == 0 ||
+        b.keys < 1 || seconds <= 0)
+    {
+        Usage();
+        return 1;
+    }
+
+    /* 预先放入一半的元素. */
+    InitList_LF(&b.lf);
+    InitList_L(&b.L);
+    pthread_mutex_init(&b.lock, NULL);
+    LFThread *T = RegisterThread_LF(&b.lf);
+    int initial = 0;
+    for (int key = b.keys - 2 + b.keys % 2; key >= 0; key -= 2, ++initial)
+    {
+        if (b.mutex)
+        {
+            HeadInsert_L(b.L, key);
+        }
+        else
+        {
+            Insert_LF(&b.lf, T, key);
+        }
+    }
+    UnregisterThread_LF(&b.lf, T);
+
+    int n = readers + writers;
+    for (int i = 0; i < n; ++i)
+    {
+        worker[i].bench = &b;
+        worker[i].writer = i >= readers;
+        worker[i].seed = 2463534242u + 7919u * (unsigned int)i;
+        if (pthread_create(&worker[i].thread, NULL, Run, &worker[i]) != 0)
+        {
+            fprintf(stderr, "lfbench: cannot create thread\n");
+            return 1;
+        }
+    }
+
+    struct timespec ts;
+    ts.tv_sec = (time_t)seconds;
+    ts.tv_nsec = (long)((seconds - (double)ts.tv_sec) * 1e9);
+    double start = Now();
+    nanosleep(&ts, NULL);
+    atomic_store(&b.stop, 1);
+
+    long long reads = 0, writes = 0, expected = initial;
+    for (int i = 0; i < n; ++i)
+    {
+        pthread_join(worker[i].thread, NULL);
+        if (worker[i].writer)
+        {
+            writes += worker[i].ops;
+        }
+        else
+        {
+            reads += worker[i].ops;
+        }
+        expected += worker[i].inserted - worker[i].deleted;
+    }
+    double elapsed = Now() - start;
+
+    int count = Check(&b);
+    printf("%s, %d readers, %d writers, %d keys: %.2f M reads/s, "
+           "%.2f M writes/s\n",
+           b.mutex ? "mutex Linklist" : "lock-free", readers, writers,
+           b.keys, reads / elapsed / 1e6, writes / elapsed / 1e6);
+
+    DestroyList_LF(&b.lf);
+    DestroyList_L(&b.L);
+    pthread_mutex_destroy(&b.lock);
+
+    /* 元素个数应等于初始个数加成功插入减成功删除. */
+    if (count != expected)
+    {
+        fprintf(stderr, "lfbench: list corrupted (%d elements, expected %lld)\n",
+                count, expected);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,345 @@
+﻿/**
+ * @file cache.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief LRU/LFU 缓存方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <linearlist/linklist/cache.h>
+
+/* 乘法散列, 取乘积的高 hashBits 位. */
+static uint32_t Hash(const Cache *C, ElemType key)
+{
+    return (uint32_t)(((uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ULL) >>
+                      (64 - C->hashBits));
+}
+
+/* 在散列表中查找键 key, 不存在时返回 0. */
+static uint32_t Find(const Cache *C, ElemType key)
+{
+    uint32_t k = C->head[Hash(C, key)];
+
+    while (k && C->entry[k].key != key)
+    {
+        k = C->entry[k].hnext;
+    }
+
+    return k;
+}
+
+/* 从散列链中摘下项 k. */
+static void Unhash(Cache *C, uint32_t k)
+{
+    uint32_t *p = &C->head[Hash(C, C->entry[k].key)];
+
+    while (*p != k)
+    {
+        p = &C->entry[*p].hnext;
+    }
+
+    *p = C->entry[k].hnext;
+}
+
+/* 在桶 b 之后新建一个次数为 freq 的桶. */
+static uint32_t NewBucket(Cache *C, uint32_t b, unsigned long long freq)
+{
+    CacheBucket *B = C->bucket;
+    uint32_t s = C->freeBucket;
+
+    C->freeBucket = B[s].next;
+
+    B[s].freq = freq;
+    B[s].first = B[s].last = 0;
+    B[s].prior = b;
+    B[s].next = B[b].next;
+    B[B[b].next].prior = s;
+    B[b].next = s;
+
+    return s;
+}
+
+/* 把项 k 追加到桶 b 的末尾, 作为桶中最近访问的项. */
+static void Append(Cache *C, uint32_t b, uint32_t k)
+{
+    CacheEntry *E = C->entry;
+    CacheBucket *B = C->bucket;
+
+    E[k].bucket = b;
+    E[k].next = 0;
+    E[k].prior = B[b].last;
+
+    if (B[b].last)
+    {
+        E[B[b].last].next = k;
+    }
+    else
+    {
+        B[b].first = k;
+    }
+    B[b].last = k;
+}
+
+/* 把项 k 从所在桶中摘下, 桶空时回收该桶. */
+static void Detach(Cache *C, uint32_t k)
+{
+    CacheEntry *E = C->entry;
+    CacheBucket *B = C->bucket;
+    uint32_t b = E[k].bucket;
+
+    if (E[k].prior)
+    {
+        E[E[k].prior].next = E[k].next;
+    }
+    else
+    {
+        B[b].first = E[k].next;
+    }
+
+    if (E[k].next)
+    {
+        E[E[k].next].prior = E[k].prior;
+    }
+    else
+    {
+        B[b].last = E[k].prior;
+    }
+
+    if (!B[b].first)
+    {
+        B[B[b].prior].next = B[b].next;
+        B[B[b].next].prior = B[b].prior;
+        B[b].next = C->freeBucket;
+        C->freeBucket = b;
+    }
+}
+
+/**
+ * @brief 计一次访问. LRU 只把项移到桶尾; LFU 把项移到次数加一的桶, 该桶
+ * 不存在时紧挨着原桶新建.
+ */
+static void Touch(Cache *C, uint32_t k)
+{
+    CacheBucket *B = C->bucket;
+    uint32_t b = C->entry[k].bucket;
+
+    if (C->policy == CACHE_LRU)
+    {
+        if (B[b].last != k)
+        {
+            Detach(C, k);
+            Append(C, b, k);
+        }
+        return;
+    }
+
+    uint32_t nb = B[b].next;
+    if (nb == 0 || B[nb].freq != B[b].freq + 1)
+    {
+        /* 桶中只有 k 时直接把桶的次数加一. 这样新建桶时原桶中至少还有两项,
+         * 使用中的桶数不会超过项数. */
+        if (B[b].first == k && B[b].last == k)
+        {
+            ++B[b].freq;
+            return;
+        }
+
+        /* 新桶建在 b 之后. */
+        nb = NewBucket(C, b, B[b].freq + 1);
+    }
+
+    Detach(C, k);
+    Append(C, nb, k);
+}
+
+/* 删除项 k, 值交给回调. */
+static void Remove(Cache *C, uint32_t k)
+{
+    CacheEntry *E = C->entry;
+
+    Unhash(C, k);
+    Detach(C, k);
+
+    if (C->evict)
+    {
+        C->evict(E[k].key, E[k].value, C->arg);
+    }
+
+    E[k].next = C->free;
+    C->free = k;
+    --C->count;
+}
+
+Status InitCache(Cache *C, uint32_t capacity, CachePolicy policy,
+                 CacheEvict evict, void *arg)
+{
+    if (capacity < 1 || capacity >= 1u << 31)
+    {
+        return ERROR;
+    }
+
+    /* 链头数不少于容量, 平均链长不超过 1. */
+    C->hashBits = 1;
+    while ((1u << C->hashBits) < capacity)
+    {
+        ++C->hashBits;
+    }
+
+    C->entry = malloc(sizeof(CacheEntry) * ((size_t)capacity + 1));
+    C->bucket = malloc(sizeof(CacheBucket) * ((size_t)capacity + 1));
+    C->head = calloc((size_t)1 << C->hashBits, sizeof(uint32_t));
+    /* 内存分配失败. */
+    if (!C->entry || !C->bucket || !C->head)
+    {
+        exit(OVERFLOW);
+    }
+
+    /* 项和桶各自串成空闲链, 每个项至多占用一个桶. */
+    for (uint32_t k = 1; k <= capacity; ++k)
+    {
+        C->entry[k].next = k < capacity ? k + 1 : 0;
+        C->bucket[k].next = k < capacity ? k + 1 : 0;
+    }
+    C->free = 1;
+    C->freeBucket = 1;
+
+    C->bucket[0].freq = 0;
+    C->bucket[0].first = C->bucket[0].last = 0;
+    C->bucket[0].prior = C->bucket[0].next = 0;
+
+    C->policy = policy;
+    C->capacity = capacity;
+    C->count = 0;
+    C->evict = evict;
+    C->arg = arg;
+    C->stat.hits = C->stat.misses = 0;
+    C->stat.inserts = C->stat.evictions = 0;
+
+    return OK;
+}
+
+Status DestroyCache(Cache *C)
+{
+    if (C->evict)
+    {
+        for (uint32_t b = C->bucket[0].next; b; b = C->bucket[b].next)
+        {
+            for (uint32_t k = C->bucket[b].first; k; k = C->entry[k].next)
+            {
+                C->evict(C->entry[k].key, C->entry[k].value, C->arg);
+            }
+        }
+    }
+
+    free(C->entry);
+    free(C->bucket);
+    free(C->head);
+    C->entry = NULL;
+    C->bucket = NULL;
+    C->head = NULL;
+    C->count = C->capacity = 0;
+
+    return OK;
+}
+
+Status CacheGet(Cache *C, ElemType key, void **value)
+{
+    uint32_t k = Find(C, key);
+
+    if (!k)
+    {
+        ++C->stat.misses;
+        return FALSE;
+    }
+
+    ++C->stat.hits;
+    Touch(C, k);
+
+    if (value)
+    {
+        *value = C->entry[k].value;
+    }
+
+    return TRUE;
+}
+
+Status CachePut(Cache *C, ElemType key, void *value)
+{
+    uint32_t k = Find(C, key);
+
+    if (k)
+    {
+        if (C->evict && C->entry[k].value != value)
+        {
+            C->evict(key, C->entry[k].value, C->arg);
+        }
+        C->entry[k].value = value;
+        Touch(C, k);
+
+        return OK;
+    }
+
+    /* 已满时淘汰第一个桶中最久未访问的项. */
+    if (C->count == C->capacity)
+    {
+        Remove(C, C->bucket[C->bucket[0].next].first);
+        ++C->stat.evictions;
+    }
+
+    k = C->free;
+    C->free = C->entry[k].next;
+    ++C->count;
+    ++C->stat.inserts;
+
+    C->entry[k].key = key;
+    C->entry[k].value = value;
+
+    uint32_t h = Hash(C, key);
+    C->entry[k].hnext = C->head[h];
+    C->head[h] = k;
+
+    /* 新项访问次数为 1, 进入次数为 1 的桶. */
+    uint32_t b = C->bucket[0].next;
+    if (b == 0 || C->bucket[b].freq != 1)
+    {
+        b = NewBucket(C, 0, 1);
+    }
+    Append(C, b, k);
+
+    return OK;
+}
+
+Status CacheErase(Cache *C, ElemType key)
+{
+    uint32_t k = Find(C, key);
+
+    if (!k)
+    {
+        return ERROR;
+    }
+
+    Remove(C, k);
+
+    return OK;
+}
+
+unsigned long long CacheFrequency(const Cache *C, ElemType key)
+{
+    uint32_t k = Find(C, key);
+
+    return k ? C->bucket[C->entry[k].bucket].freq : 0;
+}
+
+void PrintCacheStat(const Cache *C)
+{
+    unsigned long long lookups = C->stat.hits + C->stat.misses;
+
+    printf("%u/%u entries, %llu hits, %llu misses (%.1f%%), %llu inserts, "
+           "%llu evictions\n",
+           C->count, C->capacity, C->stat.hits, C->stat.misses,
+           lookups ? 100.0 * C->stat.hits / lookups : 0.0, C->stat.inserts,
+           C->stat.evictions);
+}
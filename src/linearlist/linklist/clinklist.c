@@ -9,17 +9,14 @@
  * 
  */
 
+#include <limits.h>
+
 #include <linearlist/linklist/clinklist.h>
 
 Status InitList_C(CLinklist *L)
 {
-    /* 为头结点分配内存空间. */
-    (*L) = malloc(sizeof(CNode));
-    /* 内存分配失败. */
-    if (!(*L))
-    {
-        exit(OVERFLOW);
-    }
+    /* 为头结点分配内存空间, 同时为链表创建结点池. */
+    (*L) = NewListHead(sizeof(CNode));
 
     /* 以存储数据为 -1 作为头结点的标志. */
     (*L)->data = -1;
@@ -32,7 +29,7 @@ Status InitList_C(CLinklist *L)
 Status HeadInsert_C(CLinklist L, ElemType e)
 {
     /* 创建新结点. */
-    CNode *s = malloc(sizeof(CNode));
+    CNode *s = NodePoolAlloc(ListHeadPool(L));
 
     /* 为新结点赋值. */
     s->data = e;
@@ -57,7 +54,7 @@ Status TailInsert_C(CLinklist L, ElemType e)
     }
 
     /* 这是新结点. */
-    CNode *s = malloc(sizeof(CNode));
+    CNode *s = NodePoolAlloc(ListHeadPool(L));
     s->data = e;
 
     /* 1. 新结点指向后继结点. */
@@ -69,6 +66,91 @@ Status TailInsert_C(CLinklist L, ElemType e)
     return OK;
 }
 
+Status CreateList_C(CLinklist *L, const ElemType *a, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    InitList_C(L);
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    CNode *s = NodePoolAllocArray(ListHeadPool(*L), (size_t)n);
+
+    for (int k = 0; k < n - 1; ++k)
+    {
+        s[k].data = a[k];
+        s[k].next = &s[k + 1];
+    }
+    s[n - 1].data = a[n - 1];
+    /* 最后一个结点指回头结点. */
+    s[n - 1].next = *L;
+
+    (*L)->next = s;
+
+    return OK;
+}
+
+int ListToArray_C(CLinklist L, ElemType *a, int max)
+{
+    int k = 0;
+
+    for (CNode *p = L->next; p != L && k < max; p = p->next)
+    {
+        /* 头结点的后继总不为空, 可以直接取. */
+        PREFETCH_NODE(p->next->next);
+        a[k++] = p->data;
+    }
+
+    return k;
+}
+
+Status SaveList_C(CLinklist L, FILE *fp)
+{
+    if (WriteListHeader(fp, (size_t)ListLength_C(L)) != OK)
+    {
+        return ERROR;
+    }
+
+    return WriteListChain(fp, L->next, L, offsetof(CNode, next));
+}
+
+Status LoadList_C(CLinklist *L, FILE *fp)
+{
+    size_t n;
+
+    if (ReadListHeader(fp, &n) != OK || n > INT_MAX)
+    {
+        return ERROR;
+    }
+
+    InitList_C(L);
+    CNode *s = n > 0 ? NodePoolAllocArray(ListHeadPool(*L), n) : NULL;
+
+    /* 数据域在结点开头, 按结点大小跨步读入. */
+    if (ReadListData(fp, s, n, sizeof(CNode)) != OK)
+    {
+        DestroyList_C(L);
+        return ERROR;
+    }
+
+    for (size_t k = 0; k + 1 < n; ++k)
+    {
+        s[k].next = &s[k + 1];
+    }
+    if (n > 0)
+    {
+        s[n - 1].next = *L;
+        (*L)->next = s;
+    }
+
+    return OK;
+}
+
 CNode *GetElem_C(CLinklist L, int i)
 {
     if (i < 0 || i > ListLength_C(L))
@@ -113,7 +195,7 @@ Status ListInsert_C(CLinklist L, int i, ElemType e)
     CNode *p = GetElem_C(L, i - 1);
 
     /* 这是要插入的结点. */
-    CNode *s = malloc(sizeof(CNode));
+    CNode *s = NodePoolAlloc(ListHeadPool(L));
     s->data = e;
 
     /* 1. 新结点指向后继结点. */
@@ -134,7 +216,7 @@ Status ListDelete_C(CLinklist L, int i)
     }
 
     /* 被删除结点的前驱结点. */
-    CNode *p = GetElem_C(L, i);
+    CNode *p = GetElem_C(L, i - 1);
 
     /* 这是要删除的结点. */
     CNode *q = p->next;
@@ -143,12 +225,21 @@ Status ListDelete_C(CLinklist L, int i)
     p->next = q->next;
 
     /* 删除结点 q. */
-    free(q);
+    NodePoolFree(ListHeadPool(L), q);
     q = NULL;
 
     return OK;
 }
 
+Status DestroyList_C(CLinklist *L)
+{
+    /* 结点都在结点池中, 释放头结点时一并释放, 不必绕环逐个 free(). */
+    FreeListHead(*L);
+    (*L) = NULL;
+
+    return OK;
+}
+
 int ListLength_C(CLinklist L)
 {
     int length = 0;
@@ -186,6 +277,14 @@ void PrintList_C(CLinklist L)
     return;
 }
 
+void Sort_C(CLinklist L, ListSortMode mode)
+{
+    /* 头结点就是链尾的标记, 排好的段最后仍指回头结点. */
+    L->next = SortChain(L->next, L, offsetof(CNode, next), mode);
+
+    return;
+}
+
 Status DelAll(CLinklist *L)
 {
     CNode *p, *pre;
@@ -220,7 +319,7 @@ Status DelAll(CLinklist *L)
 
         /* 并且删除最小值结点. */
         minPre->next = minP->next;
-        free(minP);
+        NodePoolFree(ListHeadPool(*L), minP);
         minP = NULL;
 
         if ((*L)->next != (*L))
@@ -234,7 +333,7 @@ Status DelAll(CLinklist *L)
     }
 
     /* 最后删除头结点. */
-    free((*L));
+    FreeListHead(*L);
     (*L) = NULL;
 
     return OK;
@@ -9,17 +9,14 @@
  * 
  */
 
+#include <limits.h>
+
 #include <linearlist/linklist/dclinklist.h>
 
 Status InitList_DC(DCLinklist *L)
 {
-    /* 为头结点分配内存空间. */
-    *L = malloc(sizeof(DCNode));
-    /* 内存分配失败. */
-    if (!(*L))
-    {
-        exit(OVERFLOW);
-    }
+    /* 为头结点分配内存空间, 同时为链表创建结点池. */
+    *L = NewListHead(sizeof(DCNode));
 
     (*L)->data = -1;
     (*L)->next = (*L);
@@ -31,7 +28,7 @@ Status InitList_DC(DCLinklist *L)
 Status HeadInsert_DC(DCLinklist L, ElemType e)
 {
     /* 创建新结点. */
-    DCNode *s = malloc(sizeof(DCNode));
+    DCNode *s = NodePoolAlloc(ListHeadPool(L));
 
     /* 为新结点赋值. */
     s->data = e;
@@ -54,7 +51,7 @@ Status HeadInsert_DC(DCLinklist L, ElemType e)
 Status TailInsert_DC(DCLinklist L, ElemType e)
 {
     /* 这是新结点. */
-    DCNode *s = malloc(sizeof(DCNode));
+    DCNode *s = NodePoolAlloc(ListHeadPool(L));
     s->data = e;
 
     /* 由于 L 是双向循环链表, 所以不用 O(n) 遍历找到合适的位置. */
@@ -74,6 +71,90 @@ Status TailInsert_DC(DCLinklist L, ElemType e)
     return OK;
 }
 
+Status CreateList_DC(DCLinklist *L, const ElemType *a, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    InitList_DC(L);
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    DCNode *s = NodePoolAllocArray(ListHeadPool(*L), (size_t)n);
+
+    for (int k = 0; k < n; ++k)
+    {
+        s[k].data = a[k];
+        s[k].prior = k > 0 ? &s[k - 1] : *L;
+        s[k].next = k < n - 1 ? &s[k + 1] : *L;
+    }
+
+    (*L)->next = s;
+    (*L)->prior = &s[n - 1];
+
+    return OK;
+}
+
+int ListToArray_DC(DCLinklist L, ElemType *a, int max)
+{
+    int k = 0;
+
+    for (DCNode *p = L->next; p != L && k < max; p = p->next)
+    {
+        PREFETCH_NODE(p->next->next);
+        a[k++] = p->data;
+    }
+
+    return k;
+}
+
+Status SaveList_DC(DCLinklist L, FILE *fp)
+{
+    if (WriteListHeader(fp, (size_t)ListLength_DC(L)) != OK)
+    {
+        return ERROR;
+    }
+
+    return WriteListChain(fp, L->next, L, offsetof(DCNode, next));
+}
+
+Status LoadList_DC(DCLinklist *L, FILE *fp)
+{
+    size_t n;
+
+    if (ReadListHeader(fp, &n) != OK || n > INT_MAX)
+    {
+        return ERROR;
+    }
+
+    InitList_DC(L);
+    DCNode *s = n > 0 ? NodePoolAllocArray(ListHeadPool(*L), n) : NULL;
+
+    /* 数据域在结点开头, 按结点大小跨步读入. */
+    if (ReadListData(fp, s, n, sizeof(DCNode)) != OK)
+    {
+        DestroyList_DC(L);
+        return ERROR;
+    }
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        s[k].prior = k > 0 ? &s[k - 1] : *L;
+        s[k].next = k + 1 < n ? &s[k + 1] : *L;
+    }
+    if (n > 0)
+    {
+        (*L)->next = s;
+        (*L)->prior = &s[n - 1];
+    }
+
+    return OK;
+}
+
 DCNode *GetElem_DC(DCLinklist L, int i)
 {
     if (i < 0 || i > ListLength_DC(L))
@@ -118,7 +199,7 @@ Status ListInsert_DC(DCLinklist L, int i, ElemType e)
     DCNode *p = GetElem_DC(L, i - 1);
 
     /* 这是要插入的结点. */
-    DCNode *s = malloc(sizeof(DCNode));
+    DCNode *s = NodePoolAlloc(ListHeadPool(L));
     s->data = e;
 
     /* 1. 新结点指向后继结点. */
@@ -157,7 +238,16 @@ Status ListDelete_DC(DCLinklist L, int i)
     q->next->prior = p;
 
     /* 删除结点 q. */
-    free(q);
+    NodePoolFree(ListHeadPool(L), q);
+
+    return OK;
+}
+
+Status DestroyList_DC(DCLinklist *L)
+{
+    /* 结点都在结点池中, 释放头结点时一并释放, 不必绕环逐个 free(). */
+    FreeListHead(*L);
+    (*L) = NULL;
 
     return OK;
 }
@@ -199,6 +289,21 @@ void PrintList_DC(DCLinklist L)
     return;
 }
 
+void Sort_DC(DCLinklist L, ListSortMode mode)
+{
+    L->next = SortChain(L->next, L, offsetof(DCNode, next), mode);
+
+    /* 归并后前驱指针失效, 沿后继重建一圈, 最后一步修正头结点的前驱. */
+    DCNode *p = L;
+    do
+    {
+        p->next->prior = p;
+        p = p->next;
+    } while (p != L);
+
+    return;
+}
+
 Status Symmetry(DCLinklist L)
 {
     /* 工作指针, p 指向第一个结点, q 指向为最后一个结点. */
@@ -9,20 +9,17 @@
  * 
  */
 
+#include <limits.h>
+
 #include <linearlist/linklist/dlinklist.h>
 
 Status InitList_D(DLinklist *L)
 {
-    /* 为头结点分配内存空间. */
-    *L = malloc(sizeof(DNode));
-    /* 内存分配失败. */
-    if (!(*L))
-    {
-        exit(OVERFLOW);
-    }
+    /* 为头结点分配内存空间, 同时为链表创建结点池. */
+    *L = NewListHead(sizeof(DNode));
 
     /* 为了保证可是使用头插法建立链表, 还要加入尾结点. */
-    DNode *rear = malloc(sizeof(DNode));
+    DNode *rear = NodePoolAlloc(ListHeadPool(*L));
     rear->data = -1; /* 尾结点标记. */
     rear->freq = -1;
     rear->prior = (*L);
@@ -39,7 +36,7 @@ Status InitList_D(DLinklist *L)
 Status HeadInsert_D(DLinklist L, ElemType e)
 {
     /* 创建新结点. */
-    DNode *newNode = malloc(sizeof(DNode));
+    DNode *newNode = NodePoolAlloc(ListHeadPool(L));
 
     /* 为新结点赋值. */
     newNode->data = e;
@@ -72,7 +69,7 @@ Status TailInsert_D(DLinklist L, ElemType e)
     }
 
     /* 这是新结点. */
-    DNode *newNode = malloc(sizeof(DNode));
+    DNode *newNode = NodePoolAlloc(ListHeadPool(L));
     newNode->data = e;
     newNode->freq = 0;
 
@@ -93,6 +90,110 @@ Status TailInsert_D(DLinklist L, ElemType e)
     return OK;
 }
 
+Status CreateList_D(DLinklist *L, const ElemType *a, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    InitList_D(L);
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    DNode *s = NodePoolAllocArray(ListHeadPool(*L), (size_t)n);
+    DNode *rear = (*L)->next;
+
+    for (int k = 0; k < n; ++k)
+    {
+        s[k].data = a[k];
+        s[k].freq = 0;
+        s[k].prior = k > 0 ? &s[k - 1] : *L;
+        s[k].next = k < n - 1 ? &s[k + 1] : rear;
+    }
+
+    /* 结点放在头结点与尾结点之间. */
+    (*L)->next = s;
+    rear->prior = &s[n - 1];
+
+    return OK;
+}
+
+int ListToArray_D(DLinklist L, ElemType *a, int max)
+{
+    int k = 0;
+
+    /* 尾结点的后继为空, 它本身不存数据. */
+    for (DNode *p = L->next; p->next != NULL && k < max; p = p->next)
+    {
+        if (p->next->next != NULL)
+        {
+            PREFETCH_NODE(p->next->next);
+        }
+        a[k++] = p->data;
+    }
+
+    return k;
+}
+
+Status SaveList_D(DLinklist L, FILE *fp)
+{
+    /* 数一遍元素, 同时找到尾结点, 它是写出的终点. */
+    size_t n = 0;
+    DNode *rear = L->next;
+
+    for (; rear->next != NULL; rear = rear->next)
+    {
+        ++n;
+    }
+
+    if (WriteListHeader(fp, n) != OK)
+    {
+        return ERROR;
+    }
+
+    return WriteListChain(fp, L->next, rear, offsetof(DNode, next));
+}
+
+Status LoadList_D(DLinklist *L, FILE *fp)
+{
+    size_t n;
+
+    if (ReadListHeader(fp, &n) != OK || n > INT_MAX)
+    {
+        return ERROR;
+    }
+
+    InitList_D(L);
+    DNode *s = n > 0 ? NodePoolAllocArray(ListHeadPool(*L), n) : NULL;
+
+    /* 数据域在结点开头, 按结点大小跨步读入. */
+    if (ReadListData(fp, s, n, sizeof(DNode)) != OK)
+    {
+        DestroyList_D(L);
+        return ERROR;
+    }
+
+    DNode *rear = (*L)->next;
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        s[k].freq = 0;
+        s[k].prior = k > 0 ? &s[k - 1] : *L;
+        s[k].next = k + 1 < n ? &s[k + 1] : rear;
+    }
+    if (n > 0)
+    {
+        /* 结点放在头结点与尾结点之间. */
+        (*L)->next = s;
+        rear->prior = &s[n - 1];
+    }
+
+    return OK;
+}
+
 DNode *GetElem_D(DLinklist L, int i)
 {
     if (i < 0 || i > ListLength_D(L))
@@ -216,7 +317,7 @@ Status ListInsert_D(DLinklist *L, int i, ElemType e)
     DNode *p = GetElem_D(*L, i - 1);
 
     /* 这是要插入的结点. */
-    DNode *s = malloc(sizeof(DNode));
+    DNode *s = NodePoolAlloc(ListHeadPool(*L));
     s->data = e;
     s->freq = 0;
 
@@ -256,7 +357,16 @@ Status ListDelete_D(DLinklist *L, int i)
     q->next->prior = p;
 
     /* 删除结点 q. */
-    free(q);
+    NodePoolFree(ListHeadPool(*L), q);
+
+    return OK;
+}
+
+Status DestroyList_D(DLinklist *L)
+{
+    /* 尾结点和数据结点都在结点池中, 随头结点一并释放. */
+    FreeListHead(*L);
+    (*L) = NULL;
 
     return OK;
 }
@@ -299,3 +409,25 @@ void PrintList_D(DLinklist L)
 
     return;
 }
+
+void Sort_D(DLinklist L, ListSortMode mode)
+{
+    (void)mode;
+
+    /* 找到尾结点, 只排头尾结点之间的一段. */
+    DNode *rear = L->next;
+    while (rear->next != NULL)
+    {
+        rear = rear->next;
+    }
+
+    L->next = SortChain(L->next, rear, offsetof(DNode, next), LIST_SORT_MERGE);
+
+    /* 按新的顺序重建前驱指针, 包括尾结点的. */
+    for (DNode *p = L; p->next != NULL; p = p->next)
+    {
+        p->next->prior = p;
+    }
+
+    return;
+}
@@ -0,0 +1,431 @@
+﻿/**
+ * @file lflinklist.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 无锁有序单向链表方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <linearlist/linklist/lflinklist.h>
+
+/* 删除标记. */
+#define MARK ((uintptr_t)1)
+#define IS_MARKED(p) ((p) & MARK)
+#define NODE(p) ((LFNode *)((p) & ~MARK))
+
+static void CacheNode(LFThread *T, LFNode *p)
+{
+    if (T->cacheCount < LF_NODE_CACHE)
+    {
+        atomic_store_explicit(&p->next, (uintptr_t)T->cache,
+                              memory_order_relaxed);
+        T->cache = p;
+        ++T->cacheCount;
+    }
+    else
+    {
+        free(p);
+    }
+}
+
+static void FreeBag(LFThread *T, int i)
+{
+    for (int k = 0; k < T->retiredLength[i]; ++k)
+    {
+        CacheNode(T, T->retired[i][k]);
+    }
+
+    T->retiredLength[i] = 0;
+}
+
+/**
+ * @brief 所有处于临界区的线程都已看到当前纪元时, 把全局纪元加一.
+ */
+static void TryAdvance(LFList *L)
+{
+    uint64_t e = atomic_load(&L->epoch);
+
+    for (LFThread *t = atomic_load(&L->threads); t; t = t->next)
+    {
+        uint64_t s = atomic_load(&t->state);
+
+        if ((s & 1) && (s >> 1) != e)
+        {
+            return;
+        }
+    }
+
+    atomic_compare_exchange_strong(&L->epoch, &e, e + 1);
+}
+
+/**
+ * @brief 进入临界区, 并回收已经安全的袋子. 线程在纪元 l 退休结点时, 全局纪元
+ * 可能已是 l + 1, 仍在遍历该结点的线程纪元不超过 l + 1; 全局纪元到达 l + 3
+ * 时它们必定都已离开. 袋子 x % 3 在线程看到纪元 x 时装的是纪元 x - 3 的结点.
+ */
+static void Enter(LFList *L, LFThread *T)
+{
+    uint64_t g = atomic_load(&L->epoch);
+
+    /* 先公布再复核, 保证 TryAdvance() 看到的纪元不会落后. */
+    atomic_store(&T->state, g << 1 | 1);
+    uint64_t h = atomic_load(&L->epoch);
+    if (h != g)
+    {
+        g = h;
+        atomic_store(&T->state, g << 1 | 1);
+    }
+
+    for (uint64_t x = T->epoch + 1; x <= g && x <= T->epoch + 3; ++x)
+    {
+        FreeBag(T, (int)(x % 3));
+    }
+
+    T->epoch = g;
+}
+
+static void Leave(LFThread *T)
+{
+    atomic_store_explicit(&T->state, 0, memory_order_release);
+}
+
+static void Retire(LFList *L, LFThread *T, LFNode *p)
+{
+    int i = (int)(T->epoch % 3);
+
+    if (T->retiredLength[i] == T->retiredSize[i])
+    {
+        int size = T->retiredSize[i] ? 2 * T->retiredSize[i] : LF_RETIRE_BATCH;
+        LFNode **bag = realloc(T->retired[i], sizeof(LFNode *) * size);
+        /* 内存分配失败. */
+        if (!bag)
+        {
+            exit(OVERFLOW);
+        }
+
+        T->retired[i] = bag;
+        T->retiredSize[i] = size;
+    }
+
+    T->retired[i][T->retiredLength[i]++] = p;
+
+    if (++T->retiredCount % LF_RETIRE_BATCH == 0)
+    {
+        TryAdvance(L);
+    }
+}
+
+static LFNode *NewNode(LFThread *T, ElemType e)
+{
+    LFNode *s = T->cache;
+
+    if (s)
+    {
+        T->cache = NODE(atomic_load_explicit(&s->next, memory_order_relaxed));
+        --T->cacheCount;
+    }
+    else
+    {
+        s = malloc(sizeof(LFNode));
+        /* 内存分配失败. */
+        if (!s)
+        {
+            exit(OVERFLOW);
+        }
+    }
+
+    s->data = e;
+
+    return s;
+}
+
+/**
+ * @brief 找到第一个不小于 e 的未删除结点 curr 及指向它的前驱指针域 prev,
+ * 途中摘除带删除标记的结点. 前驱在此期间被删除时 CAS 失败, 从头重找.
+ * @return e 存在时返回 TRUE.
+ */
+static Status Find(LFList *L, LFThread *T, ElemType e,
+                   _Atomic(uintptr_t) **prev, LFNode **curr)
+{
+retry:
+    *prev = &L->head.next;
+    *curr = NODE(atomic_load_explicit(*prev, memory_order_acquire));
+
+    while (*curr)
+    {
+        uintptr_t next =
+            atomic_load_explicit(&(*curr)->next, memory_order_acquire);
+
+        if (IS_MARKED(next))
+        {
+            uintptr_t expected = (uintptr_t)*curr;
+
+            if (!atomic_compare_exchange_strong_explicit(
+                    *prev, &expected, next & ~MARK, memory_order_acq_rel,
+                    memory_order_acquire))
+            {
+                goto retry;
+            }
+
+            Retire(L, T, *curr);
+            *curr = NODE(next);
+            continue;
+        }
+
+        if ((*curr)->data >= e)
+        {
+            return (*curr)->data == e;
+        }
+
+        *prev = &(*curr)->next;
+        *curr = NODE(next);
+    }
+
+    return FALSE;
+}
+
+Status InitList_LF(LFList *L)
+{
+    L->head.data = 0;
+    atomic_init(&L->head.next, (uintptr_t)0);
+    atomic_init(&L->epoch, (uint64_t)2);
+    atomic_init(&L->threads, NULL);
+
+    return OK;
+}
+
+Status DestroyList_LF(LFList *L)
+{
+    LFNode *p = NODE(atomic_load(&L->head.next));
+
+    while (p)
+    {
+        LFNode *q = NODE(atomic_load(&p->next));
+        free(p);
+        p = q;
+    }
+    atomic_store(&L->head.next, (uintptr_t)0);
+
+    LFThread *t = atomic_load(&L->threads);
+    while (t)
+    {
+        LFThread *u = t->next;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int k = 0; k < t->retiredLength[i]; ++k)
+            {
+                free(t->retired[i][k]);
+            }
+            free(t->retired[i]);
+        }
+        for (LFNode *r = t->cache; r;)
+        {
+            LFNode *q = NODE(atomic_load(&r->next));
+            free(r);
+            r = q;
+        }
+
+        free(t);
+        t = u;
+    }
+    atomic_store(&L->threads, NULL);
+
+    return OK;
+}
+
+LFThread *RegisterThread_LF(LFList *L)
+{
+    /* 复用已注销的记录. */
+    for (LFThread *t = atomic_load(&L->threads); t; t = t->next)
+    {
+        int expected = 0;
+
+        if (atomic_compare_exchange_strong(&t->inUse, &expected, 1))
+        {
+            return t;
+        }
+    }
+
+    LFThread *t = malloc(sizeof(LFThread));
+    /* 内存分配失败. */
+    if (!t)
+    {
+        exit(OVERFLOW);
+    }
+
+    atomic_init(&t->state, (uint64_t)0);
+    atomic_init(&t->inUse, 1);
+    t->epoch = atomic_load(&L->epoch);
+    for (int i = 0; i < 3; ++i)
+    {
+        t->retired[i] = NULL;
+        t->retiredLength[i] = t->retiredSize[i] = 0;
+    }
+    t->retiredCount = 0;
+    t->cache = NULL;
+    t->cacheCount = 0;
+
+    /* 压入记录链表头部. */
+    LFThread *head = atomic_load(&L->threads);
+    do
+    {
+        t->next = head;
+    } while (!atomic_compare_exchange_weak(&L->threads, &head, t));
+
+    return t;
+}
+
+void UnregisterThread_LF(LFList *L, LFThread *T)
+{
+    (void)L;
+
+    atomic_store(&T->state, 0);
+    atomic_store(&T->inUse, 0);
+}
+
+Status Insert_LF(LFList *L, LFThread *T, ElemType e)
+{
+    _Atomic(uintptr_t) *prev;
+    LFNode *curr, *s = NULL;
+    Status found;
+
+    Enter(L, T);
+
+    for (;;)
+    {
+        found = Find(L, T, e, &prev, &curr);
+        if (found)
+        {
+            break;
+        }
+
+        if (!s)
+        {
+            s = NewNode(T, e);
+        }
+        atomic_store_explicit(&s->next, (uintptr_t)curr, memory_order_relaxed);
+
+        uintptr_t expected = (uintptr_t)curr;
+        if (atomic_compare_exchange_strong_explicit(
+                prev, &expected, (uintptr_t)s, memory_order_release,
+                memory_order_relaxed))
+        {
+            s = NULL;
+            break;
+        }
+    }
+
+    /* 元素已存在, 新结点从未发布, 直接放回缓存. */
+    if (s)
+    {
+        CacheNode(T, s);
+    }
+
+    Leave(T);
+
+    return found ? ERROR : OK;
+}
+
+Status Delete_LF(LFList *L, LFThread *T, ElemType e)
+{
+    _Atomic(uintptr_t) *prev;
+    LFNode *curr;
+    Status found;
+
+    Enter(L, T);
+
+    for (;;)
+    {
+        found = Find(L, T, e, &prev, &curr);
+        if (!found)
+        {
+            break;
+        }
+
+        /* 逻辑删除: 在 curr 的 next 上置标记. 标记已被别的线程置上时, 由
+         * 重新查找摘除它并返回不存在. */
+        uintptr_t next =
+            atomic_load_explicit(&curr->next, memory_order_acquire);
+        if (IS_MARKED(next) ||
+            !atomic_compare_exchange_strong_explicit(
+                &curr->next, &next, next | MARK, memory_order_acq_rel,
+                memory_order_relaxed))
+        {
+            continue;
+        }
+
+        /* 物理删除. 失败说明前驱变了, 交给一次查找去摘除. */
+        uintptr_t expected = (uintptr_t)curr;
+        if (atomic_compare_exchange_strong_explicit(
+                prev, &expected, next, memory_order_acq_rel,
+                memory_order_relaxed))
+        {
+            Retire(L, T, curr);
+        }
+        else
+        {
+            Find(L, T, e, &prev, &curr);
+        }
+
+        break;
+    }
+
+    Leave(T);
+
+    return found ? OK : ERROR;
+}
+
+Status Contains_LF(LFList *L, LFThread *T, ElemType e)
+{
+    Enter(L, T);
+
+    LFNode *p = NODE(atomic_load_explicit(&L->head.next, memory_order_acquire));
+    uintptr_t next = 0;
+
+    while (p)
+    {
+        next = atomic_load_explicit(&p->next, memory_order_acquire);
+        if (p->data >= e)
+        {
+            break;
+        }
+        p = NODE(next);
+    }
+
+    Status found = p && p->data == e && !IS_MARKED(next);
+
+    Leave(T);
+
+    return found ? TRUE : FALSE;
+}
+
+int ListLength_LF(LFList *L)
+{
+    int length = 0;
+
+    for (uintptr_t p = atomic_load(&L->head.next); NODE(p);
+         p = atomic_load(&NODE(p)->next))
+    {
+        length += !IS_MARKED(atomic_load(&NODE(p)->next));
+    }
+
+    return length;
+}
+
+void PrintList_LF(LFList *L)
+{
+    for (uintptr_t p = atomic_load(&L->head.next); NODE(p);
+         p = atomic_load(&NODE(p)->next))
+    {
+        if (!IS_MARKED(atomic_load(&NODE(p)->next)))
+        {
+            printf("%d ", NODE(p)->data);
+        }
+    }
+
+    printf("\n");
+}
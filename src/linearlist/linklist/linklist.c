@@ -9,7 +9,11 @@
  * 
  */
 
+#include <limits.h>
+
 #include <linearlist/linklist/linklist.h>
+#include <linearlist/sqlist/sqsearch.h>
+#include <linearlist/sqlist/sqset.h>
 
 Status InitList_L(Linklist *L)
 {
@@ -23,13 +27,8 @@ Status InitList_L(Linklist *L)
      *      https://blog.csdn.net/bestone0213/article/details/40829203
      **/
 
-    /* 为头结点分配内存空间. */
-    (*L) = malloc(sizeof(LNode));
-    /* 内存分配失败. */
-    if (!(*L))
-    {
-        exit(OVERFLOW);
-    }
+    /* 为头结点分配内存空间, 同时为链表创建结点池. */
+    (*L) = NewListHead(sizeof(LNode));
 
     /* 为头结点赋值. */
     (*L)->data = 0;
@@ -41,7 +40,7 @@ Status InitList_L(Linklist *L)
 Status HeadInsert_L(Linklist L, ElemType e)
 {
     /* 创建新结点. */
-    LNode *s = malloc(sizeof(LNode));
+    LNode *s = NodePoolAlloc(ListHeadPool(L));
 
     /* 为新结点赋值. */
     s->data = e;
@@ -58,7 +57,7 @@ Status HeadInsert_L(Linklist L, ElemType e)
 Status TailInsert_L(Linklist L, ElemType e)
 {
     /* 这是新结点. */
-    LNode *s = malloc(sizeof(LNode));
+    LNode *s = NodePoolAlloc(ListHeadPool(L));
     s->data = e;
     s->next = NULL;
 
@@ -88,6 +87,94 @@ Status TailInsert_L(Linklist L, ElemType e)
     return OK;
 }
 
+Status CreateList_L(Linklist *L, const ElemType *a, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    InitList_L(L);
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    LNode *s = NodePoolAllocArray(ListHeadPool(*L), (size_t)n);
+
+    /* 第 k 个结点的后继就是数组中的下一个结点. */
+    for (int k = 0; k < n - 1; ++k)
+    {
+        s[k].data = a[k];
+        s[k].next = &s[k + 1];
+    }
+    s[n - 1].data = a[n - 1];
+    s[n - 1].next = NULL;
+
+    (*L)->next = s;
+
+    return OK;
+}
+
+int ListToArray_L(Linklist L, ElemType *a, int max)
+{
+    int k = 0;
+
+    for (LNode *p = L->next; p != NULL && k < max; p = p->next)
+    {
+        /* 读当前结点时, 下下个结点的访存已经发出. */
+        if (p->next != NULL)
+        {
+            PREFETCH_NODE(p->next->next);
+        }
+        a[k++] = p->data;
+    }
+
+    return k;
+}
+
+Status SaveList_L(Linklist L, FILE *fp)
+{
+    if (WriteListHeader(fp, (size_t)ListLength_L(L)) != OK)
+    {
+        return ERROR;
+    }
+
+    return WriteListChain(fp, L->next, NULL, offsetof(LNode, next));
+}
+
+Status LoadList_L(Linklist *L, FILE *fp)
+{
+    size_t n;
+
+    if (ReadListHeader(fp, &n) != OK || n > INT_MAX)
+    {
+        return ERROR;
+    }
+
+    InitList_L(L);
+    LNode *s = n > 0 ? NodePoolAllocArray(ListHeadPool(*L), n) : NULL;
+
+    /* 数据域在结点开头, 按结点大小跨步读入. */
+    if (ReadListData(fp, s, n, sizeof(LNode)) != OK)
+    {
+        DestroyList_L(L);
+        return ERROR;
+    }
+
+    for (size_t k = 0; k + 1 < n; ++k)
+    {
+        s[k].next = &s[k + 1];
+    }
+    if (n > 0)
+    {
+        s[n - 1].next = NULL;
+        (*L)->next = s;
+    }
+
+    return OK;
+}
+
 LNode *GetElem_L(Linklist L, int i)
 {
     if (i < 0 || i > ListLength_L(L))
@@ -139,7 +226,7 @@ Status ListInsert_L(Linklist L, int i, ElemType e)
     LNode *p = GetElem_L(L, i - 1);
 
     /* 这是要插入的结点. */
-    LNode *s = malloc(sizeof(LNode));
+    LNode *s = NodePoolAlloc(ListHeadPool(L));
     s->data = e;
 
     /* 1. 新结点指向后继结点. */
@@ -169,7 +256,16 @@ Status ListDelete_L(Linklist L, int i)
     p->next = q->next;
 
     /* 删除结点 q. */
-    free(q);
+    NodePoolFree(ListHeadPool(L), q);
+
+    return OK;
+}
+
+Status DestroyList_L(Linklist *L)
+{
+    /* 结点都在结点池中, 释放头结点时一并释放, 不必逐个 free(). */
+    FreeListHead(*L);
+    (*L) = NULL;
 
     return OK;
 }
@@ -305,46 +401,14 @@ void Reverse_L2(Linklist L)
 
 void Sort(Linklist L)
 {
-    /* pre 指向已经构造好的有序递增链表的尾结点. */
-    LNode *p = L->next, *pre;
-    /*  r 用以保存 *p 的后继结点指针. */
-    LNode *r = p->next;
-
-    /* 断开第一个结点的后继, 相当于先构造只有一个结点的有序表. */
-    p->next = NULL;
-
-    /**
-     * 这时候之前保存的 r = p->next 就有用了. 指向后继结点, 第二个结点,
-     * 即断开第一个结点的后继后得到的无序表的第一个结点.
-     */
-    p = r;
-
-    /* p 不为空, 即链表至少有两个结点需要排序. */
-    while (p != NULL)
-    {
-        /* 先保存下来, 后面将 p 插入到有序表时会修改 p->next. */
-        r = p->next;
-
-        /* pre 指向链表头结点. */
-        pre = L;
-
-        /**
-         * pre 在有序表中遍历, 找到合适的位置.
-         * 要么是 pre->next = NULL 的有序表尾结点, 要么是 pre->data < p->data &&
-         * pre->next->data >= p->data 的合适的位置.
-         */
-        while (pre->next != NULL && pre->next->data < p->data)
-        {
-            pre = pre->next;
-        }
+    Sort_L(L, LIST_SORT_AUTO);
 
-        /* 将 p 插入到 pre 后. */
-        p->next = pre->next;
-        pre->next = p;
+    return;
+}
 
-        /* 下一个结点. */
-        p = r;
-    }
+void Sort_L(Linklist L, ListSortMode mode)
+{
+    L->next = SortChain(L->next, NULL, offsetof(LNode, next), mode);
 
     return;
 }
@@ -364,7 +428,7 @@ Status RangeDelete(Linklist L, ElemType min, ElemType max)
             pre->next = p->next;
 
             /* 释放 p 所指的内存空间. */
-            free(p);
+            NodePoolFree(ListHeadPool(L), p);
 
             /* 使 p 指向新的结点. */
             p = pre->next;
@@ -384,7 +448,7 @@ Status RangeDelete(Linklist L, ElemType min, ElemType max)
 Linklist Split(Linklist A)
 {
     /* 初始化单向链表 B. */
-    Linklist B = malloc(sizeof(LNode));
+    Linklist B = ShareListHead(A);
     B->next = NULL;
 
     /**
@@ -438,7 +502,7 @@ Linklist Split(Linklist A)
 Linklist Split2(Linklist A)
 {
     /* 初始化单向链表 B. */
-    Linklist B = malloc(sizeof(LNode));
+    Linklist B = ShareListHead(A);
     B->next = NULL;
 
     /* 指向原表 A 尾结点的指针. */
@@ -504,7 +568,7 @@ Status DeleteRepeat(Linklist L)
             /* 结点 p 的指针跳过结点 q. */
             p->next = q->next;
             /* 释放分配给结点 q 的内存空间. */
-            free(q);
+            NodePoolFree(ListHeadPool(L), q);
         }
         /* 数据不重复. */
         else
@@ -578,8 +642,9 @@ Linklist MergeList(Linklist A, Linklist B)
         pB = r;
     }
 
-    /* 释放链表 B 的头结点, B 被销毁. */
-    free(B);
+    /* B 的结点已转入 A, 两个结点池随之合并; 释放链表 B 的头结点, B 被销毁. */
+    MergeNodePool(ListHeadPool(A), ListHeadPool(B));
+    FreeListHead(B);
 
     return A;
 }
@@ -587,7 +652,7 @@ Linklist MergeList(Linklist A, Linklist B)
 Linklist GetCommon(Linklist A, Linklist B)
 {
     /* 初始化新单向链表 C. */
-    Linklist C = malloc(sizeof(LNode));
+    Linklist C = NewListHead(sizeof(LNode));
     C->data = -1;
     C->next = NULL;
 
@@ -611,7 +676,7 @@ Linklist GetCommon(Linklist A, Linklist B)
         else
         {
             /* 找到了公共结点, 准备一个新结点. */
-            LNode *s = malloc(sizeof(LNode));
+            LNode *s = NodePoolAlloc(ListHeadPool(C));
             s->data = pA->data;
             s->next = NULL;
 
@@ -651,13 +716,13 @@ void Union(Linklist A, Linklist B)
             pA = pA->next;
 
             /* 回收先前的结点. */
-            free(r);
+            NodePoolFree(ListHeadPool(A), r);
         }
         else if (pA->data > pB->data)
         {
             r = pB;
             pB = pB->next;
-            free(r);
+            NodePoolFree(ListHeadPool(B), r);
         }
         else
         {
@@ -676,7 +741,7 @@ void Union(Linklist A, Linklist B)
             pB = pB->next;
 
             /* 释放不属于交集的结点. */
-            free(r);
+            NodePoolFree(ListHeadPool(B), r);
         }
     }
 
@@ -685,61 +750,139 @@ void Union(Linklist A, Linklist B)
     {
         r = pA;
         pA = pA->next;
-        free(r);
-    }
-    while (pB)
-    {
-        r = pB;
-        pB = pB->next;
-        free(r);
+        NodePoolFree(ListHeadPool(A), r);
     }
 
+    /* B 的剩余结点随其结点池一并释放. */
+
     /* 注意新链表尾结点. 也可以在链接时处理处理后继, 但比较麻烦, 这里一句就行. */
     rA->next = NULL;
 
-    /* 释放 B 头结点. */
-    free(B);
+    /* 释放 B 头结点和结点池. */
+    FreeListHead(B);
 
     return;
 }
 
+/**
+ * @brief 把单向链表的元素复制到新分配的数组.
+ * @param n 用以返回元素个数.
+ */
+static ElemType *ListToArray(Linklist L, int *n)
+{
+    int length = ListLength_L(L);
+    ElemType *a = malloc(sizeof(ElemType) * ((size_t)length + 1));
+    /* 内存分配失败. */
+    if (!a)
+    {
+        exit(OVERFLOW);
+    }
+
+    *n = ListToArray_L(L, a, length);
+
+    return a;
+}
+
+/* 0 为交集, 1 为并集, 2 为差集. */
+static Linklist SetOperation(Linklist A, Linklist B, int op)
+{
+    int m, n;
+    ElemType *a = ListToArray(A, &m);
+    ElemType *b = ListToArray(B, &n);
+    ElemType *c = malloc(sizeof(ElemType) * ((size_t)m + n + 1));
+    /* 内存分配失败. */
+    if (!c)
+    {
+        exit(OVERFLOW);
+    }
+
+    int k = op == 0   ? IntersectArray(a, m, b, n, c)
+            : op == 1 ? UnionArray(a, m, b, n, c)
+                      : DifferenceArray(a, m, b, n, c);
+    Linklist C;
+    CreateList_L(&C, c, k);
+
+    free(a);
+    free(b);
+    free(c);
+
+    return C;
+}
+
+Linklist Intersect_L(Linklist A, Linklist B)
+{
+    return SetOperation(A, B, 0);
+}
+
+Linklist Union_L(Linklist A, Linklist B)
+{
+    return SetOperation(A, B, 1);
+}
+
+Linklist Difference_L(Linklist A, Linklist B)
+{
+    return SetOperation(A, B, 2);
+}
+
+/* 以链表 B 为模式构造匹配器. B 为空时返回 FALSE. */
+static Status ListMatcher(Linklist B, SeqMatcher *M)
+{
+    int m;
+    ElemType *b = ListToArray(B, &m);
+    Status s = m > 0 ? InitMatcher(M, b, m) == OK : FALSE;
+
+    free(b);
+
+    return s;
+}
+
 Status Pattern(Linklist A, Linklist B)
 {
-    /* 工作指针. */
-    LNode *pA = A->next, *pB = B->next;
-    /* 记录 A 表的比较起点. 从 A 的第一个结点匹配 B. */
-    LNode *start = pA;
+    SeqMatcher M;
 
-    while (pA && pB)
+    /* 空序列是任何序列的子序列. */
+    if (!ListMatcher(B, &M))
     {
-        /* 匹配, pA 和 pB 共同前进一. */
-        if (pB->data == pA->data)
-        {
-            pA = pA->next;
-            pB = pB->next;
-        }
-        /* 否则证明至少 A[i] 不是 B 开头, 下一次从 A[i+1] 开始匹配. */
-        else
-        {
-            /* 更新 A 的比较起点. 从下一个结点开始匹配 B. */
-            start = start->next;
-            /* 更新工作指针. */
-            pA = start;
+        return TRUE;
+    }
 
-            /* 重置 B 的比较起点. */
-            pB = B->next;
-        }
+    /* A 逐个结点推入匹配器, 不需要回退, 找到第一个匹配即停. */
+    Status found = FALSE;
+    for (LNode *p = A->next; p && !found; p = p->next)
+    {
+        found = MatcherPush(&M, p->data);
     }
 
-    /* 若 B 是 A 的连续子序列, 则比较完后 pB 应为 NULL. */
-    if (pB)
+    DestroyMatcher(&M);
+
+    return found;
+}
+
+int PatternAll(Linklist A, Linklist B, int *pos, int max)
+{
+    SeqMatcher M;
+
+    if (!ListMatcher(B, &M))
     {
-        return FALSE;
+        return 0;
     }
-    else
+
+    int count = 0, i = 1;
+    for (LNode *p = A->next; p; p = p->next, ++i)
     {
-        return TRUE;
+        if (MatcherPush(&M, p->data))
+        {
+            if (pos && count < max)
+            {
+                pos[count] = i - M.length + 1;
+            }
+            ++count;
+        }
     }
+
+    DestroyMatcher(&M);
+
+    return count;
 }
 
 Status SearchK(Linklist L, int k)
@@ -0,0 +1,371 @@
+﻿/**
+ * @file listsort.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 链表排序方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <linearlist/linklist/listsort.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 元素数不少于此值时 SortValues() 使用基数排序. */
+#define RADIX_SORT_MIN 1024
+/* 内省排序中改用插入排序的段长. */
+#define INSERTION_SORT_MAX 16
+
+/* 结点 p 的后继和数据域. 各种结点的数据域都在偏移 0 处. */
+#define NEXT(p) (*(void **)((char *)(p) + off))
+#define KEY(p) (*(const ElemType *)(p))
+
+static void InsertionSort(ElemType *a, int n)
+{
+    for (int i = 1; i < n; ++i)
+    {
+        ElemType e = a[i];
+        int j = i;
+
+        while (j > 0 && a[j - 1] > e)
+        {
+            a[j] = a[j - 1];
+            --j;
+        }
+        a[j] = e;
+    }
+}
+
+static void SiftDown(ElemType *a, int i, int n)
+{
+    ElemType e = a[i];
+
+    for (int c = 2 * i + 1; c < n; c = 2 * i + 1)
+    {
+        if (c + 1 < n && a[c + 1] > a[c])
+        {
+            ++c;
+        }
+        if (a[c] <= e)
+        {
+            break;
+        }
+        a[i] = a[c];
+        i = c;
+    }
+    a[i] = e;
+}
+
+static void HeapSort(ElemType *a, int n)
+{
+    for (int i = n / 2 - 1; i >= 0; --i)
+    {
+        SiftDown(a, i, n);
+    }
+
+    for (int i = n - 1; i > 0; --i)
+    {
+        ElemType e = a[0];
+        a[0] = a[i];
+        a[i] = e;
+        SiftDown(a, 0, i);
+    }
+}
+
+/* 快速排序, 先递归较短的一段, 深度用完时改用堆排序. */
+static void IntroSort(ElemType *a, int n, int depth)
+{
+    while (n > INSERTION_SORT_MAX)
+    {
+        if (depth-- == 0)
+        {
+            HeapSort(a, n);
+            return;
+        }
+
+        /* 三数取中, 排好后 a[0] <= a[mid] <= a[n - 1], 两端充当哨兵. */
+        int mid = n / 2;
+        ElemType t;
+        if (a[mid] < a[0])
+        {
+            t = a[mid], a[mid] = a[0], a[0] = t;
+        }
+        if (a[n - 1] < a[mid])
+        {
+            t = a[n - 1], a[n - 1] = a[mid], a[mid] = t;
+            if (a[mid] < a[0])
+            {
+                t = a[mid], a[mid] = a[0], a[0] = t;
+            }
+        }
+
+        /* Hoare 划分, 与枢轴相等的元素分散到两边, 大量重复时也不退化. */
+        ElemType pivot = a[mid];
+        int i = -1, j = n;
+        for (;;)
+        {
+            while (a[++i] < pivot)
+                ;
+            while (a[--j] > pivot)
+                ;
+            if (i >= j)
+            {
+                break;
+            }
+            t = a[i], a[i] = a[j], a[j] = t;
+        }
+
+        /* [0, j] 与 [j + 1, n). */
+        int left = j + 1;
+        if (left < n - left)
+        {
+            IntroSort(a, left, depth);
+            a += left;
+            n -= left;
+        }
+        else
+        {
+            IntroSort(a + left, n - left, depth);
+            n = left;
+        }
+    }
+
+    InsertionSort(a, n);
+}
+
+/**
+ * @brief LSD 基数排序, 按 11, 11, 10 位分三趟. 符号位取反后按无符号数排序,
+ * 负数就排在前面. 一次遍历统计三趟的计数, 所有元素在某一趟上都相同时跳过该趟.
+ */
+static void RadixSort(ElemType *a, int n)
+{
+    static const int shift[3] = {0, 11, 22};
+    uint32_t count[3][2048] = {{0}};
+    uint32_t *src = (uint32_t *)a;
+    uint32_t *dst = malloc(sizeof(uint32_t) * (size_t)n);
+    /* 内存分配失败. */
+    if (!dst)
+    {
+        exit(OVERFLOW);
+    }
+    uint32_t *buffer = dst;
+
+    for (int i = 0; i < n; ++i)
+    {
+        uint32_t k = src[i] ^ 0x80000000u;
+        src[i] = k;
+        ++count[0][k & 0x7ff];
+        ++count[1][(k >> 11) & 0x7ff];
+        ++count[2][k >> 22];
+    }
+
+    for (int d = 0; d < 3; ++d)
+    {
+        uint32_t *c = count[d];
+        if (c[(src[0] >> shift[d]) & 0x7ff] == (uint32_t)n)
+        {
+            continue;
+        }
+
+        /* 计数转为各桶的起始位置. */
+        uint32_t sum = 0;
+        for (int b = 0; b < 2048; ++b)
+        {
+            uint32_t t = c[b];
+            c[b] = sum;
+            sum += t;
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            uint32_t k = src[i];
+            dst[c[(k >> shift[d]) & 0x7ff]++] = k;
+        }
+
+        uint32_t *t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != (uint32_t *)a)
+    {
+        memcpy(a, src, sizeof(uint32_t) * (size_t)n);
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        ((uint32_t *)a)[i] ^= 0x80000000u;
+    }
+
+    free(buffer);
+}
+
+void SortValues(ElemType *a, int n)
+{
+    if (n >= RADIX_SORT_MIN)
+    {
+        RadixSort(a, n);
+        return;
+    }
+
+    int depth = 0;
+    for (int m = n; m > 1; m >>= 1)
+    {
+        depth += 2;
+    }
+    IntroSort(a, n, depth);
+}
+
+/**
+ * @brief 归并以 NULL 结尾的两条有序链 a, b, 均不为空, a 中的结点原来在前,
+ * 相等时先取 a 以保持稳定. ta, tb 为两条链的尾结点, 由 tail 返回结果的尾结点,
+ * 这样整个排序都不必为找尾结点而遍历.
+ */
+static void *Merge(void *a, void *ta, void *b, void *tb, size_t off,
+                   void **tail)
+{
+    void *head, **p = &head;
+
+    for (;;)
+    {
+        if (KEY(b) < KEY(a))
+        {
+            *p = b;
+            p = &NEXT(b);
+            if (!(b = *p))
+            {
+                *p = a;
+                *tail = ta;
+                return head;
+            }
+        }
+        else
+        {
+            *p = a;
+            p = &NEXT(a);
+            if (!(a = *p))
+            {
+                *p = b;
+                *tail = tb;
+                return head;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 自底向上归并. 每次从输入中截下一段非递减的自然有序段, 像二进制计数
+ * 加一那样与 bin[0], bin[1], ... 中的链逐个归并并进位. bin[i] 中的链由
+ * 较早截下的结点组成, 所以总是作为归并的前一条链. 有序输入只截下一段,
+ * 时间为 O(n); 一般为 O(nlog(段数)).
+ */
+static void *MergeSortChain(void *first, void *end, size_t off)
+{
+    void *bin[64], *binTail[64];
+    int used = 0, i;
+    void *p = first, *q, *qt;
+
+    while (p != end)
+    {
+        /* 截下一段自然有序段 [q, qt]. */
+        q = qt = p;
+        while ((p = NEXT(qt)) != end && KEY(p) >= KEY(qt))
+        {
+            qt = p;
+        }
+        NEXT(qt) = NULL;
+
+        for (i = 0; i < used && bin[i]; ++i)
+        {
+            q = Merge(bin[i], binTail[i], q, qt, off, &qt);
+            bin[i] = NULL;
+        }
+        if (i == used)
+        {
+            ++used;
+        }
+        bin[i] = q;
+        binTail[i] = qt;
+    }
+
+    /* 低位的链由较晚的结点组成, 从低位向高位合并. */
+    q = NULL;
+    for (i = 0; i < used; ++i)
+    {
+        if (!bin[i])
+        {
+            continue;
+        }
+        if (q)
+        {
+            q = Merge(bin[i], binTail[i], q, qt, off, &qt);
+        }
+        else
+        {
+            q = bin[i];
+            qt = binTail[i];
+        }
+    }
+
+    if (!q)
+    {
+        return end;
+    }
+    NEXT(qt) = end;
+
+    return q;
+}
+
+/* 把 n 个数据收集到数组中排序, 再按链的顺序写回. */
+static void *ArraySortChain(void *first, void *end, size_t off, int n)
+{
+    ElemType *a = malloc(sizeof(ElemType) * (size_t)(n ? n : 1));
+    /* 内存分配失败. */
+    if (!a)
+    {
+        exit(OVERFLOW);
+    }
+
+    int k = 0;
+    for (void *p = first; p != end; p = NEXT(p))
+    {
+        a[k++] = KEY(p);
+    }
+
+    SortValues(a, n);
+
+    k = 0;
+    for (void *p = first; p != end; p = NEXT(p))
+    {
+        *(ElemType *)p = a[k++];
+    }
+
+    free(a);
+
+    return first;
+}
+
+void *SortChain(void *first, void *end, size_t nextOffset, ListSortMode mode)
+{
+    size_t off = nextOffset;
+
+    if (mode == LIST_SORT_MERGE)
+    {
+        return MergeSortChain(first, end, off);
+    }
+
+    int n = 0;
+    for (void *p = first; p != end; p = NEXT(p))
+    {
+        ++n;
+    }
+
+    if (mode == LIST_SORT_ARRAY || n >= LIST_SORT_ARRAY_MIN)
+    {
+        return ArraySortChain(first, end, off, n);
+    }
+
+    return MergeSortChain(first, end, off);
+}
@@ -0,0 +1,281 @@
+﻿/**
+ * @file nodepool.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 链表结点池实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <stdlib.h>
+
+#include <linearlist/linklist/nodepool.h>
+
+/* slab 块头, 其后紧跟结点. */
+struct NodeSlab
+{
+    struct NodeSlab *next;
+    /* 整块的字节数, 含块头. */
+    size_t bytes;
+    /* 保证结点按最严格的基本类型对齐. */
+    union
+    {
+        long long ll;
+        long double ld;
+        void *p;
+    } align[];
+};
+
+/* 头结点之前隐藏的池指针所占的字节数, 保持头结点的对齐. */
+#define HEAD_PREFIX sizeof(union { NodePool *pool; long long ll; long double ld; })
+
+/* 沿存根找到未被合并的结点池. 只有合并链表时才会产生存根, 链很短. */
+static NodePool *FindPool(NodePool *P)
+{
+    NodePool *root = P;
+
+    while (root->forward)
+    {
+        root = root->forward;
+    }
+
+    return root;
+}
+
+NodePool *CreateNodePool(size_t nodeSize)
+{
+    NodePool *P = malloc(sizeof(NodePool));
+    if (!P)
+    {
+        exit(OVERFLOW);
+    }
+
+    /* 空闲结点要能存下一个指针, 大小按指针对齐. */
+    if (nodeSize < sizeof(void *))
+    {
+        nodeSize = sizeof(void *);
+    }
+    nodeSize = (nodeSize + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+
+    P->forward = NULL;
+    P->refcount = 1;
+    P->nodeSize = nodeSize;
+    P->freeList = NULL;
+    P->cursor = P->limit = NULL;
+    P->slabs = NULL;
+    P->slabNodes = NODE_SLAB_MIN;
+
+    return P;
+}
+
+void RetainNodePool(NodePool *P)
+{
+    ++P->refcount;
+}
+
+void ReleaseNodePool(NodePool *P)
+{
+    while (P && --P->refcount == 0)
+    {
+        NodePool *forward = P->forward;
+
+        /* 存根没有 slab, 释放后再释放它对转发目标的引用. */
+        NodeSlab *s = P->slabs;
+        while (s)
+        {
+            NodeSlab *next = s->next;
+            free(s);
+            s = next;
+        }
+
+        free(P);
+        P = forward;
+    }
+}
+
+/* 分配一块新的 slab 作为当前 slab. */
+static void NewSlab(NodePool *P)
+{
+    NodeSlab *s = malloc(sizeof(NodeSlab) + P->nodeSize * P->slabNodes);
+    if (!s)
+    {
+        exit(OVERFLOW);
+    }
+
+    s->bytes = sizeof(NodeSlab) + P->nodeSize * P->slabNodes;
+    s->next = P->slabs;
+    P->slabs = s;
+    P->cursor = (char *)s->align;
+    P->limit = P->cursor + P->nodeSize * P->slabNodes;
+
+    if (P->slabNodes < NODE_SLAB_MAX)
+    {
+        P->slabNodes *= 2;
+    }
+}
+
+void *NodePoolAlloc(NodePool *P)
+{
+    if (P->forward)
+    {
+        P = FindPool(P);
+    }
+
+    /* 先复用空闲结点. */
+    void *node = P->freeList;
+    if (node)
+    {
+        P->freeList = *(void **)node;
+        return node;
+    }
+
+    /* 再从当前 slab 顺序切出. */
+    if (P->cursor == P->limit)
+    {
+        NewSlab(P);
+    }
+
+    node = P->cursor;
+    P->cursor += P->nodeSize;
+
+    return node;
+}
+
+void *NodePoolAllocArray(NodePool *P, size_t count)
+{
+    if (P->forward)
+    {
+        P = FindPool(P);
+    }
+
+    size_t bytes = P->nodeSize * count;
+    if ((size_t)(P->limit - P->cursor) >= bytes)
+    {
+        void *node = P->cursor;
+        P->cursor += bytes;
+        return node;
+    }
+
+    /* 单独的 slab 只挂进 slab 链表, 随池释放, 不作为当前 slab. */
+    NodeSlab *s = malloc(sizeof(NodeSlab) + bytes);
+    if (!s)
+    {
+        exit(OVERFLOW);
+    }
+
+    s->bytes = sizeof(NodeSlab) + bytes;
+    s->next = P->slabs;
+    P->slabs = s;
+
+    return s->align;
+}
+
+void NodePoolFree(NodePool *P, void *node)
+{
+    if (P->forward)
+    {
+        P = FindPool(P);
+    }
+
+    *(void **)node = P->freeList;
+    P->freeList = node;
+}
+
+size_t NodePoolBytes(NodePool *P)
+{
+    size_t bytes = sizeof(NodePool);
+
+    P = FindPool(P);
+    for (NodeSlab *s = P->slabs; s != NULL; s = s->next)
+    {
+        bytes += s->bytes;
+    }
+
+    return bytes;
+}
+
+void MergeNodePool(NodePool *A, NodePool *B)
+{
+    A = FindPool(A);
+    B = FindPool(B);
+
+    if (A == B)
+    {
+        return;
+    }
+
+    /* B 的 slab 接到 A 的 slab 链表之后. B 当前 slab 剩余的部分就此放弃. */
+    if (B->slabs)
+    {
+        NodeSlab *last = B->slabs;
+        while (last->next)
+        {
+            last = last->next;
+        }
+        last->next = A->slabs;
+        A->slabs = B->slabs;
+    }
+
+    /* B 的空闲结点并入 A 的空闲链表. */
+    if (B->freeList)
+    {
+        void *last = B->freeList;
+        while (*(void **)last)
+        {
+            last = *(void **)last;
+        }
+        *(void **)last = A->freeList;
+        A->freeList = B->freeList;
+    }
+
+    B->slabs = NULL;
+    B->freeList = NULL;
+    B->cursor = B->limit = NULL;
+
+    /* B 成为转发到 A 的存根, 并持有 A 的一个引用. */
+    B->forward = A;
+    ++A->refcount;
+}
+
+void *NewListHead(size_t nodeSize)
+{
+    char *block = malloc(HEAD_PREFIX + nodeSize);
+    if (!block)
+    {
+        exit(OVERFLOW);
+    }
+
+    *(NodePool **)block = CreateNodePool(nodeSize);
+
+    return block + HEAD_PREFIX;
+}
+
+void *ShareListHead(const void *head)
+{
+    NodePool *P = ListHeadPool(head);
+    char *block = malloc(HEAD_PREFIX + P->nodeSize);
+    if (!block)
+    {
+        exit(OVERFLOW);
+    }
+
+    RetainNodePool(P);
+    *(NodePool **)block = P;
+
+    return block + HEAD_PREFIX;
+}
+
+NodePool *ListHeadPool(const void *head)
+{
+    return *(NodePool *const *)((const char *)head - HEAD_PREFIX);
+}
+
+void FreeListHead(void *head)
+{
+    char *block = (char *)head - HEAD_PREFIX;
+
+    ReleaseNodePool(*(NodePool **)block);
+    free(block);
+}
@@ -0,0 +1,269 @@
+﻿/**
+ * @file plinklist.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 持久化单向链表方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <linearlist/linklist/plinklist.h>
+
+/* 新建结点, 引用计数为 1, 接管调用者持有的对 next 的引用. */
+static PNode *NewNode(ElemType e, PNode *next)
+{
+    PNode *s = malloc(sizeof(PNode));
+    /* 内存分配失败. */
+    if (!s)
+    {
+        exit(OVERFLOW);
+    }
+
+    s->data = e;
+    atomic_init(&s->ref, 1);
+    s->next = next;
+
+    return s;
+}
+
+static PNode *Retain(PNode *p)
+{
+    if (p)
+    {
+        /* 增加引用的线程已经持有一个引用, 不需要同步. */
+        atomic_fetch_add_explicit(&p->ref, 1, memory_order_relaxed);
+    }
+
+    return p;
+}
+
+/**
+ * @brief 释放对 p 的一个引用. 计数归零时释放结点, 并接着释放它对后继的引用,
+ * 用循环而不是递归, 长链也不会栈溢出.
+ */
+static void Release(PNode *p)
+{
+    /* acq_rel: 释放前对结点的读取不会越过减一; 减到零的线程能看到其他线程
+     * 释放引用之前的全部读取都已完成, 才可以 free(). */
+    while (p && atomic_fetch_sub_explicit(&p->ref, 1, memory_order_acq_rel) == 1)
+    {
+        PNode *next = p->next;
+        free(p);
+        p = next;
+    }
+}
+
+/* 结点 p 只有一个引用时返回真. 这个引用来自本版本, 可以原地修改. */
+static int Unique(const PNode *p)
+{
+    return atomic_load_explicit(&p->ref, memory_order_acquire) == 1;
+}
+
+/**
+ * @brief 使 *link 指向的结点只被本版本引用: 被共享时复制一份代替它. 副本
+ * 引用原结点的后继, 原结点少一个引用.
+ */
+static PNode *Unshare(PNode **link)
+{
+    PNode *p = *link;
+
+    if (Unique(p))
+    {
+        return p;
+    }
+
+    PNode *c = NewNode(p->data, Retain(p->next));
+    *link = c;
+    Release(p);
+
+    return c;
+}
+
+/**
+ * @brief 使前 k 个结点都只被本版本引用. 被共享的结点之后的结点也都被共享,
+ * 所以一旦开始复制就复制到第 k 个.
+ * @return 指向第 k + 1 个结点的链接, k 为 0 时是表头.
+ */
+static PNode **Own(PList *L, int k)
+{
+    PNode **link = &L->head;
+
+    for (int j = 0; j < k; ++j)
+    {
+        link = &Unshare(link)->next;
+    }
+
+    return link;
+}
+
+Status InitList_P(PList *L)
+{
+    L->head = NULL;
+    L->length = 0;
+
+    return OK;
+}
+
+Status CreateList_P(PList *L, const ElemType *a, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    InitList_P(L);
+
+    /* 从后向前头插, 每个结点只建立一次. */
+    for (int k = n - 1; k >= 0; --k)
+    {
+        L->head = NewNode(a[k], L->head);
+    }
+    L->length = n;
+
+    return OK;
+}
+
+Status Snapshot_P(const PList *L, PList *S)
+{
+    S->head = Retain(L->head);
+    S->length = L->length;
+
+    return OK;
+}
+
+Status DestroyList_P(PList *L)
+{
+    Release(L->head);
+    L->head = NULL;
+    L->length = 0;
+
+    return OK;
+}
+
+Status HeadInsert_P(PList *L, ElemType e)
+{
+    /* 新结点接管表头对原第一个结点的引用. */
+    L->head = NewNode(e, L->head);
+    ++L->length;
+
+    return OK;
+}
+
+Status TailInsert_P(PList *L, ElemType e)
+{
+    return ListInsert_P(L, L->length + 1, e);
+}
+
+Status GetElem_P(const PList *L, int i, ElemType *e)
+{
+    if (i < 1 || i > L->length)
+    {
+        return ERROR;
+    }
+
+    const PNode *p = L->head;
+    while (--i)
+    {
+        p = p->next;
+    }
+    *e = p->data;
+
+    return OK;
+}
+
+Status SetElem_P(PList *L, int i, ElemType e)
+{
+    if (i < 1 || i > L->length)
+    {
+        return ERROR;
+    }
+
+    Unshare(Own(L, i - 1))->data = e;
+
+    return OK;
+}
+
+int LocateElem_P(const PList *L, ElemType e)
+{
+    int i = 1;
+
+    for (const PNode *p = L->head; p; p = p->next, ++i)
+    {
+        if (p->data == e)
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+Status ListInsert_P(PList *L, int i, ElemType e)
+{
+    if (i < 1 || i > L->length + 1)
+    {
+        return ERROR;
+    }
+
+    PNode **link = Own(L, i - 1);
+
+    /* 新结点接管链接对第 i 个结点的引用. */
+    *link = NewNode(e, *link);
+    ++L->length;
+
+    return OK;
+}
+
+Status ListDelete_P(PList *L, int i, ElemType *e)
+{
+    if (i < 1 || i > L->length)
+    {
+        return ERROR;
+    }
+
+    PNode **link = Own(L, i - 1);
+    PNode *p = *link;
+
+    if (e)
+    {
+        *e = p->data;
+    }
+
+    /* 先取得对后继的引用再释放 p, p 归零时会释放它对后继的引用. */
+    *link = Retain(p->next);
+    Release(p);
+    --L->length;
+
+    return OK;
+}
+
+int ListToArray_P(const PList *L, ElemType *a, int max)
+{
+    int k = 0;
+
+    for (const PNode *p = L->head; p && k < max; p = p->next)
+    {
+        a[k++] = p->data;
+    }
+
+    return k;
+}
+
+int ListLength_P(const PList *L)
+{
+    return L->length;
+}
+
+void PrintList_P(const PList *L)
+{
+    for (const PNode *p = L->head; p; p = p->next)
+    {
+        printf(p->next ? "%d->" : "%d", p->data);
+    }
+    printf("\n");
+}
@@ -0,0 +1,625 @@
+﻿/**
+ * @file rope.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 按位序平衡的分块序列 (绳) 方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <linearlist/linklist/rope.h>
+
+/* 结点不足这么多元素时与相邻结点合并或平分元素. */
+#define RNODE_MIN_COUNT ((int)RNODE_CAPACITY / 4)
+/* 批量建立时每个结点装入的元素个数, 留出插入的余地. */
+#define RNODE_FILL_COUNT ((int)RNODE_CAPACITY * 3 / 4)
+
+/* xorshift64* 随机数, 取高 32 位作为优先级. */
+static unsigned int NextPriority(Rope *R)
+{
+    R->seed ^= R->seed >> 12;
+    R->seed ^= R->seed << 25;
+    R->seed ^= R->seed >> 27;
+
+    return (unsigned int)((R->seed * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static RNode *NewNode(Rope *R)
+{
+    RNode *s = NodePoolAlloc(R->pool);
+
+    s->left = s->right = NULL;
+    s->priority = NextPriority(R);
+    s->count = s->size = 0;
+
+    return s;
+}
+
+static int Size(const RNode *t)
+{
+    return t ? t->size : 0;
+}
+
+static void Update(RNode *t)
+{
+    t->size = Size(t->left) + t->count + Size(t->right);
+}
+
+/* 拼接两棵树, a 中的元素都在 b 之前. */
+static RNode *Merge(RNode *a, RNode *b)
+{
+    if (!a)
+    {
+        return b;
+    }
+    if (!b)
+    {
+        return a;
+    }
+
+    if (a->priority >= b->priority)
+    {
+        a->right = Merge(a->right, b);
+        Update(a);
+        return a;
+    }
+
+    b->left = Merge(a, b->left);
+    Update(b);
+    return b;
+}
+
+/**
+ * @brief 把树 t 拆成前 k 个元素 l 和其余元素 r. 第 k 个元素恰在某个结点中间时,
+ * 把该结点后面的元素移到新结点 *cut, 结点本身留在 l 中.
+ */
+static void SplitAt(Rope *R, RNode *t, int k, RNode **l, RNode **r,
+                    RNode **cut)
+{
+    if (!t)
+    {
+        *l = *r = NULL;
+        return;
+    }
+
+    int ls = Size(t->left);
+
+    if (k <= ls)
+    {
+        SplitAt(R, t->left, k, l, &t->left, cut);
+        Update(t);
+        *r = t;
+    }
+    else if (k >= ls + t->count)
+    {
+        SplitAt(R, t->right, k - ls - t->count, &t->right, r, cut);
+        Update(t);
+        *l = t;
+    }
+    else
+    {
+        int off = k - ls;
+        RNode *u = NewNode(R);
+
+        u->count = u->size = t->count - off;
+        memcpy(u->elem, t->elem + off, sizeof(ElemType) * (size_t)u->count);
+        t->count = off;
+
+        *r = t->right;
+        t->right = NULL;
+        Update(t);
+
+        *l = t;
+        *cut = u;
+    }
+}
+
+/**
+ * @brief 把树 t 拆成前 k 个元素 l 和其余元素 r. 拆开结点时新结点的优先级是
+ * 随机的, 不能直接挂在原来的祖先之下, 等拆完后再作为 r 的第一个结点拼上.
+ */
+static void SplitTree(Rope *R, RNode *t, int k, RNode **l, RNode **r)
+{
+    RNode *cut = NULL;
+
+    SplitAt(R, t, k, l, r, &cut);
+
+    if (cut)
+    {
+        *r = Merge(cut, *r);
+    }
+}
+
+/**
+ * @brief 第 i 个元素之后恰是两个结点的分界时, 两个结点的元素合计不超过
+ * RNODE_CAPACITY 就合并成一个; 否则若其中一个不足 RNODE_MIN_COUNT, 就平分
+ * 两个结点的元素, 两边都至少半满. 先在 i 处拆开, 前一棵树的最右结点与后一棵
+ * 树的最左结点就是分界两侧的结点.
+ */
+static void Fuse(Rope *R, int i)
+{
+    if (i <= 0 || i >= Size(R->root))
+    {
+        return;
+    }
+
+    RNode *a, *c;
+    SplitTree(R, R->root, i, &a, &c);
+
+    RNode *x = a, *y = c;
+    while (x->right)
+    {
+        x = x->right;
+    }
+    while (y->left)
+    {
+        y = y->left;
+    }
+
+    if (x->count + y->count <= (int)RNODE_CAPACITY)
+    {
+        int moved = y->count;
+
+        memcpy(x->elem + x->count, y->elem, sizeof(ElemType) * (size_t)moved);
+        x->count += moved;
+        /* x 在 a 的右链末端, 右链上的结点都多了 moved 个元素. */
+        for (RNode *p = a; p; p = p->right)
+        {
+            p->size += moved;
+        }
+
+        /* y 在 c 的左链末端, 没有左子树, 用右子树顶替它. */
+        RNode **link = &c;
+        while ((*link)->left)
+        {
+            (*link)->size -= moved;
+            link = &(*link)->left;
+        }
+        *link = y->right;
+        NodePoolFree(R->pool, y);
+    }
+    else if (x->count < RNODE_MIN_COUNT || y->count < RNODE_MIN_COUNT)
+    {
+        /* moved > 0 时从 y 的开头移到 x 的末尾, 否则从 x 的末尾移到 y 的开头. */
+        int moved = (x->count + y->count) / 2 - x->count;
+
+        if (moved > 0)
+        {
+            memcpy(x->elem + x->count, y->elem,
+                   sizeof(ElemType) * (size_t)moved);
+            memmove(y->elem, y->elem + moved,
+                    sizeof(ElemType) * (size_t)(y->count - moved));
+        }
+        else
+        {
+            memmove(y->elem - moved, y->elem,
+                    sizeof(ElemType) * (size_t)y->count);
+            memcpy(y->elem, x->elem + x->count + moved,
+                   sizeof(ElemType) * (size_t)-moved);
+        }
+        x->count += moved;
+        y->count -= moved;
+
+        for (RNode *p = a; p; p = p->right)
+        {
+            p->size += moved;
+        }
+        for (RNode *p = c; p; p = p->left)
+        {
+            p->size -= moved;
+        }
+    }
+
+    R->root = Merge(a, c);
+}
+
+Status InitList_R(Rope *R)
+{
+    R->root = NULL;
+    R->pool = CreateNodePool(sizeof(RNode));
+    /* 种子不能为 0. */
+    R->seed = ((unsigned long long)(size_t)R ^ 0x9E3779B97F4A7C15ULL) | 1;
+
+    return OK;
+}
+
+Status CreateList_R(Rope *R, const ElemType *a, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    InitList_R(R);
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    /* 按顺序加入结点, 用栈保存当前树的右链, 每个结点进出栈各一次, O(n). */
+    int nodes = (n + RNODE_FILL_COUNT - 1) / RNODE_FILL_COUNT;
+    RNode **stack = malloc(sizeof(RNode *) * (size_t)nodes);
+    /* 内存分配失败. */
+    if (!stack)
+    {
+        exit(OVERFLOW);
+    }
+
+    int top = 0;
+    for (int k = 0; k < n; k += RNODE_FILL_COUNT)
+    {
+        RNode *s = NewNode(R);
+        s->count = n - k < RNODE_FILL_COUNT ? n - k : RNODE_FILL_COUNT;
+        memcpy(s->elem, a + k, sizeof(ElemType) * (size_t)s->count);
+
+        /* 优先级较低的右链结点成为新结点的左子树, 出栈时子树已经完整. */
+        RNode *last = NULL;
+        while (top > 0 && stack[top - 1]->priority < s->priority)
+        {
+            last = stack[--top];
+            Update(last);
+        }
+        s->left = last;
+        if (top > 0)
+        {
+            stack[top - 1]->right = s;
+        }
+        stack[top++] = s;
+    }
+
+    while (top > 0)
+    {
+        Update(stack[--top]);
+    }
+    R->root = stack[0];
+
+    free(stack);
+
+    /* 最后一个结点可能不足 RNODE_MIN_COUNT. */
+    Fuse(R, n - (n - 1) % RNODE_FILL_COUNT - 1);
+
+    return OK;
+}
+
+Status DestroyList_R(Rope *R)
+{
+    ReleaseNodePool(R->pool);
+    R->root = NULL;
+    R->pool = NULL;
+
+    return OK;
+}
+
+Status HeadInsert_R(Rope *R, ElemType e)
+{
+    return ListInsert_R(R, 1, e);
+}
+
+Status TailInsert_R(Rope *R, ElemType e)
+{
+    return ListInsert_R(R, Size(R->root) + 1, e);
+}
+
+Status GetElem_R(const Rope *R, int i, ElemType *e)
+{
+    if (i < 1 || i > Size(R->root))
+    {
+        return ERROR;
+    }
+
+    const RNode *t = R->root;
+    int k = i - 1;
+
+    for (;;)
+    {
+        int ls = Size(t->left);
+
+        if (k < ls)
+        {
+            t = t->left;
+        }
+        else if (k < ls + t->count)
+        {
+            *e = t->elem[k - ls];
+            return OK;
+        }
+        else
+        {
+            k -= ls + t->count;
+            t = t->right;
+        }
+    }
+}
+
+/* 在子树 t 中查找 e, base 为 t 之前的元素个数. 找到时返回位序, 否则返回 0. */
+static int Locate(const RNode *t, int base, ElemType e)
+{
+    while (t)
+    {
+        int pos = Locate(t->left, base, e);
+        if (pos)
+        {
+            return pos;
+        }
+
+        base += Size(t->left);
+        for (int k = 0; k < t->count; ++k)
+        {
+            if (t->elem[k] == e)
+            {
+                return base + k + 1;
+            }
+        }
+
+        /* 右子树改为循环, 递归深度只随左链增长. */
+        base += t->count;
+        t = t->right;
+    }
+
+    return 0;
+}
+
+int LocateElem_R(const Rope *R, ElemType e)
+{
+    return Locate(R->root, 0, e);
+}
+
+Status ListInsert_R(Rope *R, int i, ElemType e)
+{
+    int length = Size(R->root);
+
+    if (i < 1 || i > length + 1)
+    {
+        return ERROR;
+    }
+
+    if (!R->root)
+    {
+        R->root = NewNode(R);
+        R->root->elem[0] = e;
+        R->root->count = R->root->size = 1;
+        return OK;
+    }
+
+    int pos = i - 1, k, ls;
+    RNode *t;
+
+    /* 第一遍只定位, 所在结点满时在它中间拆开, 再重新定位. */
+    for (;;)
+    {
+        t = R->root;
+        k = pos;
+        for (;;)
+        {
+            ls = Size(t->left);
+            if (k < ls)
+            {
+                t = t->left;
+            }
+            else if (k <= ls + t->count)
+            {
+                break;
+            }
+            else
+            {
+                k -= ls + t->count;
+                t = t->right;
+            }
+        }
+
+        if (t->count < (int)RNODE_CAPACITY)
+        {
+            break;
+        }
+
+        RNode *a, *b;
+        SplitTree(R, R->root, pos - (k - ls) + t->count / 2, &a, &b);
+        R->root = Merge(a, b);
+    }
+
+    /* 第二遍沿同一路径下降, 途经的子树都多一个元素. */
+    t = R->root;
+    k = pos;
+    for (;;)
+    {
+        ++t->size;
+        ls = Size(t->left);
+        if (k < ls)
+        {
+            t = t->left;
+        }
+        else if (k <= ls + t->count)
+        {
+            break;
+        }
+        else
+        {
+            k -= ls + t->count;
+            t = t->right;
+        }
+    }
+
+    k -= ls;
+    memmove(t->elem + k + 1, t->elem + k,
+            sizeof(ElemType) * (size_t)(t->count - k));
+    t->elem[k] = e;
+    ++t->count;
+
+    return OK;
+}
+
+Status ListDelete_R(Rope *R, int i, ElemType *e)
+{
+    if (i < 1 || i > Size(R->root))
+    {
+        return ERROR;
+    }
+
+    RNode **link = &R->root, *t;
+    int k = i - 1, ls;
+
+    /* 位序合法, 途经的子树都少一个元素. */
+    for (;;)
+    {
+        t = *link;
+        --t->size;
+        ls = Size(t->left);
+        if (k < ls)
+        {
+            link = &t->left;
+        }
+        else if (k < ls + t->count)
+        {
+            break;
+        }
+        else
+        {
+            k -= ls + t->count;
+            link = &t->right;
+        }
+    }
+
+    k -= ls;
+    if (e)
+    {
+        *e = t->elem[k];
+    }
+    memmove(t->elem + k, t->elem + k + 1,
+            sizeof(ElemType) * (size_t)(t->count - k - 1));
+    --t->count;
+
+    if (t->count == 0)
+    {
+        *link = Merge(t->left, t->right);
+        NodePoolFree(R->pool, t);
+    }
+    else if (t->count < RNODE_MIN_COUNT)
+    {
+        /* 优先与后继合并, t 是最后一个结点时与前驱合并. */
+        int start = i - 1 - k;
+        if (start + t->count < Size(R->root))
+        {
+            Fuse(R, start + t->count);
+        }
+        else
+        {
+            Fuse(R, start);
+        }
+    }
+
+    return OK;
+}
+
+Status Split_R(Rope *R, int i, Rope *T)
+{
+    if (i < 0 || i > Size(R->root))
+    {
+        return ERROR;
+    }
+
+    T->pool = R->pool;
+    RetainNodePool(T->pool);
+    T->seed = R->seed * 0x9E3779B97F4A7C15ULL | 1;
+
+    SplitTree(R, R->root, i, &R->root, &T->root);
+
+    /* 拆开的结点分别是 R 的最后一个结点和 T 的第一个结点, 可能不足
+     * RNODE_MIN_COUNT. */
+    if (R->root)
+    {
+        RNode *x = R->root;
+        while (x->right)
+        {
+            x = x->right;
+        }
+        Fuse(R, Size(R->root) - x->count);
+    }
+    if (T->root)
+    {
+        RNode *y = T->root;
+        while (y->left)
+        {
+            y = y->left;
+        }
+        Fuse(T, y->count);
+    }
+
+    return OK;
+}
+
+Status Concat_R(Rope *R, Rope *T)
+{
+    if (R == T)
+    {
+        return ERROR;
+    }
+
+    int boundary = Size(R->root);
+
+    /* 此后 T 的结点可以归还给 R 的池. */
+    MergeNodePool(R->pool, T->pool);
+    R->root = Merge(R->root, T->root);
+    T->root = NULL;
+
+    Fuse(R, boundary);
+
+    return OK;
+}
+
+/* 把子树 t 的元素依次复制到 a, 至多 max 个, 返回复制的个数. */
+static int Flatten(const RNode *t, ElemType *a, int max)
+{
+    int k = 0;
+
+    while (t && k < max)
+    {
+        k += Flatten(t->left, a + k, max - k);
+
+        int c = t->count < max - k ? t->count : max - k;
+        memcpy(a + k, t->elem, sizeof(ElemType) * (size_t)c);
+        k += c;
+
+        t = t->right;
+    }
+
+    return k;
+}
+
+int ListToArray_R(const Rope *R, ElemType *a, int max)
+{
+    return Flatten(R->root, a, max);
+}
+
+int ListLength_R(const Rope *R)
+{
+    return Size(R->root);
+}
+
+static void Print(const RNode *t, int *first)
+{
+    while (t)
+    {
+        Print(t->left, first);
+
+        for (int k = 0; k < t->count; ++k)
+        {
+            printf(*first ? "%d" : "->%d", t->elem[k]);
+            *first = 0;
+        }
+
+        t = t->right;
+    }
+}
+
+void PrintList_R(const Rope *R)
+{
+    int first = 1;
+
+    Print(R->root, &first);
+    printf("\n");
+}
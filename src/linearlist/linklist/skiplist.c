@@ -0,0 +1,345 @@
+﻿/**
+ * @file skiplist.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 跳表方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <time.h>
+
+#include <linearlist/linklist/skiplist.h>
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+/* 层数为 level 的结点字节数. */
+#define SKNODE_SIZE(level) (sizeof(SKNode) + sizeof(SKNode *) * (size_t)(level))
+
+/* 每个线程各自的随机数状态, 不需要加锁. 0 表示尚未播种. */
+static THREAD_LOCAL unsigned long long rngState;
+
+/**
+ * @brief xorshift64* 随机数. 第一次调用时用状态变量的地址 (各线程不同) 和
+ * 时间播种.
+ */
+static unsigned long long NextRandom(void)
+{
+    unsigned long long x = rngState;
+
+    if (x == 0)
+    {
+        /* splitmix64 打散种子. */
+        x = (unsigned long long)(size_t)&rngState ^ (unsigned long long)time(NULL);
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        if (x == 0)
+        {
+            x = 1;
+        }
+    }
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rngState = x;
+
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief 随机层数. 每两个随机位同时为 0 的概率为 1/4, 所以层数为末尾连续 0
+ * 的个数除以 2 再加 1, 一次取随机数即可.
+ */
+static int RandomLevel(void)
+{
+    unsigned long long r = NextRandom() | 1ULL << (2 * (SKIPLIST_MAX_LEVEL - 1));
+    int zeros = 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+    zeros = __builtin_ctzll(r);
+#else
+    while (!(r & 1))
+    {
+        r >>= 1;
+        ++zeros;
+    }
+#endif
+
+    return zeros / 2 + 1;
+}
+
+static SKNode *NewNode(SkipList *S, int level, ElemType e)
+{
+    if (!S->pool[level - 1])
+    {
+        S->pool[level - 1] = CreateNodePool(SKNODE_SIZE(level));
+    }
+
+    SKNode *s = NodePoolAlloc(S->pool[level - 1]);
+    s->data = e;
+    s->level = level;
+
+    return s;
+}
+
+static void FreeNode(SkipList *S, SKNode *p)
+{
+    NodePoolFree(S->pool[p->level - 1], p);
+}
+
+/**
+ * @brief 自顶向下查找, 求各层最后一个满足 Before(结点, e) 的结点, 存入
+ * update. 各层都从上一层停下的结点继续向右.
+ * @param strict 为真时 Before 为 data < e, 否则为 data <= e.
+ */
+static void FindPredecessors(const SkipList *S, ElemType e, int strict,
+                             SKNode **update)
+{
+    SKNode *p = S->head;
+
+    for (int i = S->level - 1; i >= 0; --i)
+    {
+        SKNode *q = p->next[i];
+
+        while (q && (strict ? q->data < e : q->data <= e))
+        {
+            p = q;
+            q = q->next[i];
+        }
+
+        update[i] = p;
+    }
+}
+
+Status InitList_SK(SkipList *S)
+{
+    S->head = malloc(SKNODE_SIZE(SKIPLIST_MAX_LEVEL));
+    /* 内存分配失败. */
+    if (!S->head)
+    {
+        exit(OVERFLOW);
+    }
+
+    S->head->data = 0;
+    S->head->level = SKIPLIST_MAX_LEVEL;
+    for (int i = 0; i < SKIPLIST_MAX_LEVEL; ++i)
+    {
+        S->head->next[i] = NULL;
+        S->pool[i] = NULL;
+    }
+
+    S->level = 1;
+    S->length = 0;
+
+    return OK;
+}
+
+Status DestroyList_SK(SkipList *S)
+{
+    for (int i = 0; i < SKIPLIST_MAX_LEVEL; ++i)
+    {
+        if (S->pool[i])
+        {
+            ReleaseNodePool(S->pool[i]);
+            S->pool[i] = NULL;
+        }
+    }
+
+    free(S->head);
+    S->head = NULL;
+    S->level = 0;
+    S->length = 0;
+
+    return OK;
+}
+
+Status Insert_SK(SkipList *S, ElemType e)
+{
+    SKNode *update[SKIPLIST_MAX_LEVEL];
+
+    /* 排在相等的元素之后. */
+    FindPredecessors(S, e, 0, update);
+
+    int level = RandomLevel();
+    if (level > S->level)
+    {
+        for (int i = S->level; i < level; ++i)
+        {
+            update[i] = S->head;
+        }
+        S->level = level;
+    }
+
+    SKNode *s = NewNode(S, level, e);
+    for (int i = 0; i < level; ++i)
+    {
+        s->next[i] = update[i]->next[i];
+        update[i]->next[i] = s;
+    }
+
+    ++S->length;
+
+    return OK;
+}
+
+Status Delete_SK(SkipList *S, ElemType e)
+{
+    SKNode *update[SKIPLIST_MAX_LEVEL];
+
+    FindPredecessors(S, e, 1, update);
+
+    SKNode *p = update[0]->next[0];
+    if (!p || p->data != e)
+    {
+        return ERROR;
+    }
+
+    /* 第一个值为 e 的结点在它所在的各层上都紧跟在 update[i] 之后. */
+    for (int i = 0; i < p->level; ++i)
+    {
+        update[i]->next[i] = p->next[i];
+    }
+
+    FreeNode(S, p);
+    --S->length;
+
+    while (S->level > 1 && !S->head->next[S->level - 1])
+    {
+        --S->level;
+    }
+
+    return OK;
+}
+
+SKNode *LowerBound_SK(const SkipList *S, ElemType e)
+{
+    SKNode *p = S->head;
+
+    for (int i = S->level - 1; i >= 0; --i)
+    {
+        SKNode *q = p->next[i];
+
+        while (q && q->data < e)
+        {
+            p = q;
+            q = q->next[i];
+        }
+    }
+
+    return p->next[0];
+}
+
+SKNode *LocateElem_SK(const SkipList *S, ElemType e)
+{
+    SKNode *p = LowerBound_SK(S, e);
+
+    return p && p->data == e ? p : NULL;
+}
+
+int RangeDelete_SK(SkipList *S, ElemType min, ElemType max)
+{
+    SKNode *update[SKIPLIST_MAX_LEVEL];
+
+    if (min >= max)
+    {
+        return 0;
+    }
+
+    /* update[i] 为第 i 层最后一个不大于 min 的结点. */
+    FindPredecessors(S, min, 0, update);
+
+    SKNode *first = update[0]->next[0];
+
+    /* 逐层把前驱接到区间之后. 每层只走过被删除的结点, 总共 O(logn + k). */
+    for (int i = 0; i < S->level; ++i)
+    {
+        SKNode *q = update[i]->next[i];
+
+        while (q && q->data < max)
+        {
+            q = q->next[i];
+        }
+
+        update[i]->next[i] = q;
+    }
+
+    /* 摘下的结点在第 0 层仍连在一起, 逐个归还结点池. */
+    SKNode *last = update[0]->next[0];
+    int count = 0;
+    while (first != last)
+    {
+        SKNode *p = first;
+        first = first->next[0];
+        FreeNode(S, p);
+        ++count;
+    }
+
+    S->length -= count;
+    while (S->level > 1 && !S->head->next[S->level - 1])
+    {
+        --S->level;
+    }
+
+    return count;
+}
+
+SKCursor RangeScan_SK(const SkipList *S, ElemType min, ElemType max)
+{
+    SKCursor C;
+    SKNode *p = S->head;
+
+    /* 找第一个大于 min 的结点. */
+    for (int i = S->level - 1; i >= 0; --i)
+    {
+        SKNode *q = p->next[i];
+
+        while (q && q->data <= min)
+        {
+            p = q;
+            q = q->next[i];
+        }
+    }
+
+    C.node = p->next[0];
+    C.max = max;
+
+    return C;
+}
+
+Status CursorNext_SK(SKCursor *C, ElemType *e)
+{
+    if (!C->node || C->node->data >= C->max)
+    {
+        C->node = NULL;
+        return FALSE;
+    }
+
+    *e = C->node->data;
+    C->node = C->node->next[0];
+
+    return TRUE;
+}
+
+int ListLength_SK(const SkipList *S)
+{
+    return S->length;
+}
+
+void PrintList_SK(const SkipList *S)
+{
+    for (SKNode *p = S->head->next[0]; p; p = p->next[0])
+    {
+        printf("%d ", p->data);
+    }
+
+    printf("\n");
+}
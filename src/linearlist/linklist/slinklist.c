@@ -0,0 +1,289 @@
+﻿/**
+ * @file slinklist.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 静态双向链表方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <limits.h>
+
+#include <linearlist/linklist/slinklist.h>
+
+/**
+ * @brief 取一个空闲结点, 先找空闲链, 再找未用过的部分, 都没有时数组加倍.
+ * 下标超过 32 位时视为内存不足.
+ */
+static SIndex NewNode_S(SLinklist *L)
+{
+    SIndex k = L->free;
+
+    if (k)
+    {
+        L->free = L->node[k].next;
+        return k;
+    }
+
+    if (L->top == L->listsize)
+    {
+        if (L->listsize > UINT32_MAX / 2)
+        {
+            exit(OVERFLOW);
+        }
+
+        SNode *newbase =
+            realloc(L->node, sizeof(SNode) * (size_t)L->listsize * 2);
+        /* 内存分配失败. */
+        if (!newbase)
+        {
+            exit(OVERFLOW);
+        }
+
+        L->node = newbase;
+        L->listsize *= 2;
+    }
+
+    return L->top++;
+}
+
+/**
+ * @brief 把新结点 s 链接到结点 p 之后.
+ */
+static void LinkAfter_S(SLinklist *L, SIndex p, SIndex s, ElemType e)
+{
+    SNode *node = L->node;
+    SIndex q = node[p].next;
+
+    node[s].data = e;
+    node[s].next = q;
+    node[s].prior = p;
+    node[q].prior = s;
+    node[p].next = s;
+
+    ++L->length;
+}
+
+Status InitList_S(SLinklist *L)
+{
+    L->node = malloc(sizeof(SNode) * SLIST_INIT_SIZE);
+    /* 内存分配失败. */
+    if (!L->node)
+    {
+        exit(OVERFLOW);
+    }
+
+    /* 头结点自成一个环. */
+    L->node[0].data = 0;
+    L->node[0].next = 0;
+    L->node[0].prior = 0;
+
+    L->length = 0;
+    L->listsize = SLIST_INIT_SIZE;
+    L->top = 1;
+    L->free = 0;
+
+    return OK;
+}
+
+Status DestroyList_S(SLinklist *L)
+{
+    free(L->node);
+    L->node = NULL;
+    L->length = 0;
+    L->listsize = 0;
+    L->top = 0;
+    L->free = 0;
+
+    return OK;
+}
+
+Status HeadInsert_S(SLinklist *L, ElemType e)
+{
+    SIndex s = NewNode_S(L);
+
+    LinkAfter_S(L, 0, s, e);
+
+    return OK;
+}
+
+Status TailInsert_S(SLinklist *L, ElemType e)
+{
+    SIndex s = NewNode_S(L);
+
+    /* 头结点的前驱就是最后一个结点. */
+    LinkAfter_S(L, L->node[0].prior, s, e);
+
+    return OK;
+}
+
+long GetElem_S(SLinklist L, int i)
+{
+    if (i < 0 || i > L.length)
+    {
+        printf("Index out of range.\n");
+        return -1;
+    }
+
+    SIndex p = 0;
+
+    /* 后半段从表尾向前走. */
+    if (i > L.length / 2)
+    {
+        for (int k = L.length + 1; k > i; --k)
+        {
+            p = L.node[p].prior;
+        }
+    }
+    else
+    {
+        for (int k = 0; k < i; ++k)
+        {
+            p = L.node[p].next;
+        }
+    }
+
+    return (long)p;
+}
+
+SIndex LocateElem_S(SLinklist L, ElemType e)
+{
+    SIndex p = L.node[0].next;
+
+    while (p && L.node[p].data != e)
+    {
+        p = L.node[p].next;
+    }
+
+    return p;
+}
+
+Status ListInsert_S(SLinklist *L, int i, ElemType e)
+{
+    if (i < 1 || i > L->length + 1)
+    {
+        printf("Illegal insertion position.\n");
+        return ERROR;
+    }
+
+    /* 先取空闲结点, 数组可能因此搬移, 但下标不变. */
+    SIndex s = NewNode_S(L);
+    SIndex p = (SIndex)GetElem_S(*L, i - 1);
+
+    LinkAfter_S(L, p, s, e);
+
+    return OK;
+}
+
+Status NodeDelete_S(SLinklist *L, SIndex k)
+{
+    SNode *node = L->node;
+
+    /* 空闲结点不能再删一次, 否则会重复挂上空闲链. */
+    if (k == 0 || k >= L->top || node[k].prior == SLIST_FREE)
+    {
+        return ERROR;
+    }
+
+    /* 前驱和后继互相跳过 k. */
+    node[node[k].prior].next = node[k].next;
+    node[node[k].next].prior = node[k].prior;
+
+    /* k 挂到空闲链头部. */
+    node[k].next = L->free;
+    node[k].prior = SLIST_FREE;
+    L->free = k;
+    --L->length;
+
+    return OK;
+}
+
+Status ListDelete_S(SLinklist *L, int i)
+{
+    if (i < 1 || i > L->length)
+    {
+        printf("Illegal deletion position.\n");
+        return ERROR;
+    }
+
+    return NodeDelete_S(L, (SIndex)GetElem_S(*L, i));
+}
+
+int ListLength_S(SLinklist L)
+{
+    return L.length;
+}
+
+void PrintList_S(SLinklist L)
+{
+    for (SIndex p = L.node[0].next; p; p = L.node[p].next)
+    {
+        printf("%d", L.node[p].data);
+
+        if (L.node[p].next)
+        {
+            printf("->");
+        }
+    }
+
+    printf("\n");
+}
+
+Status SaveList_S(SLinklist L, FILE *fp)
+{
+    if (WriteListHeader(fp, (size_t)L.length) != OK)
+    {
+        return ERROR;
+    }
+
+    return WriteListSlots(fp, L.node, sizeof(SNode), L.node[0].next,
+                          offsetof(SNode, next));
+}
+
+Status LoadList_S(SLinklist *L, FILE *fp)
+{
+    size_t n;
+
+    /* 加上头结点, 加倍后的容量仍不能超过 32 位下标. */
+    if (ReadListHeader(fp, &n) != OK || n > INT_MAX ||
+        n >= UINT32_MAX / 2)
+    {
+        return ERROR;
+    }
+
+    SIndex listsize = SLIST_INIT_SIZE;
+    while (listsize <= n)
+    {
+        listsize *= 2;
+    }
+
+    L->node = malloc(sizeof(SNode) * (size_t)listsize);
+    /* 内存分配失败. */
+    if (!L->node)
+    {
+        exit(OVERFLOW);
+    }
+    L->listsize = listsize;
+
+    /* 元素依次放入 1..n 号结点, 数据域在结点开头, 按结点大小跨步读入. */
+    if (ReadListData(fp, L->node + 1, n, sizeof(SNode)) != OK)
+    {
+        DestroyList_S(L);
+        return ERROR;
+    }
+
+    for (SIndex k = 0; k <= n; ++k)
+    {
+        L->node[k].next = k < n ? k + 1 : 0;
+        L->node[k].prior = k > 0 ? k - 1 : (SIndex)n;
+    }
+    L->node[0].data = 0;
+
+    L->length = (int)n;
+    L->top = (SIndex)n + 1;
+    L->free = 0;
+
+    return OK;
+}
@@ -0,0 +1,303 @@
+﻿/**
+ * @file ulinklist.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 单向展开链表方法实现.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <string.h>
+
+#include <linearlist/linklist/ulinklist.h>
+
+/* 结点不足这么多元素时尝试与后继合并. */
+#define UNODE_MIN_COUNT ((int)UNODE_CAPACITY / 2)
+
+/* 新建一个空结点, 接在 prev 之后; prev 为 NULL 时作为第一个结点. */
+static UNode *NewNode(ULinklist L, UNode *prev)
+{
+    UNode *s = NodePoolAlloc(L->pool);
+
+    s->count = 0;
+
+    if (prev)
+    {
+        s->next = prev->next;
+        prev->next = s;
+    }
+    else
+    {
+        s->next = L->first;
+        L->first = s;
+    }
+    if (L->last == prev)
+    {
+        L->last = s;
+    }
+
+    ++L->nodes;
+
+    return s;
+}
+
+/**
+ * @brief 定位第 i 个元素 (从 0 开始) 所在的结点.
+ * @param i 取值范围 0 <= i < length.
+ * @param prev 用以返回该结点的前驱, 第一个结点的前驱为 NULL.
+ * @param offset 用以返回元素在结点中的下标.
+ */
+static UNode *Locate(ULinklist L, int i, UNode **prev, int *offset)
+{
+    UNode *pre = NULL, *p = L->first;
+
+    /* 每个结点只比较一次元素个数, 不访问结点中的元素. */
+    while (i >= p->count)
+    {
+        i -= p->count;
+        pre = p;
+        p = p->next;
+    }
+
+    *prev = pre;
+    *offset = i;
+
+    return p;
+}
+
+/* 把结点 p 的后一半元素移到新建的后继结点中. */
+static UNode *Split(ULinklist L, UNode *p)
+{
+    UNode *q = NewNode(L, p);
+    int half = p->count / 2;
+
+    q->count = p->count - half;
+    memcpy(q->elem, p->elem + half, sizeof(ElemType) * (size_t)q->count);
+    p->count = half;
+
+    return q;
+}
+
+Status InitList_U(ULinklist *L)
+{
+    (*L) = malloc(sizeof(UList));
+    /* 内存分配失败. */
+    if (!(*L))
+    {
+        exit(OVERFLOW);
+    }
+
+    (*L)->first = (*L)->last = NULL;
+    (*L)->length = 0;
+    (*L)->nodes = 0;
+    (*L)->pool = CreateNodePool(sizeof(UNode));
+
+    return OK;
+}
+
+Status DestroyList_U(ULinklist *L)
+{
+    ReleaseNodePool((*L)->pool);
+    free(*L);
+    (*L) = NULL;
+
+    return OK;
+}
+
+Status HeadInsert_U(ULinklist L, ElemType e)
+{
+    UNode *p = L->first;
+
+    if (!p || p->count == (int)UNODE_CAPACITY)
+    {
+        p = NewNode(L, NULL);
+    }
+
+    memmove(p->elem + 1, p->elem, sizeof(ElemType) * (size_t)p->count);
+    p->elem[0] = e;
+    ++p->count;
+    ++L->length;
+
+    return OK;
+}
+
+Status TailInsert_U(ULinklist L, ElemType e)
+{
+    UNode *p = L->last;
+
+    if (!p || p->count == (int)UNODE_CAPACITY)
+    {
+        p = NewNode(L, p);
+    }
+
+    p->elem[p->count++] = e;
+    ++L->length;
+
+    return OK;
+}
+
+Status GetElem_U(ULinklist L, int i, ElemType *e)
+{
+    if (i < 1 || i > L->length)
+    {
+        printf("Index out of range.\n");
+        return ERROR;
+    }
+
+    UNode *prev;
+    int offset;
+    UNode *p = Locate(L, i - 1, &prev, &offset);
+
+    *e = p->elem[offset];
+
+    return OK;
+}
+
+int LocateElem_U(ULinklist L, ElemType e)
+{
+    int base = 0;
+
+    for (UNode *p = L->first; p; p = p->next)
+    {
+        /* 结点内是连续数组, 顺序扫描. */
+        for (int k = 0; k < p->count; ++k)
+        {
+            if (p->elem[k] == e)
+            {
+                return base + k + 1;
+            }
+        }
+        base += p->count;
+    }
+
+    return 0;
+}
+
+Status ListInsert_U(ULinklist L, int i, ElemType e)
+{
+    if (i < 1 || i > L->length + 1)
+    {
+        printf("Illegal insertion position.\n");
+        return ERROR;
+    }
+
+    /* 表尾插入没有要后移的元素. */
+    if (i == L->length + 1)
+    {
+        return TailInsert_U(L, e);
+    }
+
+    UNode *prev;
+    int offset;
+    UNode *p = Locate(L, i - 1, &prev, &offset);
+
+    /* 结点已满, 对半分裂后插入所在的一半. */
+    if (p->count == (int)UNODE_CAPACITY)
+    {
+        UNode *q = Split(L, p);
+        if (offset > p->count)
+        {
+            offset -= p->count;
+            p = q;
+        }
+    }
+
+    memmove(p->elem + offset + 1, p->elem + offset,
+            sizeof(ElemType) * (size_t)(p->count - offset));
+    p->elem[offset] = e;
+    ++p->count;
+    ++L->length;
+
+    return OK;
+}
+
+Status ListDelete_U(ULinklist L, int i, ElemType *e)
+{
+    if (i < 1 || i > L->length)
+    {
+        printf("Illegal deletion position.\n");
+        return ERROR;
+    }
+
+    UNode *prev;
+    int offset;
+    UNode *p = Locate(L, i - 1, &prev, &offset);
+
+    if (e)
+    {
+        *e = p->elem[offset];
+    }
+
+    memmove(p->elem + offset, p->elem + offset + 1,
+            sizeof(ElemType) * (size_t)(p->count - offset - 1));
+    --p->count;
+    --L->length;
+
+    if (p->count == 0)
+    {
+        /* 结点变空, 从链表中摘除. */
+        if (prev)
+        {
+            prev->next = p->next;
+        }
+        else
+        {
+            L->first = p->next;
+        }
+        if (L->last == p)
+        {
+            L->last = prev;
+        }
+
+        NodePoolFree(L->pool, p);
+        --L->nodes;
+    }
+    else if (p->count < UNODE_MIN_COUNT && p->next &&
+             p->count + p->next->count <= (int)UNODE_CAPACITY)
+    {
+        /* 不足半满, 且能装下后继结点的全部元素, 合并后摘除后继. */
+        UNode *q = p->next;
+
+        memcpy(p->elem + p->count, q->elem, sizeof(ElemType) * (size_t)q->count);
+        p->count += q->count;
+        p->next = q->next;
+        if (L->last == q)
+        {
+            L->last = p;
+        }
+
+        NodePoolFree(L->pool, q);
+        --L->nodes;
+    }
+
+    return OK;
+}
+
+int ListLength_U(ULinklist L)
+{
+    return L->length;
+}
+
+void PrintList_U(ULinklist L)
+{
+    for (UNode *p = L->first; p; p = p->next)
+    {
+        for (int k = 0; k < p->count; ++k)
+        {
+            printf("%d", p->elem[k]);
+
+            if (p->next == NULL && k == p->count - 1)
+            {
+                printf("\n");
+            }
+            else
+            {
+                printf("->");
+            }
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,819 @@
+﻿/**
+ * @file listbench.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 比较顺序表和各种链表的基本操作.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include <linearlist/linklist/clinklist.h>
+#include <linearlist/linklist/dclinklist.h>
+#include <linearlist/linklist/dlinklist.h>
+#include <linearlist/linklist/linklist.h>
+#include <linearlist/sqlist/sqlist.h>
+
+/* Linux 上用 perf_event_open 统计缓存缺失, 其他平台或无权限时不统计. */
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAVE_PERF_EVENT 1
+#else
+#define HAVE_PERF_EVENT 0
+#endif
+
+/* 被测的表的种数. */
+#define KINDS 5
+
+/* 被测的操作. */
+typedef enum BenchOp
+{
+    OP_HEAD_INSERT,
+    OP_TAIL_INSERT,
+    OP_INSERT,
+    OP_GET,
+    OP_LOCATE,
+    OP_DELETE,
+    OP_REVERSE,
+    OP_MERGE,
+    OP_TRAVERSE,
+    OPS
+} BenchOp;
+
+/* 行名带上计量单位: 单个元素的操作按次计, 整表操作按每个元素计. */
+static const char *opName[OPS] = {"headins/op",   "tailins/op", "midins/op",
+                                  "get/op",       "locate/op",  "delete/op",
+                                  "reverse/elem", "merge/elem", "traverse/elem"};
+
+/**
+ * 一种表的各项操作. 表用 void * 传递, 顺序表是 SqList 的指针, 链表是头指针.
+ * 没有提供的操作为 NULL, 结果表中显示为 "-".
+ */
+typedef struct ListKind
+{
+    const char *name;
+    void *(*Build)(const ElemType *a, int n);
+    void (*Destroy)(void *L);
+    void (*HeadInsert)(void *L, ElemType e);
+    void (*TailInsert)(void *L, ElemType e);
+    /* 在第 i 个元素之前插入. */
+    void (*Insert)(void *L, int i, ElemType e);
+    ElemType (*Get)(void *L, int i);
+    int (*Locate)(void *L, ElemType e);
+    void (*Delete)(void *L, int i);
+    void (*Reverse)(void *L);
+    /* 合并两个递增的表, 返回结果, A 和 B 随后由调用者销毁或已被销毁. */
+    void *(*Merge)(void **A, void **B);
+    long long (*Traverse)(void *L);
+    /* 表占用的字节数. */
+    size_t (*Bytes)(void *L);
+} ListKind;
+
+static double Now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 线性同余随机数, 各种表使用相同的位序和值序列. */
+static unsigned int NextKey(unsigned int *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+
+    return *seed >> 8;
+}
+
+/* 查找和遍历的结果累加到这里, 防止被优化掉. */
+static volatile long long sink;
+
+/* 缓存缺失计数器, 打不开时为 -1. */
+static int missCounter = -1;
+
+static void OpenCounter()
+{
+#if HAVE_PERF_EVENT
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    missCounter = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void StartCounter()
+{
+#if HAVE_PERF_EVENT
+    if (missCounter >= 0)
+    {
+        ioctl(missCounter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(missCounter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/* 停止计数并返回缓存缺失次数, 不能计数时返回 -1. */
+static double StopCounter()
+{
+#if HAVE_PERF_EVENT
+    unsigned long long count;
+
+    if (missCounter >= 0)
+    {
+        ioctl(missCounter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(missCounter, &count, sizeof(count)) == sizeof(count))
+        {
+            return (double)count;
+        }
+    }
+#endif
+
+    return -1;
+}
+
+/******************************** 顺序表 ********************************/
+
+static void *BuildSq(const ElemType *a, int n)
+{
+    SqList *L = malloc(sizeof(SqList));
+    if (!L)
+    {
+        exit(OVERFLOW);
+    }
+
+    InitList_Sq(L);
+    ListAppend_Sq(L, a, n);
+
+    return L;
+}
+
+static void DestroySq(void *L)
+{
+    DestoryList_Sq(L);
+    free(L);
+}
+
+static void HeadInsertSq(void *L, ElemType e)
+{
+    ListInsert_Sq(L, 1, e);
+}
+
+static void TailInsertSq(void *L, ElemType e)
+{
+    ListInsert_Sq(L, ((SqList *)L)->length + 1, e);
+}
+
+static void InsertSq(void *L, int i, ElemType e)
+{
+    ListInsert_Sq(L, i, e);
+}
+
+static ElemType GetSq(void *L, int i)
+{
+    ElemType e;
+
+    GetElem_Sq(*(SqList *)L, i, &e);
+
+    return e;
+}
+
+static int LocateSq(void *L, ElemType e)
+{
+    return LocateEqual_Sq(*(SqList *)L, e);
+}
+
+static void DeleteSq(void *L, int i)
+{
+    ElemType e;
+
+    ListDelete_Sq(L, i, &e);
+}
+
+static void ReverseSq(void *L)
+{
+    Reverse_Sq(L);
+}
+
+static void *MergeSq(void **A, void **B)
+{
+    SqList *C = BuildSq(NULL, 0);
+
+    Merge(*(SqList *)*A, *(SqList *)*B, C);
+
+    return C;
+}
+
+static long long TraverseSq(void *L)
+{
+    const SqList *Q = L;
+    long long sum = 0;
+
+    for (int i = 0; i < Q->length; ++i)
+    {
+        sum += Q->elem[i];
+    }
+
+    return sum;
+}
+
+static size_t BytesSq(void *L)
+{
+    return sizeof(SqList) + sizeof(ElemType) * (size_t)((SqList *)L)->listsize;
+}
+
+/******************************* 单向链表 *******************************/
+
+static void *BuildL(const ElemType *a, int n)
+{
+    Linklist L;
+
+    CreateList_L(&L, a, n);
+
+    return L;
+}
+
+static void DestroyL(void *L)
+{
+    Linklist P = L;
+
+    DestroyList_L(&P);
+}
+
+static void HeadInsertL(void *L, ElemType e)
+{
+    HeadInsert_L(L, e);
+}
+
+static void TailInsertL(void *L, ElemType e)
+{
+    TailInsert_L(L, e);
+}
+
+static void InsertL(void *L, int i, ElemType e)
+{
+    ListInsert_L(L, i, e);
+}
+
+static ElemType GetL(void *L, int i)
+{
+    return GetElem_L(L, i)->data;
+}
+
+static int LocateL(void *L, ElemType e)
+{
+    return LocateElem_L(L, e) != NULL;
+}
+
+static void DeleteL(void *L, int i)
+{
+    ListDelete_L(L, i);
+}
+
+static void ReverseL(void *L)
+{
+    Reverse_L1(L);
+}
+
+/* MergeList() 把 B 的结点并入 A 并销毁 B. */
+static void *MergeL(void **A, void **B)
+{
+    Linklist C = MergeList(*A, *B);
+
+    *A = *B = NULL;
+
+    return C;
+}
+
+static long long TraverseL(void *L)
+{
+    long long sum = 0;
+
+    for (LNode *p = ((Linklist)L)->next; p != NULL; p = p->next)
+    {
+        sum += p->data;
+    }
+
+    return sum;
+}
+
+static size_t BytesL(void *L)
+{
+    return sizeof(LNode) + NodePoolBytes(ListHeadPool(L));
+}
+
+/******************************* 双向链表 *******************************/
+
+static void *BuildD(const ElemType *a, int n)
+{
+    DLinklist L;
+
+    CreateList_D(&L, a, n);
+
+    return L;
+}
+
+static void DestroyD(void *L)
+{
+    DLinklist P = L;
+
+    DestroyList_D(&P);
+}
+
+static void HeadInsertD(void *L, ElemType e)
+{
+    HeadInsert_D(L, e);
+}
+
+static void TailInsertD(void *L, ElemType e)
+{
+    TailInsert_D(L, e);
+}
+
+static void InsertD(void *L, int i, ElemType e)
+{
+    DLinklist P = L;
+
+    ListInsert_D(&P, i, e);
+}
+
+static ElemType GetD(void *L, int i)
+{
+    return GetElem_D(L, i)->data;
+}
+
+static int LocateD(void *L, ElemType e)
+{
+    return LocateElem_D(L, e) != NULL;
+}
+
+static void DeleteD(void *L, int i)
+{
+    DLinklist P = L;
+
+    ListDelete_D(&P, i);
+}
+
+static long long TraverseD(void *L)
+{
+    long long sum = 0;
+
+    /* 尾结点不存数据. */
+    for (DNode *p = ((DLinklist)L)->next; p->next != NULL; p = p->next)
+    {
+        sum += p->data;
+    }
+
+    return sum;
+}
+
+static size_t BytesD(void *L)
+{
+    return sizeof(DNode) + NodePoolBytes(ListHeadPool(L));
+}
+
+/***************************** 单向循环链表 *****************************/
+
+static void *BuildC(const ElemType *a, int n)
+{
+    CLinklist L;
+
+    CreateList_C(&L, a, n);
+
+    return L;
+}
+
+static void DestroyC(void *L)
+{
+    CLinklist P = L;
+
+    DestroyList_C(&P);
+}
+
+static void HeadInsertC(void *L, ElemType e)
+{
+    HeadInsert_C(L, e);
+}
+
+static void TailInsertC(void *L, ElemType e)
+{
+    TailInsert_C(L, e);
+}
+
+static void InsertC(void *L, int i, ElemType e)
+{
+    ListInsert_C(L, i, e);
+}
+
+static ElemType GetC(void *L, int i)
+{
+    return GetElem_C(L, i)->data;
+}
+
+static int LocateC(void *L, ElemType e)
+{
+    return LocateElem_C(L, e) != NULL;
+}
+
+static void DeleteC(void *L, int i)
+{
+    ListDelete_C(L, i);
+}
+
+static long long TraverseC(void *L)
+{
+    CLinklist H = L;
+    long long sum = 0;
+
+    for (CNode *p = H->next; p != H; p = p->next)
+    {
+        sum += p->data;
+    }
+
+    return sum;
+}
+
+static size_t BytesC(void *L)
+{
+    return sizeof(CNode) + NodePoolBytes(ListHeadPool(L));
+}
+
+/***************************** 双向循环链表 *****************************/
+
+static void *BuildDC(const ElemType *a, int n)
+{
+    DCLinklist L;
+
+    CreateList_DC(&L, a, n);
+
+    return L;
+}
+
+static void DestroyDC(void *L)
+{
+    DCLinklist P = L;
+
+    DestroyList_DC(&P);
+}
+
+static void HeadInsertDC(void *L, ElemType e)
+{
+    HeadInsert_DC(L, e);
+}
+
+static void TailInsertDC(void *L, ElemType e)
+{
+    TailInsert_DC(L, e);
+}
+
+static void InsertDC(void *L, int i, ElemType e)
+{
+    ListInsert_DC(L, i, e);
+}
+
+static ElemType GetDC(void *L, int i)
+{
+    return GetElem_DC(L, i)->data;
+}
+
+static int LocateDC(void *L, ElemType e)
+{
+    return LocateElem_DC(L, e) != NULL;
+}
+
+static void DeleteDC(void *L, int i)
+{
+    ListDelete_DC(L, i);
+}
+
+static long long TraverseDC(void *L)
+{
+    DCLinklist H = L;
+    long long sum = 0;
+
+    for (DCNode *p = H->next; p != H; p = p->next)
+    {
+        sum += p->data;
+    }
+
+    return sum;
+}
+
+static size_t BytesDC(void *L)
+{
+    return sizeof(DCNode) + NodePoolBytes(ListHeadPool(L));
+}
+
+static const ListKind kind[KINDS] = {
+    {"SqList", BuildSq, DestroySq, HeadInsertSq, TailInsertSq, InsertSq, GetSq,
+     LocateSq, DeleteSq, ReverseSq, MergeSq, TraverseSq, BytesSq},
+    {"Linklist", BuildL, DestroyL, HeadInsertL, TailInsertL, InsertL, GetL,
+     LocateL, DeleteL, ReverseL, MergeL, TraverseL, BytesL},
+    {"DLinklist", BuildD, DestroyD, HeadInsertD, TailInsertD, InsertD, GetD,
+     LocateD, DeleteD, NULL, NULL, TraverseD, BytesD},
+    {"CLinklist", BuildC, DestroyC, HeadInsertC, TailInsertC, InsertC, GetC,
+     LocateC, DeleteC, NULL, NULL, TraverseC, BytesC},
+    {"DCLinklist", BuildDC, DestroyDC, HeadInsertDC, TailInsertDC, InsertDC,
+     GetDC, LocateDC, DeleteDC, NULL, NULL, TraverseDC, BytesDC},
+};
+
+/* 一次测量的结果, 均按每次操作 (整表操作按每个元素) 计. */
+typedef struct Result
+{
+    double ns;
+    double misses;
+} Result;
+
+/**
+ * @brief 在长为 n 的表上测量操作 op. a 是递增的元素, 值都不小于 0, 因为有的
+ * 链表用 -1 标记头尾结点. 改变表的操作在新建的表上进行, 建表不计时.
+ */
+static Result Measure(const ListKind *K, BenchOp op, const ElemType *a, int n)
+{
+    /**
+     * 单个元素的操作重复 reps 次, 表长至多变化 10%; O(n) 的操作在长表上
+     * 少做几次, 使每一项的总工作量相近. 整表操作重复 rounds 次.
+     */
+    int reps = n / 10 < 40000000 / n ? n / 10 : 40000000 / n;
+    int rounds = 10000000 / n;
+    unsigned int seed = 1;
+    double elapsed = 0, misses = 0;
+    Result r = {-1, -1};
+
+    reps = reps > 0 ? reps : 1;
+    rounds = rounds > 0 ? rounds : 1;
+
+    if ((op == OP_REVERSE && !K->Reverse) || (op == OP_MERGE && !K->Merge))
+    {
+        return r;
+    }
+
+    if (op == OP_MERGE)
+    {
+        /* 偶数位和奇数位的元素各成一个递增的表, 合并后为 a. */
+        int m = n / 2;
+        ElemType *b = malloc(sizeof(ElemType) * (size_t)(n - m + 1));
+        ElemType *c = malloc(sizeof(ElemType) * (size_t)(n - m + 1));
+        if (!b || !c)
+        {
+            exit(OVERFLOW);
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            (i % 2 ? c : b)[i / 2] = a[i];
+        }
+
+        for (int k = 0; k < rounds; ++k)
+        {
+            void *A = K->Build(b, n - m);
+            void *B = K->Build(c, m);
+
+            double start = Now();
+            StartCounter();
+            void *C = K->Merge(&A, &B);
+            misses += StopCounter();
+            elapsed += Now() - start;
+
+            sink += K->Traverse(C);
+            K->Destroy(C);
+            if (A)
+            {
+                K->Destroy(A);
+            }
+            if (B)
+            {
+                K->Destroy(B);
+            }
+        }
+
+        free(b);
+        free(c);
+        r.ns = elapsed / rounds / n * 1e9;
+        r.misses = misses < 0 ? -1 : misses / rounds / n;
+
+        return r;
+    }
+
+    void *L = K->Build(a, n);
+    int count = op == OP_REVERSE || op == OP_TRAVERSE ? rounds : reps;
+
+    double start = Now();
+    StartCounter();
+
+    switch (op)
+    {
+    case OP_HEAD_INSERT:
+        for (int k = 0; k < reps; ++k)
+        {
+            K->HeadInsert(L, a[k]);
+        }
+        break;
+    case OP_TAIL_INSERT:
+        for (int k = 0; k < reps; ++k)
+        {
+            K->TailInsert(L, a[k]);
+        }
+        break;
+    case OP_INSERT:
+        for (int k = 0; k < reps; ++k)
+        {
+            K->Insert(L, (n + k) / 2 + 1, a[k]);
+        }
+        break;
+    case OP_GET:
+        for (int k = 0; k < reps; ++k)
+        {
+            sink += K->Get(L, (int)(NextKey(&seed) % (unsigned int)n) + 1);
+        }
+        break;
+    case OP_LOCATE:
+        for (int k = 0; k < reps; ++k)
+        {
+            sink += K->Locate(L, a[NextKey(&seed) % (unsigned int)n]);
+        }
+        break;
+    case OP_DELETE:
+        for (int k = 0; k < reps; ++k)
+        {
+            K->Delete(L, (n - k) / 2 + 1);
+        }
+        break;
+    case OP_REVERSE:
+        for (int k = 0; k < rounds; ++k)
+        {
+            K->Reverse(L);
+        }
+        break;
+    case OP_TRAVERSE:
+        for (int k = 0; k < rounds; ++k)
+        {
+            sink += K->Traverse(L);
+        }
+        break;
+    default:
+        break;
+    }
+
+    misses = StopCounter();
+    elapsed = Now() - start;
+
+    /* 整表操作按每个元素计. */
+    int per = op == OP_REVERSE || op == OP_TRAVERSE ? n : 1;
+    r.ns = elapsed / count / per * 1e9;
+    r.misses = misses < 0 ? -1 : misses / count / per;
+
+    K->Destroy(L);
+
+    return r;
+}
+
+/* 建表后检查各种表的内容与 a 相同, 排除被测的表本身有误. */
+static void Check(const ElemType *a, int n)
+{
+    long long expect = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        expect += a[i];
+    }
+
+    for (int k = 0; k < KINDS; ++k)
+    {
+        void *L = kind[k].Build(a, n);
+
+        if (kind[k].Traverse(L) != expect ||
+            kind[k].Get(L, n) != a[n - 1])
+        {
+            fprintf(stderr, "listbench: %s built wrong\n", kind[k].name);
+            exit(1);
+        }
+
+        kind[k].Destroy(L);
+    }
+}
+
+static void PrintRow(const char *name, const double value[KINDS],
+                     const char *format)
+{
+    printf("%-13s", name);
+    for (int k = 0; k < KINDS; ++k)
+    {
+        if (value[k] < 0)
+        {
+            printf(" %11s", "-");
+        }
+        else
+        {
+            printf(format, value[k]);
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * 用法: listbench [n ...]. 对每个长度 n, 输出各种表每项操作的纳秒数, 能够
+ * 使用 perf_event_open 时再输出每项操作的缓存缺失次数, 最后是每个元素占用
+ * 的字节数. 单个元素的操作 (插入, 读取, 查找, 删除) 按次计, 位置随机或在
+ * 表中间, 行名以 /op 结尾; 整表操作 (逆置, 合并, 遍历) 按每个元素计, 行名以
+ * /elem 结尾. 链表都由 CreateList_X() 一次建成, 结点在内存中按表中顺序
+ * 排列, 是链表最有利的情形.
+ */
+int main(int argc, char *argv[])
+{
+    static const int defaultLength[] = {1000, 10000, 100000, 1000000};
+    int count = argc > 1 ? argc - 1 : 4;
+
+    OpenCounter();
+
+    for (int c = 0; c < count; ++c)
+    {
+        int n = argc > 1 ? atoi(argv[c + 1]) : defaultLength[c];
+        if (n < 2 || n > 100000000)
+        {
+            fprintf(stderr, "usage: listbench [n ...], 2 <= n <= 10^8\n");
+            return 1;
+        }
+
+        ElemType *a = malloc(sizeof(ElemType) * (size_t)n);
+        if (!a)
+        {
+            exit(OVERFLOW);
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            a[i] = 2 * i;
+        }
+        Check(a, n);
+
+        Result r[OPS][KINDS];
+        double value[KINDS];
+
+        for (int op = 0; op < OPS; ++op)
+        {
+            for (int k = 0; k < KINDS; ++k)
+            {
+                r[op][k] = Measure(&kind[k], (BenchOp)op, a, n);
+            }
+        }
+
+        printf("n = %d, ns\n%-13s", n, "op");
+        for (int k = 0; k < KINDS; ++k)
+        {
+            printf(" %11s", kind[k].name);
+        }
+        printf("\n");
+        for (int op = 0; op < OPS; ++op)
+        {
+            for (int k = 0; k < KINDS; ++k)
+            {
+                value[k] = r[op][k].ns;
+            }
+            PrintRow(opName[op], value, " %11.1f");
+        }
+
+        if (missCounter >= 0)
+        {
+            printf("cache misses\n");
+            for (int op = 0; op < OPS; ++op)
+            {
+                for (int k = 0; k < KINDS; ++k)
+                {
+                    value[k] = r[op][k].misses;
+                }
+                PrintRow(opName[op], value, " %11.2f");
+            }
+        }
+
+        for (int k = 0; k < KINDS; ++k)
+        {
+            void *L = kind[k].Build(a, n);
+            value[k] = (double)kind[k].Bytes(L) / n;
+            kind[k].Destroy(L);
+        }
+        PrintRow("bytes/elem", value, " %11.2f");
+        printf("\n");
+
+        free(a);
+    }
+
+    if (missCounter < 0)
+    {
+        printf("cache misses: perf_event_open unavailable\n");
+    }
+
+    return 0;
+}
@@ -9,17 +9,30 @@
  * 
  */
 
+#include <linearlist/linklist/cache.h>
 #include <linearlist/linklist/clinklist.h>
 #include <linearlist/linklist/dclinklist.h>
 #include <linearlist/linklist/dlinklist.h>
+#include <linearlist/linklist/hooklist.h>
 #include <linearlist/linklist/linklist.h>
+#include <linearlist/linklist/plinklist.h>
+#include <linearlist/linklist/slinklist.h>
+#include <linearlist/linklist/ulinklist.h>
+#include <linearlist/sqlist/gapbuffer.h>
+#include <linearlist/sqlist/piecetable.h>
 #include <linearlist/sqlist/sqlist.h>
 
 void UseSqlist();
 void UseLinklist();
 void UseCLinklist();
 void UseDLinklist();
+void UseCache();
 void UseDCLinklist();
+void UseSLinklist();
+void UseEditBuffer();
+void UseULinklist();
+void UsePLinklist();
+void UseHookList();
 Status MyCompare(ElemType e1, ElemType e2);
 
 int main()
@@ -32,10 +45,20 @@ int main()
 
     /* UseDLinklist(); */
 
+    /* UseCache(); */
+
     /* UseDCLinklist(); */
 
     /* UseSLinklist(); */
 
+    /* UseEditBuffer(); */
+
+    /* UseULinklist(); */
+
+    /* UsePLinklist(); */
+
+    /* UseHookList(); */
+
     system("pause");
 
     return 0;
@@ -74,6 +97,35 @@ void UseSqlist()
 
     PrintList_Sq(C);
 
+    printf("测试ListAppend_Sq()\n");
+
+    /* 一次追加一个数组, 空间不足时倍增扩充. */
+    ElemType arr[1000];
+    for (int i = 0; i < 1000; ++i)
+    {
+        arr[i] = i;
+    }
+    for (int k = 0; k < 1000; ++k)
+    {
+        ListAppend_Sq(&C, arr, 1000);
+    }
+    printf("length = %d, listsize = %d\n", ListLength_Sq(C), C.listsize);
+
+    printf("测试LocateEqual_Sq()/DelX()\n");
+
+    printf("999 位于 %d, [500, 600] 起于 %d\n", LocateEqual_Sq(C, 999),
+           LocateRange_Sq(C, 500, 600));
+    DelX(&C, 0);
+    printf("length = %d\n", ListLength_Sq(C));
+
+    ListDeleteRange_Sq(&C, 11, ListLength_Sq(C) - 10);
+    ListShrink_Sq(&C);
+    PrintList_Sq(C);
+
+    DestoryList_Sq(&A);
+    DestoryList_Sq(&B);
+    DestoryList_Sq(&C);
+
     return;
 }
 
@@ -159,6 +211,30 @@ void UseDLinklist()
     return;
 }
 
+void UseCache()
+{
+    Cache C;
+
+    /* 与 LccateElem_D2() 相同的访问序列, 容量为 3 时 5 被淘汰. */
+    InitCache(&C, 3, CACHE_LFU, NULL, NULL);
+
+    CachePut(&C, 1, NULL);
+    CachePut(&C, 2, NULL);
+    CachePut(&C, 3, NULL);
+    CacheGet(&C, 1, NULL);
+    CacheGet(&C, 2, NULL);
+    CachePut(&C, 5, NULL);
+    CachePut(&C, 4, NULL);
+
+    printf("1 的访问次数 %llu, 5 %s\n", CacheFrequency(&C, 1),
+           CacheGet(&C, 5, NULL) ? "命中" : "已被淘汰");
+    PrintCacheStat(&C);
+
+    DestroyCache(&C);
+
+    return;
+}
+
 void UseDCLinklist()
 {
     DCLinklist L;
@@ -185,6 +261,163 @@ void UseDCLinklist()
     return;
 }
 
+void UseSLinklist()
+{
+    SLinklist L;
+
+    InitList_S(&L);
+
+    TailInsert_S(&L, 2);
+    TailInsert_S(&L, 3);
+    HeadInsert_S(&L, 1);
+    ListInsert_S(&L, 4, 4);
+
+    /* 同一个下标只能删除一次, 第二次返回 ERROR, 表不变. */
+    SIndex k = LocateElem_S(L, 2);
+    NodeDelete_S(&L, k);
+    if (NodeDelete_S(&L, k) == ERROR)
+    {
+        printf("slot %u already free\n", (unsigned int)k);
+    }
+
+    /* 删除的结点留在空闲链上, 下一次插入复用它的下标. */
+    TailInsert_S(&L, 5);
+
+    PrintList_S(L);
+    printf("length = %d, 4 位于下标 %u\n", ListLength_S(L),
+           (unsigned int)LocateElem_S(L, 4));
+
+    DestroyList_S(&L);
+
+    return;
+}
+
+void UseEditBuffer()
+{
+    GapBuffer G;
+    PieceTable P;
+    ElemType e[] = {1, 2, 3, 4, 5};
+
+    InitList_GB(&G);
+    InitList_PT(&P, e, 5);
+    ListInsertRange_GB(&G, 1, e, 5);
+
+    /* 在光标处连续插入, 再删去光标前的一个元素. */
+    for (int i = 0; i < 3; ++i)
+    {
+        ListInsert_GB(&G, 3 + i, 10 + i);
+        ListInsert_PT(&P, 3 + i, 10 + i);
+    }
+    ListDeleteRange_GB(&G, 5, 1);
+    ListDeleteRange_PT(&P, 5, 1);
+
+    printf("测试GapBuffer\n");
+    PrintList_GB(G);
+    printf("测试PieceTable, 共 %d 个片段\n", P.pieceCount);
+    PrintList_PT(P);
+
+    DestroyList_GB(&G);
+    DestroyList_PT(&P);
+
+    return;
+}
+
+void UseULinklist()
+{
+    ULinklist L;
+    ElemType e;
+
+    InitList_U(&L);
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        TailInsert_U(L, i);
+    }
+
+    /* 在第一个结点中间插入, 结点满时对半分裂. */
+    ListInsert_U(L, 10, 0);
+    ListDelete_U(L, 50, &e);
+
+    printf("length = %d, nodes = %d, 0 位于 %d\n", ListLength_U(L), L->nodes,
+           LocateElem_U(L, 0));
+    PrintList_U(L);
+
+    DestroyList_U(&L);
+
+    return;
+}
+
+void UsePLinklist()
+{
+    PList L, S;
+    ElemType a[] = {1, 2, 3, 4, 5};
+
+    CreateList_P(&L, a, 5);
+
+    /* 快照与 L 共享全部结点, 此后修改 L 只复制修改位置之前的结点. */
+    Snapshot_P(&L, &S);
+    SetElem_P(&L, 2, 20);
+    ListDelete_P(&L, 4, NULL);
+    HeadInsert_P(&L, 0);
+
+    PrintList_P(&L);
+    PrintList_P(&S);
+
+    DestroyList_P(&L);
+    DestroyList_P(&S);
+
+    return;
+}
+
+/* 同时属于两个链表的记录: 按到达顺序排队, 并按分数挂在两个等级之一. */
+typedef struct Student
+{
+    int id;
+    int score;
+    SHook arrival;
+    DHook grade;
+} Student;
+
+DEFINE_CLIST(ArrivalQueue, Student, arrival)
+DEFINE_DLIST(GradeList, Student, grade)
+
+void UseHookList()
+{
+    Student s[6] = {
+        {.id = 1, .score = 90}, {.id = 2, .score = 55}, {.id = 3, .score = 72},
+        {.id = 4, .score = 48}, {.id = 5, .score = 99}, {.id = 6, .score = 60}};
+    ArrivalQueue Q;
+    GradeList pass, fail;
+    Student *x;
+
+    Init_ArrivalQueue(&Q);
+    Init_GradeList(&pass);
+    Init_GradeList(&fail);
+
+    /* 记录本身就是结点, 加入链表不需要分配内存. */
+    for (int i = 0; i < 6; ++i)
+    {
+        PushBack_ArrivalQueue(&Q, &s[i]);
+        PushBack_GradeList(s[i].score >= 60 ? &pass : &fail, &s[i]);
+    }
+
+    /* 补考通过: 从不及格链表中 O(1) 摘下, 它在队列中的位置不变. */
+    Remove_GradeList(&s[1]);
+    PushBack_GradeList(&pass, &s[1]);
+
+    FOREACH_HOOK(ArrivalQueue, &Q, x)
+    {
+        printf("%d%s", x->id, Next_ArrivalQueue(&Q, x) ? "->" : "\n");
+    }
+    FOREACH_HOOK(GradeList, &pass, x)
+    {
+        printf("%d(%d)%s", x->id, x->score,
+               Next_GradeList(&pass, x) ? "->" : "\n");
+    }
+
+    return;
+}
+
 Status MyCompare(ElemType e1, ElemType e2)
 {
     if (e1 == e2)
@@ -0,0 +1,194 @@
+﻿/**
+ * @file ropebench.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 比较顺序表, 单向链表, 展开链表和绳的按位序操作.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include <linearlist/linklist/linklist.h>
+#include <linearlist/linklist/rope.h>
+#include <linearlist/linklist/ulinklist.h>
+#include <linearlist/sqlist/sqlist.h>
+
+static double Now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 线性同余随机数, 各种表使用相同的位序序列. */
+static unsigned int NextKey(unsigned int *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+
+    return *seed >> 8;
+}
+
+/**
+ * 用法: ropebench [n] [ops]. 四种表都先装入 n 个元素, 然后各做 ops 次随机
+ * 位置的插入, 读取和删除, 输出每次操作的纳秒数. 删除与插入次数相同, 表长
+ * 保持在 n 左右, 最后比较四种表的内容.
+ */
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int ops = argc > 2 ? atoi(argv[2]) : 1000;
+
+    if (n < 1 || ops < 1)
+    {
+        fprintf(stderr, "usage: ropebench [n] [ops]\n");
+        return 1;
+    }
+
+    ElemType *a = malloc(sizeof(ElemType) * (size_t)(n + ops));
+    ElemType *b = malloc(sizeof(ElemType) * (size_t)(n + ops));
+    if (!a || !b)
+    {
+        exit(OVERFLOW);
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        a[i] = i;
+    }
+
+    SqList Q;
+    Linklist L;
+    ULinklist U;
+    Rope R;
+
+    InitList_Sq(&Q);
+    ListAppend_Sq(&Q, a, n);
+    CreateList_L(&L, a, n);
+    InitList_U(&U);
+    for (int i = 0; i < n; ++i)
+    {
+        TailInsert_U(U, a[i]);
+    }
+    CreateList_R(&R, a, n);
+
+    const char *name[4] = {"SqList", "Linklist", "UList", "Rope"};
+    double t[3][4];
+    long long sum[4] = {0};
+
+    for (int s = 0; s < 4; ++s)
+    {
+        unsigned int seed = 1;
+        double start = Now();
+        for (int k = 0; k < ops; ++k)
+        {
+            int i = (int)(NextKey(&seed) % (unsigned int)(n + k + 1)) + 1;
+            switch (s)
+            {
+            case 0:
+                ListInsert_Sq(&Q, i, -k);
+                break;
+            case 1:
+                ListInsert_L(L, i, -k);
+                break;
+            case 2:
+                ListInsert_U(U, i, -k);
+                break;
+            default:
+                ListInsert_R(&R, i, -k);
+            }
+        }
+        t[0][s] = (Now() - start) / ops;
+
+        seed = 2;
+        start = Now();
+        for (int k = 0; k < ops; ++k)
+        {
+            int i = (int)(NextKey(&seed) % (unsigned int)(n + ops)) + 1;
+            ElemType e;
+            switch (s)
+            {
+            case 0:
+                GetElem_Sq(Q, i, &e);
+                break;
+            case 1:
+                e = GetElem_L(L, i)->data;
+                break;
+            case 2:
+                GetElem_U(U, i, &e);
+                break;
+            default:
+                GetElem_R(&R, i, &e);
+            }
+            sum[s] += e;
+        }
+        t[1][s] = (Now() - start) / ops;
+
+        seed = 3;
+        start = Now();
+        for (int k = 0; k < ops; ++k)
+        {
+            int i = (int)(NextKey(&seed) % (unsigned int)(n + ops - k)) + 1;
+            ElemType e;
+            switch (s)
+            {
+            case 0:
+                ListDelete_Sq(&Q, i, &e);
+                break;
+            case 1:
+                ListDelete_L(L, i);
+                break;
+            case 2:
+                ListDelete_U(U, i, &e);
+                break;
+            default:
+                ListDelete_R(&R, i, &e);
+            }
+        }
+        t[2][s] = (Now() - start) / ops;
+    }
+
+    printf("n = %d, ops = %d\n", n, ops);
+    printf("%-12s", "ns/op");
+    for (int s = 0; s < 4; ++s)
+    {
+        printf(" %12s", name[s]);
+    }
+    printf("\n");
+
+    const char *op[3] = {"ListInsert", "GetElem", "ListDelete"};
+    for (int k = 0; k < 3; ++k)
+    {
+        printf("%-12s", op[k]);
+        for (int s = 0; s < 4; ++s)
+        {
+            printf(" %12.1f", t[k][s] * 1e9);
+        }
+        printf("\n");
+    }
+
+    /* 四种表经过相同的操作, 读到的元素和最后的内容都应当相同. */
+    int m = ListToArray_R(&R, b, n + ops);
+    ListToArray_L(L, a, n + ops);
+    if (sum[0] != sum[1] || sum[0] != sum[2] || sum[0] != sum[3] ||
+        m != Q.length || ListLength_L(L) != m || ListLength_U(U) != m ||
+        memcmp(a, b, sizeof(ElemType) * (size_t)m) != 0 ||
+        memcmp(Q.elem, b, sizeof(ElemType) * (size_t)m) != 0)
+    {
+        fprintf(stderr, "ropebench: results differ\n");
+        return 1;
+    }
+
+    DestoryList_Sq(&Q);
+    DestroyList_L(&L);
+    DestroyList_U(&U);
+    DestroyList_R(&R);
+    free(a);
+    free(b);
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+﻿/**
+ * @file skipbench.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 比较跳表和有序单向链表的查找与范围删除.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include <linearlist/linklist/linklist.h>
+#include <linearlist/linklist/skiplist.h>
+
+static double Now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 线性同余随机数, 两种表使用相同的查询序列. */
+static unsigned int NextKey(unsigned int *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+
+    return *seed >> 8;
+}
+
+static void Report(const char *op, double linklist, double skiplist)
+{
+    printf("%-14s %12.1f %12.1f %10.2fx\n", op, linklist * 1e9, skiplist * 1e9,
+           skiplist > 0 ? linklist / skiplist : 0.0);
+}
+
+/**
+ * 用法: skipbench [n] [queries]. 两种表都存放 0, 2, ..., 2(n - 1), 然后比较
+ * 随机查找和宽度为 16 的随机范围删除每次操作的纳秒数.
+ */
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int queries = argc > 2 ? atoi(argv[2]) : 2000;
+
+    if (n < 1 || queries < 1)
+    {
+        fprintf(stderr, "usage: skipbench [n] [queries]\n");
+        return 1;
+    }
+
+    Linklist L;
+    SkipList S;
+    unsigned int seed;
+    long long found = 0;
+    double start, l, s;
+
+    /* 有序单向链表从大到小头插, 每次 O(1). */
+    InitList_L(&L);
+    start = Now();
+    for (int i = n - 1; i >= 0; --i)
+    {
+        HeadInsert_L(L, 2 * i);
+    }
+    l = (Now() - start) / n;
+
+    /* 跳表按随机顺序插入. */
+    int *key = malloc(sizeof(int) * n);
+    if (!key)
+    {
+        exit(OVERFLOW);
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        key[i] = 2 * i;
+    }
+    seed = 1;
+    for (int i = n - 1; i > 0; --i)
+    {
+        int j = (int)(NextKey(&seed) % (unsigned int)(i + 1));
+        int t = key[i];
+        key[i] = key[j];
+        key[j] = t;
+    }
+
+    InitList_SK(&S);
+    start = Now();
+    for (int i = 0; i < n; ++i)
+    {
+        Insert_SK(&S, key[i]);
+    }
+    s = (Now() - start) / n;
+    free(key);
+
+    printf("n = %d, queries = %d\n", n, queries);
+    printf("%-14s %12s %12s %11s\n", "ns/op", "Linklist", "SkipList", "speedup");
+    Report("build", l, s);
+
+    seed = 2;
+    start = Now();
+    for (int i = 0; i < queries; ++i)
+    {
+        found += LocateElem_L(L, (ElemType)(NextKey(&seed) % (2u * n))) != NULL;
+    }
+    l = (Now() - start) / queries;
+
+    seed = 2;
+    start = Now();
+    for (int i = 0; i < queries; ++i)
+    {
+        found -= LocateElem_SK(&S, (ElemType)(NextKey(&seed) % (2u * n))) != NULL;
+    }
+    s = (Now() - start) / queries;
+    Report("LocateElem", l, s);
+
+    /* 每次删除 (min, min + 16) 内至多 7 个元素. */
+    seed = 3;
+    start = Now();
+    for (int i = 0; i < queries; ++i)
+    {
+        ElemType min = (ElemType)(NextKey(&seed) % (2u * n));
+        RangeDelete(L, min, min + 16);
+    }
+    l = (Now() - start) / queries;
+
+    seed = 3;
+    start = Now();
+    for (int i = 0; i < queries; ++i)
+    {
+        ElemType min = (ElemType)(NextKey(&seed) % (2u * n));
+        RangeDelete_SK(&S, min, min + 16);
+    }
+    s = (Now() - start) / queries;
+    Report("RangeDelete", l, s);
+
+    /* 两种表的查找结果和删除后的长度应当一致. */
+    if (found != 0 || ListLength_L(L) != ListLength_SK(&S))
+    {
+        fprintf(stderr, "skipbench: results differ\n");
+        return 1;
+    }
+
+    DestroyList_L(&L);
+    DestroyList_SK(&S);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+﻿/**
+ * @file sortbench.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 比较链表的归并重链排序和数组排序.
+ * @version 0.2
+ * @date 2020-12-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <time.h>
+
+#include <linearlist/linklist/linklist.h>
+
+static double Now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 线性同余随机数, 两种方式排序相同的输入. */
+static unsigned int NextKey(unsigned int *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+
+    return *seed >> 8;
+}
+
+/* 沿链的顺序重新填入随机数, 链接不变. */
+static void Fill(Linklist L, unsigned int seed)
+{
+    for (LNode *p = L->next; p != NULL; p = p->next)
+    {
+        p->data = (ElemType)NextKey(&seed);
+    }
+}
+
+/* 检查非递减并返回数据之和, 两种方式的和应当相同. */
+static long long Check(Linklist L)
+{
+    long long sum = 0;
+
+    for (LNode *p = L->next; p != NULL; p = p->next)
+    {
+        if (p->next != NULL && p->next->data < p->data)
+        {
+            fprintf(stderr, "sortbench: list not sorted\n");
+            exit(1);
+        }
+        sum += p->data;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief 建立 n 个结点的表. scattered 为真时先对随机数归并一次, 打乱链的顺序.
+ */
+static Linklist Build(int n, int scattered)
+{
+    Linklist L;
+
+    InitList_L(&L);
+    for (int i = 0; i < n; ++i)
+    {
+        HeadInsert_L(L, 0);
+    }
+
+    if (scattered)
+    {
+        Fill(L, 7);
+        Sort_L(L, LIST_SORT_MERGE);
+    }
+
+    return L;
+}
+
+/* 在新建的表上按 mode 排序并返回每个结点的纳秒数. 归并会改变链接, 所以两种
+ * 方式各用一张布局相同的新表. */
+static double Time(int n, int scattered, ListSortMode mode, long long *sum)
+{
+    Linklist L = Build(n, scattered);
+    Fill(L, 1);
+
+    double start = Now();
+    Sort_L(L, mode);
+    double t = (Now() - start) / n * 1e9;
+
+    *sum = Check(L);
+    DestroyList_L(&L);
+
+    return t;
+}
+
+/**
+ * 用法: sortbench [n ...]. 每个长度比较两种结点布局: sequential 是刚从结点池
+ * 顺序分配的表, 链的顺序与内存顺序一致; scattered 是归并重链过一次的表,
+ * 链的顺序在内存中随机跳跃, 是长期使用之后链表的常态.
+ */
+int main(int argc, char *argv[])
+{
+    static const int defaultLength[] = {1000, 10000, 100000, 1000000};
+    int count = argc > 1 ? argc - 1 : 4;
+
+    printf("%-10s %-10s %12s %12s %10s\n", "n", "layout", "merge ns", "array ns",
+           "speedup");
+
+    for (int k = 0; k < count; ++k)
+    {
+        int n = argc > 1 ? atoi(argv[k + 1]) : defaultLength[k];
+        if (n < 1)
+        {
+            fprintf(stderr, "usage: sortbench [n ...]\n");
+            return 1;
+        }
+
+        for (int scattered = 0; scattered < 2; ++scattered)
+        {
+            long long mergeSum, arraySum;
+            double merge = Time(n, scattered, LIST_SORT_MERGE, &mergeSum);
+            double array = Time(n, scattered, LIST_SORT_ARRAY, &arraySum);
+
+            if (mergeSum != arraySum)
+            {
+                fprintf(stderr, "sortbench: results differ\n");
+                return 1;
+            }
+
+            printf("%-10d %-10s %12.1f %12.1f %9.2fx\n", n,
+                   scattered ? "scattered" : "sequential", merge, array,
+                   array > 0 ? merge / array : 0.0);
+        }
+    }
+
+    return 0;
+}
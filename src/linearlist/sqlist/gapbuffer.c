@@ -0,0 +1,222 @@
+﻿/**
+ * @file gapbuffer.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 间隙缓冲区方法实现.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include <linearlist/sqlist/gapbuffer.h>
+
+/* 间隙长度. */
+#define GAP_SIZE(G) ((G)->gapEnd - (G)->gapStart)
+
+Status InitList_GB(GapBuffer *G)
+{
+    G->elem = (ElemType *)malloc(sizeof(ElemType) * LIST_INIT_SIZE);
+    if (!G->elem)
+    {
+        exit(OVERFLOW);
+    }
+
+    G->gapStart = 0;
+    G->gapEnd = LIST_INIT_SIZE;
+    G->listsize = LIST_INIT_SIZE;
+
+    return OK;
+}
+
+Status DestroyList_GB(GapBuffer *G)
+{
+    free(G->elem);
+
+    G->elem = NULL;
+    G->gapStart = 0;
+    G->gapEnd = 0;
+    G->listsize = 0;
+
+    return OK;
+}
+
+int ListLength_GB(GapBuffer G)
+{
+    return G.listsize - (G.gapEnd - G.gapStart);
+}
+
+/**
+ * @brief 把间隙移到第 pos 个元素之后, 即间隙之前恰有 pos 个元素. 只搬移光标
+ * 原位置与新位置之间的元素.
+ */
+static void MoveGap(GapBuffer *G, int pos)
+{
+    if (pos < G->gapStart)
+    {
+        /* 光标左移, 间隙之前的 gapStart - pos 个元素搬到间隙之后. */
+        int n = G->gapStart - pos;
+        memmove(G->elem + G->gapEnd - n, G->elem + pos,
+                sizeof(ElemType) * (size_t)n);
+        G->gapStart -= n;
+        G->gapEnd -= n;
+    }
+    else if (pos > G->gapStart)
+    {
+        /* 光标右移, 间隙之后的 pos - gapStart 个元素搬到间隙之前. */
+        int n = pos - G->gapStart;
+        memmove(G->elem + G->gapStart, G->elem + G->gapEnd,
+                sizeof(ElemType) * (size_t)n);
+        G->gapStart += n;
+        G->gapEnd += n;
+    }
+}
+
+/**
+ * @brief 保证间隙长度不小于 n. 按倍增扩充, 间隙之后的元素搬到新空间的末尾.
+ */
+static void ReserveGap(GapBuffer *G, int n)
+{
+    if (GAP_SIZE(G) >= n)
+    {
+        return;
+    }
+
+    int length = ListLength_GB(*G);
+    int tail = G->listsize - G->gapEnd;
+    int newsize = G->listsize + LIST_INCREMENT;
+    if (G->listsize <= INT_MAX / 2 && newsize < 2 * G->listsize)
+    {
+        newsize = 2 * G->listsize;
+    }
+    if (newsize - length < n)
+    {
+        newsize = length + n;
+    }
+
+    ElemType *newbase = realloc(G->elem, sizeof(ElemType) * (size_t)newsize);
+    if (!newbase)
+    {
+        exit(OVERFLOW);
+    }
+
+    memmove(newbase + newsize - tail, newbase + G->gapEnd,
+            sizeof(ElemType) * (size_t)tail);
+
+    G->elem = newbase;
+    G->gapEnd = newsize - tail;
+    G->listsize = newsize;
+}
+
+Status GetElem_GB(GapBuffer G, int i, ElemType *e)
+{
+    if (i < 1 || i > ListLength_GB(G))
+    {
+        return ERROR;
+    }
+
+    /* 位于间隙之后的元素, 下标要跳过间隙. */
+    int k = i - 1;
+    if (k >= G.gapStart)
+    {
+        k += GAP_SIZE(&G);
+    }
+
+    *e = G.elem[k];
+
+    return OK;
+}
+
+Status ListInsert_GB(GapBuffer *G, int i, ElemType e)
+{
+    return ListInsertRange_GB(G, i, &e, 1);
+}
+
+Status ListInsertRange_GB(GapBuffer *G, int i, const ElemType *e, int n)
+{
+    int length = ListLength_GB(*G);
+
+    if (i < 1 || i > length + 1 || n < 0 || n > INT_MAX - length)
+    {
+        return ERROR;
+    }
+
+    MoveGap(G, i - 1);
+    ReserveGap(G, n);
+
+    /* 新元素填入间隙的前端. */
+    memcpy(G->elem + G->gapStart, e, sizeof(ElemType) * (size_t)n);
+    G->gapStart += n;
+
+    return OK;
+}
+
+Status ListDelete_GB(GapBuffer *G, int i, ElemType *e)
+{
+    if (GetElem_GB(*G, i, e) != OK)
+    {
+        return ERROR;
+    }
+
+    return ListDeleteRange_GB(G, i, 1);
+}
+
+Status ListDeleteRange_GB(GapBuffer *G, int i, int n)
+{
+    int length = ListLength_GB(*G);
+
+    if (i < 1 || i > length || n < 0 || n > length - i + 1)
+    {
+        return ERROR;
+    }
+
+    /* 间隙移到第 i 个元素之前, 再把其后的 n 个元素并入间隙. */
+    MoveGap(G, i - 1);
+    G->gapEnd += n;
+
+    return OK;
+}
+
+Status ListCopy_GB(GapBuffer G, int i, int n, ElemType *dst)
+{
+    int length = ListLength_GB(G);
+
+    if (i < 1 || i > length + 1 || n < 0 || n > length - i + 1)
+    {
+        return ERROR;
+    }
+
+    int k = i - 1;
+
+    /* 间隙之前的部分. */
+    if (k < G.gapStart)
+    {
+        int m = G.gapStart - k < n ? G.gapStart - k : n;
+        memcpy(dst, G.elem + k, sizeof(ElemType) * (size_t)m);
+        dst += m;
+        k += m;
+        n -= m;
+    }
+
+    /* 间隙之后的部分. */
+    memcpy(dst, G.elem + k + GAP_SIZE(&G), sizeof(ElemType) * (size_t)n);
+
+    return OK;
+}
+
+void PrintList_GB(GapBuffer G)
+{
+    for (int i = 0; i < G.gapStart; ++i)
+    {
+        printf("%d\n", G.elem[i]);
+    }
+    for (int i = G.gapEnd; i < G.listsize; ++i)
+    {
+        printf("%d\n", G.elem[i]);
+    }
+
+    return;
+}
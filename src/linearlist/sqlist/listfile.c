@@ -0,0 +1,428 @@
+﻿/**
+ * @file listfile.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 线性表二进制文件格式实现.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <linearlist/sqlist/listfile.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LIST_FILE_MMAP 1
+#else
+#define LIST_FILE_MMAP 0
+#endif
+
+#define LIST_FILE_BYTE_ORDER 0x01020304u
+
+/* 写链表和按步长读入时的缓冲区元素个数. */
+#define LIST_FILE_BUFFER 4096
+
+#define PRIME1 0x9E3779B185EBCA87ULL
+#define PRIME2 0xC2B2AE3D27D4EB4FULL
+#define PRIME3 0x165667B19E3779F9ULL
+
+static uint64_t Rotl(uint64_t x, int r)
+{
+    return x << r | x >> (64 - r);
+}
+
+/* 吸收 32 字节, 每路 8 字节. */
+static void Round(uint64_t acc[4], const void *block)
+{
+    uint64_t w[4];
+
+    memcpy(w, block, sizeof(w));
+    for (int j = 0; j < 4; ++j)
+    {
+        acc[j] = Rotl(acc[j] + w[j] * PRIME2, 31) * PRIME1;
+    }
+}
+
+void InitChecksum(ListChecksum *C)
+{
+    C->acc[0] = PRIME1 + PRIME2;
+    C->acc[1] = PRIME2;
+    C->acc[2] = 0;
+    C->acc[3] = 0 - PRIME1;
+    C->count = 0;
+    C->pendingCount = 0;
+}
+
+void UpdateChecksum(ListChecksum *C, const ElemType *e, size_t n)
+{
+    C->count += n;
+
+    /* 先补满上次剩下的不足 32 字节. */
+    if (C->pendingCount > 0)
+    {
+        while (n > 0 && C->pendingCount < 8)
+        {
+            C->pending[C->pendingCount++] = (uint32_t)*e++;
+            --n;
+        }
+        if (C->pendingCount < 8)
+        {
+            return;
+        }
+        Round(C->acc, C->pending);
+        C->pendingCount = 0;
+    }
+
+    for (; n >= 8; n -= 8, e += 8)
+    {
+        Round(C->acc, e);
+    }
+
+    while (n > 0)
+    {
+        C->pending[C->pendingCount++] = (uint32_t)*e++;
+        --n;
+    }
+}
+
+uint64_t FinishChecksum(const ListChecksum *C)
+{
+    uint64_t h = Rotl(C->acc[0], 1) + Rotl(C->acc[1], 7) +
+                 Rotl(C->acc[2], 12) + Rotl(C->acc[3], 18);
+
+    h += C->count * sizeof(ElemType);
+    for (int k = 0; k < C->pendingCount; ++k)
+    {
+        h ^= C->pending[k] * PRIME1;
+        h = Rotl(h, 23) * PRIME2 + PRIME3;
+    }
+
+    /* 雪崩, 使每个输入位影响全部输出位. */
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+/* 文件头中 headerChecksum 之前各字段的校验和. */
+static uint64_t HeaderChecksum(const ListFileHeader *H)
+{
+    ElemType w[offsetof(ListFileHeader, headerChecksum) / sizeof(ElemType)];
+    ListChecksum C;
+
+    memcpy(w, H, sizeof(w));
+    InitChecksum(&C);
+    UpdateChecksum(&C, w, sizeof(w) / sizeof(ElemType));
+
+    return FinishChecksum(&C);
+}
+
+/* 检查文件头, 用 count 返回元素个数. */
+static Status CheckHeader(const ListFileHeader *H, size_t *count)
+{
+    if (memcmp(H->magic, "LSTF", 4) != 0 || H->version != LIST_FILE_VERSION ||
+        H->headerSize != sizeof(ListFileHeader) ||
+        H->elemSize != sizeof(ElemType) ||
+        H->byteOrder != LIST_FILE_BYTE_ORDER ||
+        H->headerChecksum != HeaderChecksum(H) ||
+        H->count > SIZE_MAX / sizeof(ElemType) - sizeof(ListFileHeader))
+    {
+        return ERROR;
+    }
+
+    *count = (size_t)H->count;
+
+    return OK;
+}
+
+Status WriteListHeader(FILE *fp, size_t count)
+{
+    ListFileHeader H;
+
+    memset(&H, 0, sizeof(H));
+    memcpy(H.magic, "LSTF", 4);
+    H.version = LIST_FILE_VERSION;
+    H.headerSize = sizeof(ListFileHeader);
+    H.elemSize = sizeof(ElemType);
+    H.byteOrder = LIST_FILE_BYTE_ORDER;
+    H.count = count;
+    H.headerChecksum = HeaderChecksum(&H);
+
+    return fwrite(&H, sizeof(H), 1, fp) == 1 ? OK : ERROR;
+}
+
+Status WriteListArray(FILE *fp, const ElemType *e, size_t n)
+{
+    ListChecksum C;
+
+    InitChecksum(&C);
+    UpdateChecksum(&C, e, n);
+    uint64_t sum = FinishChecksum(&C);
+
+    if (fwrite(e, sizeof(ElemType), n, fp) != n ||
+        fwrite(&sum, sizeof(sum), 1, fp) != 1)
+    {
+        return ERROR;
+    }
+
+    return OK;
+}
+
+/* 计入校验和并写出缓冲区中的 k 个元素. */
+static Status FlushBuffer(FILE *fp, ListChecksum *C, const ElemType *buffer,
+                          size_t k)
+{
+    UpdateChecksum(C, buffer, k);
+
+    return fwrite(buffer, sizeof(ElemType), k, fp) == k ? OK : ERROR;
+}
+
+/* 写出缓冲区中剩余的元素和校验和. */
+static Status FinishBuffer(FILE *fp, ListChecksum *C, const ElemType *buffer,
+                           size_t k)
+{
+    if (FlushBuffer(fp, C, buffer, k) != OK)
+    {
+        return ERROR;
+    }
+
+    uint64_t sum = FinishChecksum(C);
+
+    return fwrite(&sum, sizeof(sum), 1, fp) == 1 ? OK : ERROR;
+}
+
+Status WriteListChain(FILE *fp, const void *first, const void *end,
+                      size_t nextOffset)
+{
+    ElemType buffer[LIST_FILE_BUFFER];
+    ListChecksum C;
+    size_t k = 0;
+
+    InitChecksum(&C);
+
+    for (const char *p = first; p != end;
+         p = *(const char *const *)(p + nextOffset))
+    {
+        buffer[k++] = *(const ElemType *)p;
+
+        if (k == LIST_FILE_BUFFER)
+        {
+            if (FlushBuffer(fp, &C, buffer, k) != OK)
+            {
+                return ERROR;
+            }
+            k = 0;
+        }
+    }
+
+    return FinishBuffer(fp, &C, buffer, k);
+}
+
+Status WriteListSlots(FILE *fp, const void *base, size_t stride,
+                      uint32_t first, size_t nextOffset)
+{
+    ElemType buffer[LIST_FILE_BUFFER];
+    ListChecksum C;
+    size_t k = 0;
+
+    InitChecksum(&C);
+
+    for (uint32_t i = first; i != 0;)
+    {
+        const char *p = (const char *)base + (size_t)i * stride;
+
+        buffer[k++] = *(const ElemType *)p;
+        memcpy(&i, p + nextOffset, sizeof(i));
+
+        if (k == LIST_FILE_BUFFER)
+        {
+            if (FlushBuffer(fp, &C, buffer, k) != OK)
+            {
+                return ERROR;
+            }
+            k = 0;
+        }
+    }
+
+    return FinishBuffer(fp, &C, buffer, k);
+}
+
+Status ReadListHeader(FILE *fp, size_t *count)
+{
+    ListFileHeader H;
+
+    if (fread(&H, sizeof(H), 1, fp) != 1)
+    {
+        return ERROR;
+    }
+
+    return CheckHeader(&H, count);
+}
+
+Status ReadListData(FILE *fp, void *dst, size_t count, size_t stride)
+{
+    ListChecksum C;
+    uint64_t sum;
+
+    InitChecksum(&C);
+
+    if (stride == sizeof(ElemType))
+    {
+        /* 连续的数组, 一次读入. */
+        if (fread(dst, sizeof(ElemType), count, fp) != count)
+        {
+            return ERROR;
+        }
+        UpdateChecksum(&C, dst, count);
+    }
+    else
+    {
+        ElemType buffer[LIST_FILE_BUFFER];
+        char *p = dst;
+
+        while (count > 0)
+        {
+            size_t k = count < LIST_FILE_BUFFER ? count : LIST_FILE_BUFFER;
+
+            if (fread(buffer, sizeof(ElemType), k, fp) != k)
+            {
+                return ERROR;
+            }
+            UpdateChecksum(&C, buffer, k);
+
+            for (size_t j = 0; j < k; ++j, p += stride)
+            {
+                memcpy(p, &buffer[j], sizeof(ElemType));
+            }
+            count -= k;
+        }
+    }
+
+    if (fread(&sum, sizeof(sum), 1, fp) != 1 || sum != FinishChecksum(&C))
+    {
+        return ERROR;
+    }
+
+    return OK;
+}
+
+Status MapListFile(const char *path, Status verify, ListFileMap *M)
+{
+    size_t size;
+    void *base;
+
+#if LIST_FILE_MMAP
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+    if (fstat(fd, &st) != 0 ||
+        (size_t)st.st_size < sizeof(ListFileHeader) + sizeof(uint64_t))
+    {
+        close(fd);
+        return ERROR;
+    }
+
+    /* 私有映射, 修改元素时只复制被修改的页. 映射建立后即可关闭文件. */
+    size = (size_t)st.st_size;
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        return ERROR;
+    }
+#else
+    FILE *fp = fopen(path, "rb");
+
+    if (!fp)
+    {
+        return ERROR;
+    }
+    if (fseek(fp, 0, SEEK_END) != 0)
+    {
+        fclose(fp);
+        return ERROR;
+    }
+
+    long length = ftell(fp);
+    if (length < (long)(sizeof(ListFileHeader) + sizeof(uint64_t)))
+    {
+        fclose(fp);
+        return ERROR;
+    }
+
+    size = (size_t)length;
+    base = malloc(size);
+    /* 内存分配失败. */
+    if (!base)
+    {
+        exit(OVERFLOW);
+    }
+
+    rewind(fp);
+    if (fread(base, 1, size, fp) != size)
+    {
+        free(base);
+        fclose(fp);
+        return ERROR;
+    }
+    fclose(fp);
+#endif
+
+    M->base = base;
+    M->size = size;
+    M->elem = (ElemType *)((char *)base + sizeof(ListFileHeader));
+
+    /* 文件头之外, 文件大小也要与元素个数相符. */
+    if (CheckHeader(base, &M->count) != OK ||
+        size != sizeof(ListFileHeader) + M->count * sizeof(ElemType) +
+                    sizeof(uint64_t))
+    {
+        UnmapListFile(M);
+        return ERROR;
+    }
+
+    if (verify)
+    {
+        ListChecksum C;
+        uint64_t sum;
+
+        InitChecksum(&C);
+        UpdateChecksum(&C, M->elem, M->count);
+        memcpy(&sum, M->elem + M->count, sizeof(sum));
+
+        if (sum != FinishChecksum(&C))
+        {
+            UnmapListFile(M);
+            return ERROR;
+        }
+    }
+
+    return OK;
+}
+
+void UnmapListFile(ListFileMap *M)
+{
+#if LIST_FILE_MMAP
+    munmap(M->base, M->size);
+#else
+    free(M->base);
+#endif
+
+    M->base = NULL;
+    M->elem = NULL;
+    M->size = M->count = 0;
+}
@@ -0,0 +1,357 @@
+﻿/**
+ * @file piecetable.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 片段表方法实现.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include <linearlist/sqlist/piecetable.h>
+
+/* 片段数组的初始容量. */
+#define PIECE_INIT_SIZE 16
+
+/* 片段 p 的第一个元素的地址. */
+#define PIECE_BASE(P, p) \
+    (((p)->buffer == PIECE_ORIGINAL ? (P)->original : (P)->add) + (p)->start)
+
+/**
+ * @brief 倍增扩充动态数组, 使其容量不小于 need.
+ * @param base 数组基址.
+ * @param size 指向数组容量的指针.
+ * @param need 需要的容量.
+ * @param elemSize 元素字节数.
+ * @return 新的数组基址.
+ */
+static void *Grow(void *base, int *size, int need, size_t elemSize)
+{
+    if (need <= *size)
+    {
+        return base;
+    }
+
+    int newsize = *size <= INT_MAX / 2 ? 2 * *size : INT_MAX;
+    if (newsize < need)
+    {
+        newsize = need;
+    }
+
+    void *newbase = realloc(base, elemSize * (size_t)newsize);
+    if (!newbase)
+    {
+        exit(OVERFLOW);
+    }
+
+    *size = newsize;
+
+    return newbase;
+}
+
+Status InitList_PT(PieceTable *P, const ElemType *e, int n)
+{
+    if (n < 0)
+    {
+        return ERROR;
+    }
+
+    P->original = (ElemType *)malloc(sizeof(ElemType) * (size_t)(n > 0 ? n : 1));
+    P->add = (ElemType *)malloc(sizeof(ElemType) * LIST_INIT_SIZE);
+    P->piece = (Piece *)malloc(sizeof(Piece) * PIECE_INIT_SIZE);
+    if (!P->original || !P->add || !P->piece)
+    {
+        exit(OVERFLOW);
+    }
+
+    if (n > 0)
+    {
+        memcpy(P->original, e, sizeof(ElemType) * (size_t)n);
+    }
+
+    P->addLength = 0;
+    P->addSize = LIST_INIT_SIZE;
+    P->pieceSize = PIECE_INIT_SIZE;
+
+    /* 原始内容是一个完整的片段. */
+    P->pieceCount = 0;
+    if (n > 0)
+    {
+        P->piece[0].buffer = PIECE_ORIGINAL;
+        P->piece[0].start = 0;
+        P->piece[0].length = n;
+        P->pieceCount = 1;
+    }
+
+    P->length = n;
+    P->cursorPiece = 0;
+    P->cursorPos = 0;
+
+    return OK;
+}
+
+Status DestroyList_PT(PieceTable *P)
+{
+    free(P->original);
+    free(P->add);
+    free(P->piece);
+
+    P->original = NULL;
+    P->add = NULL;
+    P->piece = NULL;
+    P->addLength = P->addSize = 0;
+    P->pieceCount = P->pieceSize = 0;
+    P->length = 0;
+    P->cursorPiece = P->cursorPos = 0;
+
+    return OK;
+}
+
+int ListLength_PT(PieceTable P)
+{
+    return P.length;
+}
+
+/**
+ * @brief 定位第 pos 个元素 (从 0 开始) 所在的片段. 从缓存的片段出发向前或
+ * 向后逐段移动, 并把结果写回缓存.
+ * @param pos 取值范围 0 <= pos <= length. pos 等于 length 时返回
+ * pieceCount.
+ * @param start 用以返回所在片段第一个元素之前的元素个数.
+ * @return 所在片段的下标.
+ */
+static int Locate(PieceTable *P, int pos, int *start)
+{
+    int k = P->cursorPiece;
+    int s = P->cursorPos;
+
+    while (pos < s)
+    {
+        --k;
+        s -= P->piece[k].length;
+    }
+    while (k < P->pieceCount && pos >= s + P->piece[k].length)
+    {
+        s += P->piece[k].length;
+        ++k;
+    }
+
+    P->cursorPiece = k;
+    P->cursorPos = s;
+    *start = s;
+
+    return k;
+}
+
+/* 在下标 k 处空出 n 个片段的位置. */
+static void OpenPieces(PieceTable *P, int k, int n)
+{
+    P->piece = Grow(P->piece, &P->pieceSize, P->pieceCount + n, sizeof(Piece));
+
+    memmove(P->piece + k + n, P->piece + k,
+            sizeof(Piece) * (size_t)(P->pieceCount - k));
+
+    P->pieceCount += n;
+}
+
+Status GetElem_PT(PieceTable *P, int i, ElemType *e)
+{
+    if (i < 1 || i > P->length)
+    {
+        return ERROR;
+    }
+
+    int start;
+    int k = Locate(P, i - 1, &start);
+
+    *e = PIECE_BASE(P, &P->piece[k])[i - 1 - start];
+
+    return OK;
+}
+
+Status ListInsert_PT(PieceTable *P, int i, ElemType e)
+{
+    return ListInsertRange_PT(P, i, &e, 1);
+}
+
+Status ListInsertRange_PT(PieceTable *P, int i, const ElemType *e, int n)
+{
+    if (i < 1 || i > P->length + 1 || n < 0 || n > INT_MAX - P->length ||
+        n > INT_MAX - P->addLength)
+    {
+        return ERROR;
+    }
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    /* 新元素追加到新增缓冲区. */
+    int addStart = P->addLength;
+    P->add = Grow(P->add, &P->addSize, P->addLength + n, sizeof(ElemType));
+    memcpy(P->add + addStart, e, sizeof(ElemType) * (size_t)n);
+    P->addLength += n;
+
+    int start;
+    int k = Locate(P, i - 1, &start);
+    int offset = i - 1 - start;
+
+    if (offset == 0 && k > 0 && P->piece[k - 1].buffer == PIECE_ADD &&
+        P->piece[k - 1].start + P->piece[k - 1].length == addStart)
+    {
+        /* 紧接在上次插入的元素之后, 延长上一片段即可. */
+        P->piece[k - 1].length += n;
+        P->cursorPiece = k - 1;
+        P->cursorPos = start - (P->piece[k - 1].length - n);
+    }
+    else if (offset == 0)
+    {
+        /* 插在片段边界上, 新增一个片段. */
+        OpenPieces(P, k, 1);
+        P->piece[k].buffer = PIECE_ADD;
+        P->piece[k].start = addStart;
+        P->piece[k].length = n;
+    }
+    else
+    {
+        /* 插在片段中间, 把该片段拆为两段, 新片段夹在中间. */
+        OpenPieces(P, k + 1, 2);
+        P->piece[k + 2] = P->piece[k];
+        P->piece[k + 2].start += offset;
+        P->piece[k + 2].length -= offset;
+        P->piece[k].length = offset;
+        P->piece[k + 1].buffer = PIECE_ADD;
+        P->piece[k + 1].start = addStart;
+        P->piece[k + 1].length = n;
+    }
+
+    P->length += n;
+
+    return OK;
+}
+
+Status ListDelete_PT(PieceTable *P, int i, ElemType *e)
+{
+    if (GetElem_PT(P, i, e) != OK)
+    {
+        return ERROR;
+    }
+
+    return ListDeleteRange_PT(P, i, 1);
+}
+
+Status ListDeleteRange_PT(PieceTable *P, int i, int n)
+{
+    if (i < 1 || i > P->length || n < 0 || n > P->length - i + 1)
+    {
+        return ERROR;
+    }
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    int start;
+    int k = Locate(P, i - 1, &start);
+    int offset = i - 1 - start;
+
+    P->length -= n;
+
+    if (offset > 0)
+    {
+        Piece *p = &P->piece[k];
+
+        if (offset + n < p->length)
+        {
+            /* 删除的元素在片段中间, 把该片段拆为两段. */
+            OpenPieces(P, k + 1, 1);
+            p = &P->piece[k];
+            P->piece[k + 1] = *p;
+            P->piece[k + 1].start += offset + n;
+            P->piece[k + 1].length -= offset + n;
+            p->length = offset;
+            return OK;
+        }
+
+        /**
+         * 截去该片段的尾部, 剩余部分从下一片段开始删除. 截去的若是新增缓冲区
+         * 末尾的元素, 它们不再被引用, 新增缓冲区随之回退, 之后在此处插入时
+         * 仍能延长该片段, 片段不会越删越碎.
+         */
+        if (p->buffer == PIECE_ADD && p->start + p->length == P->addLength)
+        {
+            P->addLength = p->start + offset;
+        }
+        n -= p->length - offset;
+        p->length = offset;
+        ++k;
+    }
+
+    /* 整段删除的片段为 [k, end), 最后一段可能只删去头部. */
+    int end = k;
+    while (n > 0 && n >= P->piece[end].length)
+    {
+        n -= P->piece[end].length;
+        ++end;
+    }
+    if (n > 0)
+    {
+        P->piece[end].start += n;
+        P->piece[end].length -= n;
+    }
+
+    memmove(P->piece + k, P->piece + end,
+            sizeof(Piece) * (size_t)(P->pieceCount - end));
+    P->pieceCount -= end - k;
+
+    return OK;
+}
+
+Status ListCopy_PT(PieceTable *P, int i, int n, ElemType *dst)
+{
+    if (i < 1 || i > P->length + 1 || n < 0 || n > P->length - i + 1)
+    {
+        return ERROR;
+    }
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    int start;
+    int k = Locate(P, i - 1, &start);
+    int offset = i - 1 - start;
+
+    /* 逐个片段整段复制. */
+    while (n > 0)
+    {
+        Piece *p = &P->piece[k++];
+        int m = p->length - offset < n ? p->length - offset : n;
+
+        memcpy(dst, PIECE_BASE(P, p) + offset, sizeof(ElemType) * (size_t)m);
+        dst += m;
+        n -= m;
+        offset = 0;
+    }
+
+    return OK;
+}
+
+void PrintList_PT(PieceTable P)
+{
+    for (int k = 0; k < P.pieceCount; ++k)
+    {
+        const ElemType *base = PIECE_BASE(&P, &P.piece[k]);
+
+        for (int j = 0; j < P.piece[k].length; ++j)
+        {
+            printf("%d\n", base[j]);
+        }
+    }
+
+    return;
+}
@@ -9,8 +9,458 @@
  * 
  */
 
+#include <limits.h>
+#include <pthread.h>
+#include <string.h>
+
 #include <linearlist/sqlist/sqlist.h>
 
+/**
+ * 整数顺序表的查找和过滤内核. x86 上用 GCC/Clang 的 target 属性单独编译一份
+ * AVX2 版本, 运行时检测 CPU 后选用; 其他平台和编译器只用标量版本. 两者结果
+ * 完全相同.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SQ_HAVE_AVX2 1
+#define SQ_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#else
+#define SQ_HAVE_AVX2 0
+#endif
+
+/* 内核按 32 位整数处理元素. */
+_Static_assert(sizeof(ElemType) == 4, "SqList kernels assume 32-bit ElemType");
+
+/**
+ * 无符号比较判断 s <= e <= t: e - s 回绕后落在 [0, t - s] 内当且仅当 e 在
+ * 区间内, 只需一次比较, 没有分支. 要求 s <= t.
+ */
+#define IN_RANGE(e, s, t) \
+    ((unsigned int)(e) - (unsigned int)(s) <= (unsigned int)(t) - (unsigned int)(s))
+
+/* 标量版本: 返回第一个等于 e 的元素下标, 不存在时返回 n. */
+static int FindEqualScalar(const ElemType *a, int n, ElemType e)
+{
+    int i = 0;
+
+    while (i < n && a[i] != e)
+    {
+        ++i;
+    }
+
+    return i;
+}
+
+/* 标量版本: 返回第一个在 [s, t] 内的元素下标, 不存在时返回 n. */
+static int FindRangeScalar(const ElemType *a, int n, ElemType s, ElemType t)
+{
+    int i = 0;
+
+    while (i < n && !IN_RANGE(a[i], s, t))
+    {
+        ++i;
+    }
+
+    return i;
+}
+
+/**
+ * 标量压缩: 每个元素都先写到 a[k], 再按是否保留决定 k 是否前进. 没有分支,
+ * 不会因为分支预测失败而变慢. 函数返回保留的元素个数.
+ */
+static int CompactNotEqualScalar(ElemType *a, int n, ElemType x)
+{
+    int k = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        ElemType e = a[i];
+        a[k] = e;
+        k += e != x;
+    }
+
+    return k;
+}
+
+static int CompactOutsideScalar(ElemType *a, int n, ElemType s, ElemType t)
+{
+    int k = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        ElemType e = a[i];
+        a[k] = e;
+        k += !IN_RANGE(e, s, t);
+    }
+
+    return k;
+}
+
+/**
+ * 从 a[i] 起保留与前一个元素不同的元素, 写到 a[k] 起. 前一个元素可能已被
+ * 覆盖, 所以用 last 记录它的原值. a[0] 总是保留, 由调用者保证 n >= 1.
+ */
+static int CompactUniqueScalar(ElemType *a, int n, int i, int k, ElemType last)
+{
+    for (; i < n; ++i)
+    {
+        ElemType e = a[i];
+        a[k] = e;
+        k += e != last;
+        last = e;
+    }
+
+    return k;
+}
+
+#if SQ_HAVE_AVX2
+
+/**
+ * 压缩用的置换表. 第 m 项的 8 个字节依次为 8 位掩码 m 中各个 1 的位置, 其余
+ * 字节为 0. 按它置换一个向量, 要保留的元素就依次排到了低位.
+ */
+static const unsigned long long KeepPermute[256] = {
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL,
+    0x0000000000000100ULL, 0x0000000000000002ULL, 0x0000000000000200ULL,
+    0x0000000000000201ULL, 0x0000000000020100ULL, 0x0000000000000003ULL,
+    0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+    0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL,
+    0x0000000003020100ULL, 0x0000000000000004ULL, 0x0000000000000400ULL,
+    0x0000000000000401ULL, 0x0000000000040100ULL, 0x0000000000000402ULL,
+    0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+    0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL,
+    0x0000000004030100ULL, 0x0000000000040302ULL, 0x0000000004030200ULL,
+    0x0000000004030201ULL, 0x0000000403020100ULL, 0x0000000000000005ULL,
+    0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+    0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL,
+    0x0000000005020100ULL, 0x0000000000000503ULL, 0x0000000000050300ULL,
+    0x0000000000050301ULL, 0x0000000005030100ULL, 0x0000000000050302ULL,
+    0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+    0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL,
+    0x0000000005040100ULL, 0x0000000000050402ULL, 0x0000000005040200ULL,
+    0x0000000005040201ULL, 0x0000000504020100ULL, 0x0000000000050403ULL,
+    0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+    0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL,
+    0x0000050403020100ULL, 0x0000000000000006ULL, 0x0000000000000600ULL,
+    0x0000000000000601ULL, 0x0000000000060100ULL, 0x0000000000000602ULL,
+    0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+    0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL,
+    0x0000000006030100ULL, 0x0000000000060302ULL, 0x0000000006030200ULL,
+    0x0000000006030201ULL, 0x0000000603020100ULL, 0x0000000000000604ULL,
+    0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+    0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL,
+    0x0000000604020100ULL, 0x0000000000060403ULL, 0x0000000006040300ULL,
+    0x0000000006040301ULL, 0x0000000604030100ULL, 0x0000000006040302ULL,
+    0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+    0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL,
+    0x0000000006050100ULL, 0x0000000000060502ULL, 0x0000000006050200ULL,
+    0x0000000006050201ULL, 0x0000000605020100ULL, 0x0000000000060503ULL,
+    0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+    0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL,
+    0x0000060503020100ULL, 0x0000000000060504ULL, 0x0000000006050400ULL,
+    0x0000000006050401ULL, 0x0000000605040100ULL, 0x0000000006050402ULL,
+    0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+    0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL,
+    0x0000060504030100ULL, 0x0000000605040302ULL, 0x0000060504030200ULL,
+    0x0000060504030201ULL, 0x0006050403020100ULL, 0x0000000000000007ULL,
+    0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+    0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL,
+    0x0000000007020100ULL, 0x0000000000000703ULL, 0x0000000000070300ULL,
+    0x0000000000070301ULL, 0x0000000007030100ULL, 0x0000000000070302ULL,
+    0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+    0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL,
+    0x0000000007040100ULL, 0x0000000000070402ULL, 0x0000000007040200ULL,
+    0x0000000007040201ULL, 0x0000000704020100ULL, 0x0000000000070403ULL,
+    0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+    0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL,
+    0x0000070403020100ULL, 0x0000000000000705ULL, 0x0000000000070500ULL,
+    0x0000000000070501ULL, 0x0000000007050100ULL, 0x0000000000070502ULL,
+    0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+    0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL,
+    0x0000000705030100ULL, 0x0000000007050302ULL, 0x0000000705030200ULL,
+    0x0000000705030201ULL, 0x0000070503020100ULL, 0x0000000000070504ULL,
+    0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+    0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL,
+    0x0000070504020100ULL, 0x0000000007050403ULL, 0x0000000705040300ULL,
+    0x0000000705040301ULL, 0x0000070504030100ULL, 0x0000000705040302ULL,
+    0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+    0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL,
+    0x0000000007060100ULL, 0x0000000000070602ULL, 0x0000000007060200ULL,
+    0x0000000007060201ULL, 0x0000000706020100ULL, 0x0000000000070603ULL,
+    0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+    0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL,
+    0x0000070603020100ULL, 0x0000000000070604ULL, 0x0000000007060400ULL,
+    0x0000000007060401ULL, 0x0000000706040100ULL, 0x0000000007060402ULL,
+    0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+    0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL,
+    0x0000070604030100ULL, 0x0000000706040302ULL, 0x0000070604030200ULL,
+    0x0000070604030201ULL, 0x0007060403020100ULL, 0x0000000000070605ULL,
+    0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+    0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL,
+    0x0000070605020100ULL, 0x0000000007060503ULL, 0x0000000706050300ULL,
+    0x0000000706050301ULL, 0x0000070605030100ULL, 0x0000000706050302ULL,
+    0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+    0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL,
+    0x0000070605040100ULL, 0x0000000706050402ULL, 0x0000070605040200ULL,
+    0x0000070605040201ULL, 0x0007060504020100ULL, 0x0000000706050403ULL,
+    0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+    0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL,
+    0x0706050403020100ULL,
+};
+
+/* 读入 8 个元素, 不要求对齐. */
+#define LOAD8(p) _mm256_loadu_si256((const __m256i *)(p))
+
+static int HasAvx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+/**
+ * 将 v 中掩码 keep 为 1 的元素依次写到 out, 返回下一个写位置. 总是写满 8 个
+ * 元素, 多出的部分是无用数据, 会被之后的写入覆盖或落在表长之外. 原地压缩时
+ * out 不超过读位置, 所以不会覆盖尚未读入的元素.
+ */
+SQ_TARGET_AVX2 static inline ElemType *StoreKept(ElemType *out, __m256i v,
+                                                 int keep)
+{
+    __m256i index = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64((const __m128i *)&KeepPermute[keep]));
+
+    _mm256_storeu_si256((__m256i *)out, _mm256_permutevar8x32_epi32(v, index));
+
+    return out + _mm_popcnt_u32((unsigned int)keep);
+}
+
+/* 8 个元素的比较结果转为 8 位掩码. */
+SQ_TARGET_AVX2 static inline int MoveMask(__m256i m)
+{
+    return _mm256_movemask_ps(_mm256_castsi256_ps(m));
+}
+
+/* 每次比较 32 个元素, 全部不等时只做一次 testz 判断. */
+SQ_TARGET_AVX2 static int FindEqualAvx2(const ElemType *a, int n, ElemType e)
+{
+    const __m256i x = _mm256_set1_epi32(e);
+    int i = 0;
+
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i m0 = _mm256_cmpeq_epi32(LOAD8(a + i), x);
+        __m256i m1 = _mm256_cmpeq_epi32(LOAD8(a + i + 8), x);
+        __m256i m2 = _mm256_cmpeq_epi32(LOAD8(a + i + 16), x);
+        __m256i m3 = _mm256_cmpeq_epi32(LOAD8(a + i + 24), x);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+
+        if (!_mm256_testz_si256(any, any))
+        {
+            unsigned int mask = (unsigned int)MoveMask(m0) |
+                                (unsigned int)MoveMask(m1) << 8 |
+                                (unsigned int)MoveMask(m2) << 16 |
+                                (unsigned int)MoveMask(m3) << 24;
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    for (; i + 8 <= n; i += 8)
+    {
+        int mask = MoveMask(_mm256_cmpeq_epi32(LOAD8(a + i), x));
+        if (mask)
+        {
+            return i + __builtin_ctz((unsigned int)mask);
+        }
+    }
+
+    return i + FindEqualScalar(a + i, n - i, e);
+}
+
+/**
+ * 与 IN_RANGE 相同的无符号比较. AVX2 只有有符号比较, 两边同时翻转符号位即可.
+ * 结果中为 1 的元素在区间之外.
+ */
+SQ_TARGET_AVX2 static inline __m256i OutsideAvx2(__m256i v, __m256i s,
+                                                 __m256i limit)
+{
+    const __m256i sign = _mm256_set1_epi32(INT_MIN);
+
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_sub_epi32(v, s), sign),
+                              limit);
+}
+
+SQ_TARGET_AVX2 static int FindRangeAvx2(const ElemType *a, int n, ElemType s,
+                                        ElemType t)
+{
+    const __m256i vs = _mm256_set1_epi32(s);
+    const __m256i limit =
+        _mm256_set1_epi32((int)(((unsigned int)t - (unsigned int)s) ^ 0x80000000u));
+    const __m256i ones = _mm256_set1_epi32(-1);
+    int i = 0;
+
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i m0 = OutsideAvx2(LOAD8(a + i), vs, limit);
+        __m256i m1 = OutsideAvx2(LOAD8(a + i + 8), vs, limit);
+        __m256i m2 = OutsideAvx2(LOAD8(a + i + 16), vs, limit);
+        __m256i m3 = OutsideAvx2(LOAD8(a + i + 24), vs, limit);
+        __m256i all = _mm256_and_si256(_mm256_and_si256(m0, m1), _mm256_and_si256(m2, m3));
+
+        if (!_mm256_testc_si256(all, ones))
+        {
+            unsigned int mask = (unsigned int)MoveMask(m0) |
+                                (unsigned int)MoveMask(m1) << 8 |
+                                (unsigned int)MoveMask(m2) << 16 |
+                                (unsigned int)MoveMask(m3) << 24;
+            return i + __builtin_ctz(~mask);
+        }
+    }
+
+    for (; i + 8 <= n; i += 8)
+    {
+        int mask = ~MoveMask(OutsideAvx2(LOAD8(a + i), vs, limit)) & 0xff;
+        if (mask)
+        {
+            return i + __builtin_ctz((unsigned int)mask);
+        }
+    }
+
+    return i + FindRangeScalar(a + i, n - i, s, t);
+}
+
+SQ_TARGET_AVX2 static int CompactNotEqualAvx2(ElemType *a, int n, ElemType x)
+{
+    const __m256i vx = _mm256_set1_epi32(x);
+    ElemType *out = a;
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = LOAD8(a + i);
+        int keep = ~MoveMask(_mm256_cmpeq_epi32(v, vx)) & 0xff;
+        out = StoreKept(out, v, keep);
+    }
+
+    int k = (int)(out - a);
+    for (; i < n; ++i)
+    {
+        ElemType e = a[i];
+        a[k] = e;
+        k += e != x;
+    }
+
+    return k;
+}
+
+SQ_TARGET_AVX2 static int CompactOutsideAvx2(ElemType *a, int n, ElemType s,
+                                             ElemType t)
+{
+    const __m256i vs = _mm256_set1_epi32(s);
+    const __m256i limit =
+        _mm256_set1_epi32((int)(((unsigned int)t - (unsigned int)s) ^ 0x80000000u));
+    ElemType *out = a;
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = LOAD8(a + i);
+        out = StoreKept(out, v, MoveMask(OutsideAvx2(v, vs, limit)));
+    }
+
+    int k = (int)(out - a);
+    for (; i < n; ++i)
+    {
+        ElemType e = a[i];
+        a[k] = e;
+        k += !IN_RANGE(e, s, t);
+    }
+
+    return k;
+}
+
+/**
+ * 每个元素与其前一个元素比较. 前一个元素可能已被压缩写入覆盖, 所以不从内存
+ * 重读, 而是把本组向量循环右移一个元素, 再从上一组向量取最后一个元素补到
+ * 最低位.
+ */
+SQ_TARGET_AVX2 static int CompactUniqueAvx2(ElemType *a, int n)
+{
+    const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    __m256i last = _mm256_set1_epi32(a[0]);
+    ElemType *out = a + 1;
+    int i = 1;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = LOAD8(a + i);
+        __m256i prev = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(v, rotate),
+                                          _mm256_permutevar8x32_epi32(last, rotate),
+                                          0x01);
+        int keep = ~MoveMask(_mm256_cmpeq_epi32(v, prev)) & 0xff;
+        out = StoreKept(out, v, keep);
+        last = v;
+    }
+
+    return CompactUniqueScalar(a, n, i, (int)(out - a),
+                               _mm256_extract_epi32(last, 7));
+}
+
+#endif /* SQ_HAVE_AVX2 */
+
+static int FindEqual(const ElemType *a, int n, ElemType e)
+{
+#if SQ_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return FindEqualAvx2(a, n, e);
+    }
+#endif
+    return FindEqualScalar(a, n, e);
+}
+
+static int FindRange(const ElemType *a, int n, ElemType s, ElemType t)
+{
+#if SQ_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return FindRangeAvx2(a, n, s, t);
+    }
+#endif
+    return FindRangeScalar(a, n, s, t);
+}
+
+static int CompactNotEqual(ElemType *a, int n, ElemType x)
+{
+#if SQ_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return CompactNotEqualAvx2(a, n, x);
+    }
+#endif
+    return CompactNotEqualScalar(a, n, x);
+}
+
+static int CompactOutside(ElemType *a, int n, ElemType s, ElemType t)
+{
+#if SQ_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return CompactOutsideAvx2(a, n, s, t);
+    }
+#endif
+    return CompactOutsideScalar(a, n, s, t);
+}
+
+static int CompactUnique(ElemType *a, int n)
+{
+#if SQ_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return CompactUniqueAvx2(a, n);
+    }
+#endif
+    return CompactUniqueScalar(a, n, 1, 1, a[0]);
+}
+
 Status InitList_Sq(SqList *L)
 {
     L->elem = (ElemType *)malloc(sizeof(ElemType) * LIST_INIT_SIZE);
@@ -21,20 +471,219 @@ Status InitList_Sq(SqList *L)
 
     L->length = 0;
     L->listsize = LIST_INIT_SIZE;
+    L->mapped = FALSE;
 
     return OK;
 }
 
 Status DestoryList_Sq(SqList *L)
 {
-    free(L);
+    /* 映射的存储空间只能由 UnmapList_Sq() 释放. */
+    if (L->mapped)
+    {
+        return ERROR;
+    }
+
+    free(L->elem);
+
+    L->elem = NULL;
+    L->length = 0;
+    L->listsize = 0;
 
     return OK;
 }
 
 int ListLength_Sq(SqList L)
 {
-    return L.listsize;
+    return L.length;
+}
+
+Status ListReserve_Sq(SqList *L, int n)
+{
+    if (n <= L->listsize)
+    {
+        return OK;
+    }
+    if (L->mapped)
+    {
+        return ERROR;
+    }
+
+    /**
+     * 按倍增扩充: 每次扩充后的容量至少是原来的 2 倍, 所以连续插入 n 个元素
+     * 时 realloc 只调用 O(logn) 次, 搬移元素的总次数不超过 2n.
+     */
+    int newsize = L->listsize > INT_MAX - LIST_INCREMENT
+                      ? INT_MAX
+                      : L->listsize + LIST_INCREMENT;
+    if (L->listsize <= INT_MAX / 2 && newsize < 2 * L->listsize)
+    {
+        newsize = 2 * L->listsize;
+    }
+    if (newsize < n)
+    {
+        newsize = n;
+    }
+
+    ElemType *newbase = realloc(L->elem, sizeof(ElemType) * (size_t)newsize);
+    if (!newbase)
+    {
+        exit(OVERFLOW);
+    }
+
+    L->elem = newbase;
+    L->listsize = newsize;
+
+    return OK;
+}
+
+Status ListShrink_Sq(SqList *L)
+{
+    int newsize = L->length > 0 ? L->length : 1;
+
+    if (newsize == L->listsize)
+    {
+        return OK;
+    }
+    if (L->mapped)
+    {
+        return ERROR;
+    }
+
+    ElemType *newbase = realloc(L->elem, sizeof(ElemType) * (size_t)newsize);
+    if (!newbase)
+    {
+        return ERROR;
+    }
+
+    L->elem = newbase;
+    L->listsize = newsize;
+
+    return OK;
+}
+
+Status ListInsertRange_Sq(SqList *L, int i, const ElemType *e, int n)
+{
+    if (i < 1 || i > L->length + 1 || n < 0 || n > INT_MAX - L->length)
+    {
+        return ERROR;
+    }
+    if (n == 0)
+    {
+        return OK;
+    }
+
+    if (ListReserve_Sq(L, L->length + n) != OK)
+    {
+        return ERROR;
+    }
+
+    /* 第 i 个元素及以后的元素整体后移 n 个位置, 再拷入新元素. */
+    memmove(L->elem + i - 1 + n, L->elem + i - 1,
+            sizeof(ElemType) * (size_t)(L->length - i + 1));
+    memcpy(L->elem + i - 1, e, sizeof(ElemType) * (size_t)n);
+
+    L->length += n;
+
+    return OK;
+}
+
+Status ListDeleteRange_Sq(SqList *L, int i, int n)
+{
+    if (i < 1 || i > L->length || n < 0 || n > L->length - i + 1)
+    {
+        return ERROR;
+    }
+
+    /* 第 i + n 个元素及以后的元素整体前移 n 个位置. */
+    memmove(L->elem + i - 1, L->elem + i - 1 + n,
+            sizeof(ElemType) * (size_t)(L->length - i + 1 - n));
+
+    L->length -= n;
+
+    return OK;
+}
+
+Status ListAppend_Sq(SqList *L, const ElemType *e, int n)
+{
+    return ListInsertRange_Sq(L, L->length + 1, e, n);
+}
+
+Status SaveList_Sq(SqList L, FILE *fp)
+{
+    if (WriteListHeader(fp, (size_t)L.length) != OK)
+    {
+        return ERROR;
+    }
+
+    return WriteListArray(fp, L.elem, (size_t)L.length);
+}
+
+Status LoadList_Sq(SqList *L, FILE *fp)
+{
+    size_t n;
+
+    L->length = 0;
+    if (ReadListHeader(fp, &n) != OK || n > INT_MAX)
+    {
+        return ERROR;
+    }
+
+    if (ListReserve_Sq(L, (int)n) != OK ||
+        ReadListData(fp, L->elem, n, sizeof(ElemType)) != OK)
+    {
+        return ERROR;
+    }
+
+    L->length = (int)n;
+
+    return OK;
+}
+
+Status MapList_Sq(SqList *L, const char *path, Status verify)
+{
+    ListFileMap M;
+
+    if (MapListFile(path, verify, &M) != OK)
+    {
+        return ERROR;
+    }
+    if (M.count > INT_MAX)
+    {
+        UnmapListFile(&M);
+        return ERROR;
+    }
+
+    L->elem = M.elem;
+    L->length = L->listsize = (int)M.count;
+    L->mapped = TRUE;
+
+    return OK;
+}
+
+Status UnmapList_Sq(SqList *L)
+{
+    /* 映射的布局是固定的, 由元素地址和容量即可还原. */
+    ListFileMap M;
+
+    if (!L->mapped)
+    {
+        return ERROR;
+    }
+
+    M.base = (char *)L->elem - sizeof(ListFileHeader);
+    M.size = sizeof(ListFileHeader) + sizeof(ElemType) * (size_t)L->listsize +
+             sizeof(uint64_t);
+    M.elem = L->elem;
+    M.count = (size_t)L->listsize;
+    UnmapListFile(&M);
+
+    L->elem = NULL;
+    L->length = 0;
+    L->listsize = 0;
+    L->mapped = FALSE;
+
+    return OK;
 }
 
 int LocateElem_Sq(SqList L, ElemType e, Status (*Compare)(ElemType, ElemType))
@@ -45,16 +694,36 @@ int LocateElem_Sq(SqList L, ElemType e, Status (*Compare)(ElemType, ElemType))
     {
         if ((*Compare)(L.elem[i], e))
         {
-            return i;
+            return i + 1;
         }
     }
 
     return 0;
 }
 
+int LocateEqual_Sq(SqList L, ElemType e)
+{
+    int i = FindEqual(L.elem, L.length, e);
+
+    return i < L.length ? i + 1 : 0;
+}
+
+int LocateRange_Sq(SqList L, ElemType s, ElemType t)
+{
+    if (s > t)
+    {
+        return 0;
+    }
+
+    int i = FindRange(L.elem, L.length, s, t);
+
+    return i < L.length ? i + 1 : 0;
+}
+
 void GetElem_Sq(SqList L, int i, ElemType *e)
 {
-    *e = L.elem[i];
+    /* 位序从 1 开始. */
+    *e = L.elem[i - 1];
 
     return;
 }
@@ -72,17 +741,15 @@ Status ListInsert_Sq(SqList *L, int i, ElemType e)
         return ERROR;
     }
 
-    /* 当前存储空间已满, 不能插入. */
-    if (L->length >= LIST_MAX_SIZE)
+    /* 当前存储空间已满, 倍增扩充. */
+    if (L->length >= L->listsize && ListReserve_Sq(L, L->length + 1) != OK)
     {
         return ERROR;
     }
 
     /* 将第 i 个元素及以后的元素后移. */
-    for (int j = L->length; j >= i; --j)
-    {
-        L->elem[j] = L->elem[j - 1];
-    }
+    memmove(L->elem + i, L->elem + i - 1,
+            sizeof(ElemType) * (size_t)(L->length - i + 1));
 
     /* 在第 i 个元素之前插入数据元素 e. */
     L->elem[i - 1] = e;
@@ -104,10 +771,8 @@ Status ListDelete_Sq(SqList *L, int i, ElemType *e)
     *e = L->elem[i - 1];
 
     /* 将第 i 个位置后的元素前移. */
-    for (int j = i; j < L->length; ++j)
-    {
-        L->elem[j - 1] = L->elem[j];
-    }
+    memmove(L->elem + i - 1, L->elem + i,
+            sizeof(ElemType) * (size_t)(L->length - i));
 
     /* 顺序表长度减 1. */
     L->length--;
@@ -211,31 +876,13 @@ Status Reverse_Sq(SqList *L)
 
 Status DelX(SqList *L, ElemType x)
 {
-    /* 辅助变量, 空间复杂度 O(1). */
-    int xCount = 0;
-
     /**
      * 算法思想: 顺序表中等于 x 的数据元素有 m 个, 用 x 将顺序表分为 m+1 个区间,
      * 每个区间中元素向前移动的长度为该区间前面 x 的数量.
-     * 所以只需要扫描一次顺序表, 一边扫描, 一边统计 m, 并将不等于 x 的元素向前
-     * 移动 m 单位.
+     * 所以只需要扫描一次顺序表, 一边扫描, 一边将不等于 x 的元素向前移动.
+     * 时间复杂度 O(n), 空间复杂度 O(1). 支持 AVX2 时每次比较并压缩 8 个元素.
      */
-
-    // for() 时间复杂度 O(n).
-    for (int i = 0; i < L->length; ++i)
-    {
-        if (L->elem[i] == x)
-        {
-            ++xCount;
-        }
-        else
-        {
-            L->elem[i - xCount] = L->elem[i];
-        }
-    }
-
-    /* 更新顺序表长度. */
-    L->length = L->length - xCount;
+    L->length = CompactNotEqual(L->elem, L->length, x);
 
     return OK;
 }
@@ -283,85 +930,166 @@ Status DelST2(SqList *L, ElemType s, ElemType t)
         return ERROR;
     }
 
-    /* 辅助变量, 记录值在 s 和 t 之间的元素个数. */
-    int k = 0;
+    /* 值不在 [s, t] 内的元素依次前移, 并更新顺序表长度. */
+    L->length = CompactOutside(L->elem, L->length, s, t);
 
-    for (int i = 0; i < L->length; ++i)
+    return TRUE;
+}
+
+Status DeleteSame(SqList *L)
+{
+    if (L->length == 0)
     {
-        if (L->elem[i] >= s && L->elem[i] <= t)
+        return ERROR;
+    }
+
+    /**
+     * 与前一个元素不同的元素前移至上一个保留的元素之后. 被删除的元素一定等于
+     * 上一个保留的元素, 所以与前一个元素比较和与上一个保留的元素比较等价.
+     */
+    L->length = CompactUnique(L->elem, L->length);
+
+    return OK;
+}
+
+/* 并行归并的最大线程数. */
+#define MERGE_MAX_THREADS 64
+/* 每个线程至少归并的元素个数, 太少时线程开销超过收益. */
+#define MERGE_MIN_SLICE (1 << 16)
+
+/* 一个线程负责的输出区间 C[begin, end). */
+typedef struct MergeSlice
+{
+    const ElemType *a, *b;
+    int alen, blen;
+    ElemType *c;
+    int begin, end;
+} MergeSlice;
+
+/**
+ * 归并路径: 把归并过程看成从左上到右下的网格路径, 第 d 条反对角线与路径的
+ * 交点给出输出的前 d 个元素中有几个来自 A. 在对角线上二分查找第一个满足
+ * A[i] > B[d - i - 1] 的 i 即可, 时间复杂度 O(log(min(d, alen))).
+ * 相等时先取 A 中的元素, 与顺序归并的结果一致.
+ */
+static int MergePath(const ElemType *a, int alen, const ElemType *b, int blen,
+                     int d)
+{
+    int lo = d > blen ? d - blen : 0;
+    int hi = d < alen ? d : alen;
+
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if (a[mid] <= b[d - mid - 1])
         {
-            ++k;
+            lo = mid + 1;
         }
         else
         {
-            L->elem[i - k] = L->elem[i];
+            hi = mid;
         }
     }
 
-    /* 更新顺序表长度. */
-    L->length -= k;
+    return lo;
+}
 
-    return TRUE;
+/* 归并输出区间 C[begin, end), 各线程的区间互不相交, 无需同步. */
+static void *MergeWorker(void *arg)
+{
+    MergeSlice *s = arg;
+    int i = MergePath(s->a, s->alen, s->b, s->blen, s->begin);
+    int j = s->begin - i;
+    int iend = MergePath(s->a, s->alen, s->b, s->blen, s->end);
+    int jend = s->end - iend;
+    ElemType *out = s->c + s->begin;
+
+    /* 比较结果直接决定两个下标的增量, 没有难以预测的分支. */
+    while (i < iend && j < jend)
+    {
+        ElemType x = s->a[i], y = s->b[j];
+        int takeA = x <= y;
+
+        *out++ = takeA ? x : y;
+        i += takeA;
+        j += !takeA;
+    }
+
+    /* 还剩一段没有比较完. */
+    memcpy(out, s->a + i, sizeof(ElemType) * (size_t)(iend - i));
+    out += iend - i;
+    memcpy(out, s->b + j, sizeof(ElemType) * (size_t)(jend - j));
+
+    return NULL;
 }
 
-Status DeleteSame(SqList *L)
+Status MergeParallel(SqList A, SqList B, SqList *C, int threads)
 {
-    if (L->length == 0)
+    if (threads < 1 || A.length > INT_MAX - B.length)
     {
         return ERROR;
     }
 
-    int i, j;
-    /* i 存储第一个不相同的元素, j 为工作指针. */
-    for (i = 0, j = 1; j < L->length; ++j)
+    int total = A.length + B.length;
+
+    /* 结果的存储空间一次分配到位. */
+    if (ListReserve_Sq(C, total) != OK)
     {
-        /* 找到下一个与上一个元素不同的元素. */
-        if (L->elem[i] != L->elem[j])
-        {
-            /* 将给元素前移至上一个元素之后. */
-            L->elem[++i] = L->elem[j];
-        }
+        return ERROR;
     }
 
-    /* 更新顺序表长度. */
-    L->length = i + 1;
+    if (threads > MERGE_MAX_THREADS)
+    {
+        threads = MERGE_MAX_THREADS;
+    }
+    if (threads > total / MERGE_MIN_SLICE)
+    {
+        threads = total / MERGE_MIN_SLICE > 0 ? total / MERGE_MIN_SLICE : 1;
+    }
 
-    return OK;
-}
+    /* 输出等分为 threads 段, 每段的起点由归并路径独立求出. */
+    MergeSlice slice[MERGE_MAX_THREADS];
+    pthread_t tid[MERGE_MAX_THREADS];
+    int spawned[MERGE_MAX_THREADS] = {0};
 
-Status Merge(SqList A, SqList B, SqList *C)
-{
-    if (A.length + B.length > LIST_MAX_SIZE)
+    for (int t = 0; t < threads; ++t)
     {
-        printf("合并结果大于顺序表最大长度.\n");
-        return ERROR;
+        slice[t].a = A.elem;
+        slice[t].alen = A.length;
+        slice[t].b = B.elem;
+        slice[t].blen = B.length;
+        slice[t].c = C->elem;
+        slice[t].begin = (int)((long long)total * t / threads);
+        slice[t].end = (int)((long long)total * (t + 1) / threads);
+    }
+
+    /* 第 0 段由当前线程归并; 线程创建失败时也由当前线程补上. */
+    for (int t = 1; t < threads; ++t)
+    {
+        spawned[t] = pthread_create(&tid[t], NULL, MergeWorker, &slice[t]) == 0;
     }
 
-    int i = 0, j = 0, k = 0;
+    MergeWorker(&slice[0]);
 
-    while (i < A.length && j < B.length)
+    for (int t = 1; t < threads; ++t)
     {
-        if (A.elem[i] < B.elem[j])
+        if (spawned[t])
         {
-            C->elem[k++] = A.elem[i++];
+            pthread_join(tid[t], NULL);
         }
         else
         {
-            C->elem[k++] = B.elem[j++];
+            MergeWorker(&slice[t]);
         }
     }
 
-    /* 还剩一个没有比较完的顺序表. */
-    while (i < A.length)
-    {
-        C->elem[k++] = A.elem[i++];
-    }
-    while (j < B.length)
-    {
-        C->elem[k++] = B.elem[j++];
-    }
-
-    C->length = k;
+    C->length = total;
 
     return OK;
 }
+
+Status Merge(SqList A, SqList B, SqList *C)
+{
+    return MergeParallel(A, B, C, 1);
+}
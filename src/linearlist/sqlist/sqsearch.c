@@ -0,0 +1,740 @@
+﻿/**
+ * @file sqsearch.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 子序列查找.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <string.h>
+
+#include <linearlist/sqlist/sqsearch.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SEARCH_HAVE_AVX2 1
+#define SEARCH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SEARCH_HAVE_AVX2 0
+#endif
+
+/**
+ * 以下三个算法对整数和字节序列各生成一份, 后缀 E 为 ElemType, B 为字节.
+ *
+ * MaxSuffix: 求 x 在某种字典序 (reverse 为真时取反序) 下的最大后缀的起点
+ * 减一, 以及该后缀的周期.
+ *
+ * TwoWay: Crochemore-Perrin 算法. 取两种字典序下最大后缀中靠后的一个作为
+ * 临界分解 x = u v (u = x[0..ell]), 先自左向右比较 v, 失配时按失配位置右移;
+ * v 匹配后再自右向左比较 u. 若 u 是 v 中周期的后缀 (模式是周期的), 匹配后
+ * 只右移一个周期, 并记住已比较过的前缀, 下次不再比较.
+ *
+ * KmpAll: 用前缀函数逐个元素推进, 找出全部匹配.
+ */
+#define DEFINE_SEARCH(S, T)                                                    \
+    static int MaxSuffix##S(const T *x, int m, int reverse, int *period)       \
+    {                                                                          \
+        int ms = -1, j = 0, k = 1, p = 1;                                      \
+                                                                               \
+        while (j + k < m)                                                      \
+        {                                                                      \
+            T a = x[j + k], b = x[ms + k];                                     \
+                                                                               \
+            if (reverse ? a > b : a < b)                                       \
+            {                                                                  \
+                j += k;                                                        \
+                k = 1;                                                         \
+                p = j - ms;                                                    \
+            }                                                                  \
+            else if (a == b)                                                   \
+            {                                                                  \
+                if (k != p)                                                    \
+                {                                                              \
+                    ++k;                                                       \
+                }                                                              \
+                else                                                           \
+                {                                                              \
+                    j += p;                                                    \
+                    k = 1;                                                     \
+                }                                                              \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                ms = j;                                                        \
+                j = ms + 1;                                                    \
+                k = p = 1;                                                     \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        *period = p;                                                           \
+        return ms;                                                             \
+    }                                                                          \
+                                                                               \
+    static int TwoWay##S(const T *y, int n, const T *x, int m, int from)       \
+    {                                                                          \
+        int p, q, per, i, j = from;                                            \
+        int ell = MaxSuffix##S(x, m, 0, &p);                                   \
+        int ell2 = MaxSuffix##S(x, m, 1, &q);                                  \
+                                                                               \
+        if (ell < ell2)                                                        \
+        {                                                                      \
+            ell = ell2;                                                        \
+            per = q;                                                           \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            per = p;                                                           \
+        }                                                                      \
+                                                                               \
+        if (memcmp(x, x + per, sizeof(T) * (size_t)(ell + 1)) == 0)           \
+        {                                                                      \
+            /* 周期模式, memory 为上次已匹配的前缀末尾. */                       \
+            int memory = -1;                                                   \
+                                                                               \
+            while (j <= n - m)                                                 \
+            {                                                                  \
+                i = (ell > memory ? ell : memory) + 1;                         \
+                while (i < m && x[i] == y[i + j])                              \
+                {                                                              \
+                    ++i;                                                       \
+                }                                                              \
+                if (i >= m)                                                    \
+                {                                                              \
+                    i = ell;                                                   \
+                    while (i > memory && x[i] == y[i + j])                     \
+                    {                                                          \
+                        --i;                                                   \
+                    }                                                          \
+                    if (i <= memory)                                           \
+                    {                                                          \
+                        return j;                                              \
+                    }                                                          \
+                    j += per;                                                  \
+                    memory = m - per - 1;                                      \
+                }                                                              \
+                else                                                           \
+                {                                                              \
+                    j += i - ell;                                              \
+                    memory = -1;                                               \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            /* 非周期模式, 匹配后可以右移 max(|u|, |v|) + 1. */                 \
+            per = (ell + 1 > m - ell - 1 ? ell + 1 : m - ell - 1) + 1;         \
+                                                                               \
+            while (j <= n - m)                                                 \
+            {                                                                  \
+                i = ell + 1;                                                   \
+                while (i < m && x[i] == y[i + j])                              \
+                {                                                              \
+                    ++i;                                                       \
+                }                                                              \
+                if (i >= m)                                                    \
+                {                                                              \
+                    i = ell;                                                   \
+                    while (i >= 0 && x[i] == y[i + j])                         \
+                    {                                                          \
+                        --i;                                                   \
+                    }                                                          \
+                    if (i < 0)                                                 \
+                    {                                                          \
+                        return j;                                              \
+                    }                                                          \
+                    j += per;                                                  \
+                }                                                              \
+                else                                                           \
+                {                                                              \
+                    j += i - ell;                                              \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    static void Prefix##S(const T *p, int m, int *fail)                        \
+    {                                                                          \
+        fail[0] = 0;                                                           \
+        for (int i = 1, q = 0; i < m; ++i)                                     \
+        {                                                                      \
+            while (q > 0 && p[q] != p[i])                                      \
+            {                                                                  \
+                q = fail[q - 1];                                               \
+            }                                                                  \
+            q += p[q] == p[i];                                                 \
+            fail[i] = q;                                                       \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static int KmpAll##S(const T *t, int n, const T *p, int m, int *pos,       \
+                         int max)                                              \
+    {                                                                          \
+        int *fail = malloc(sizeof(int) * (size_t)m);                           \
+        /* 内存分配失败. */                                                    \
+        if (!fail)                                                             \
+        {                                                                      \
+            exit(OVERFLOW);                                                    \
+        }                                                                      \
+        Prefix##S(p, m, fail);                                                 \
+                                                                               \
+        int count = 0;                                                         \
+        for (int i = 0, q = 0; i < n; ++i)                                     \
+        {                                                                      \
+            while (q > 0 && p[q] != t[i])                                      \
+            {                                                                  \
+                q = fail[q - 1];                                               \
+            }                                                                  \
+            q += p[q] == t[i];                                                 \
+            if (q == m)                                                        \
+            {                                                                  \
+                if (pos && count < max)                                        \
+                {                                                              \
+                    pos[count] = i - m + 1;                                    \
+                }                                                              \
+                ++count;                                                       \
+                q = fail[q - 1];                                               \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        free(fail);                                                            \
+        return count;                                                          \
+    }
+
+DEFINE_SEARCH(E, ElemType)
+DEFINE_SEARCH(B, unsigned char)
+
+#if SEARCH_HAVE_AVX2
+static int HasAvx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+/**
+ * 首尾元素预筛. 每次取 8 个候选起点, 比较它们的首元素和尾元素, 都相等的再
+ * 逐个验证中间部分. 验证累计比较的元素数超过已扫描长度的两倍 (加上 4m 的
+ * 余量) 时, 说明文本和模式高度重复, 剩余部分交给 Two-Way.
+ */
+SEARCH_TARGET_AVX2 static int SearchAvx2E(const ElemType *t, int n,
+                                          const ElemType *p, int m, int from)
+{
+    const __m256i first = _mm256_set1_epi32(p[0]);
+    const __m256i last = _mm256_set1_epi32(p[m - 1]);
+    long long work = 0;
+    int j = from;
+
+    while (j + m - 1 + 8 <= n)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(t + j));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(t + j + m - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi32(a, first),
+                                      _mm256_cmpeq_epi32(b, last));
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+
+        while (mask)
+        {
+            int s = j + __builtin_ctz(mask), k = 1;
+
+            while (k < m - 1 && t[s + k] == p[k])
+            {
+                ++k;
+            }
+            if (k >= m - 1)
+            {
+                return s;
+            }
+
+            work += k;
+            mask &= mask - 1;
+        }
+
+        j += 8;
+        if (work > 2LL * (j - from) + 4LL * m)
+        {
+            break;
+        }
+    }
+
+    return TwoWayE(t, n, p, m, j);
+}
+
+/* 同 SearchAvx2E(), 每次 32 个字节. */
+SEARCH_TARGET_AVX2 static int SearchAvx2B(const unsigned char *t, int n,
+                                          const unsigned char *p, int m,
+                                          int from)
+{
+    const __m256i first = _mm256_set1_epi8((char)p[0]);
+    const __m256i last = _mm256_set1_epi8((char)p[m - 1]);
+    long long work = 0;
+    int j = from;
+
+    while (j + m - 1 + 32 <= n)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(t + j));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(t + j + m - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                      _mm256_cmpeq_epi8(b, last));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(eq);
+
+        while (mask)
+        {
+            int s = j + __builtin_ctz(mask), k = 1;
+
+            while (k < m - 1 && t[s + k] == p[k])
+            {
+                ++k;
+            }
+            if (k >= m - 1)
+            {
+                return s;
+            }
+
+            work += k;
+            mask &= mask - 1;
+        }
+
+        j += 32;
+        if (work > 2LL * (j - from) + 4LL * m)
+        {
+            break;
+        }
+    }
+
+    return TwoWayB(t, n, p, m, j);
+}
+#endif
+
+void PrefixFunction(const ElemType *p, int m, int *fail)
+{
+    if (m > 0)
+    {
+        PrefixE(p, m, fail);
+    }
+}
+
+void ZFunction(const ElemType *s, int n, int *z)
+{
+    if (n == 0)
+    {
+        return;
+    }
+
+    z[0] = n;
+
+    /* [l, r) 为右端最远的一段已知与前缀相同的区间. */
+    for (int i = 1, l = 0, r = 0; i < n; ++i)
+    {
+        int k = 0;
+
+        if (i < r)
+        {
+            k = z[i - l] < r - i ? z[i - l] : r - i;
+        }
+        while (i + k < n && s[k] == s[i + k])
+        {
+            ++k;
+        }
+
+        z[i] = k;
+        if (i + k > r)
+        {
+            l = i;
+            r = i + k;
+        }
+    }
+}
+
+int SearchArray(const ElemType *t, int n, const ElemType *p, int m, int from)
+{
+    if (from < 0)
+    {
+        from = 0;
+    }
+    if (m < 0 || from > n || m > n - from)
+    {
+        return -1;
+    }
+    if (m == 0)
+    {
+        return from;
+    }
+
+#if SEARCH_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return SearchAvx2E(t, n, p, m, from);
+    }
+#endif
+
+    return TwoWayE(t, n, p, m, from);
+}
+
+int SearchBytes(const char *t, int n, const char *p, int m, int from)
+{
+    if (from < 0)
+    {
+        from = 0;
+    }
+    if (m < 0 || from > n || m > n - from)
+    {
+        return -1;
+    }
+    if (m == 0)
+    {
+        return from;
+    }
+
+#if SEARCH_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return SearchAvx2B((const unsigned char *)t, n,
+                           (const unsigned char *)p, m, from);
+    }
+#endif
+
+    return TwoWayB((const unsigned char *)t, n, (const unsigned char *)p, m,
+                   from);
+}
+
+int SearchAllArray(const ElemType *t, int n, const ElemType *p, int m,
+                   int *pos, int max)
+{
+    if (m < 1 || n < m)
+    {
+        return 0;
+    }
+
+    return KmpAllE(t, n, p, m, pos, max);
+}
+
+int SearchAllBytes(const char *t, int n, const char *p, int m, int *pos,
+                   int max)
+{
+    if (m < 1 || n < m)
+    {
+        return 0;
+    }
+
+    return KmpAllB((const unsigned char *)t, n, (const unsigned char *)p, m,
+                   pos, max);
+}
+
+Status InitMatcher(SeqMatcher *M, const ElemType *p, int m)
+{
+    if (m < 1)
+    {
+        return ERROR;
+    }
+
+    M->pattern = malloc(sizeof(ElemType) * (size_t)m);
+    M->fail = malloc(sizeof(int) * (size_t)m);
+    /* 内存分配失败. */
+    if (!M->pattern || !M->fail)
+    {
+        exit(OVERFLOW);
+    }
+
+    memcpy(M->pattern, p, sizeof(ElemType) * (size_t)m);
+    PrefixE(p, m, M->fail);
+    M->length = m;
+    M->state = 0;
+
+    return OK;
+}
+
+Status MatcherPush(SeqMatcher *M, ElemType e)
+{
+    int q = M->state;
+
+    while (q > 0 && M->pattern[q] != e)
+    {
+        q = M->fail[q - 1];
+    }
+    q += M->pattern[q] == e;
+
+    if (q == M->length)
+    {
+        M->state = M->fail[q - 1];
+        return TRUE;
+    }
+
+    M->state = q;
+
+    return FALSE;
+}
+
+void ResetMatcher(SeqMatcher *M)
+{
+    M->state = 0;
+}
+
+Status DestroyMatcher(SeqMatcher *M)
+{
+    free(M->pattern);
+    free(M->fail);
+    M->pattern = NULL;
+    M->fail = NULL;
+    M->length = 0;
+
+    return OK;
+}
+
+/* 新建一个结点, 返回其下标. */
+static int NewACNode(ACAutomaton *A)
+{
+    if (A->nodeCount == A->nodeSize)
+    {
+        int size = A->nodeSize ? 2 * A->nodeSize : 64;
+        ACNode *newbase = realloc(A->node, sizeof(ACNode) * (size_t)size);
+        /* 内存分配失败. */
+        if (!newbase)
+        {
+            exit(OVERFLOW);
+        }
+
+        A->node = newbase;
+        A->nodeSize = size;
+    }
+
+    ACNode *v = &A->node[A->nodeCount];
+    v->fail = 0;
+    v->output = 0;
+    v->pattern = -1;
+    v->edge = -1;
+    v->edgeCount = 0;
+
+    return A->nodeCount++;
+}
+
+/* 构造完成后的转移: 在 u 的有序孩子边中二分查找 e, 不存在时返回 -1. */
+static int Goto(const ACAutomaton *A, int u, ElemType e)
+{
+    int lo = A->node[u].edge, hi = lo + A->node[u].edgeCount;
+
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if (A->edge[mid].symbol < e)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo < A->node[u].edge + A->node[u].edgeCount && A->edge[lo].symbol == e
+               ? A->edge[lo].child
+               : -1;
+}
+
+static int CompareEdge(const void *a, const void *b)
+{
+    const ACEdge *x = a, *y = b;
+
+    if (x->parent != y->parent)
+    {
+        return x->parent < y->parent ? -1 : 1;
+    }
+
+    return (x->symbol > y->symbol) - (x->symbol < y->symbol);
+}
+
+Status InitAC(ACAutomaton *A)
+{
+    A->node = NULL;
+    A->nodeCount = A->nodeSize = 0;
+    A->edge = NULL;
+    A->edgeCount = A->edgeSize = 0;
+    A->state = 0;
+    A->position = 0;
+    A->built = FALSE;
+
+    /* 根结点. */
+    NewACNode(A);
+
+    return OK;
+}
+
+Status ACAddPattern(ACAutomaton *A, const ElemType *p, int m, int id)
+{
+    if (A->built || m < 1 || id < 0)
+    {
+        return ERROR;
+    }
+
+    int u = 0;
+    for (int i = 0; i < m; ++i)
+    {
+        /* 构造期间孩子边是链表, 边数组尚未排序. */
+        int k = A->node[u].edge;
+        while (k >= 0 && A->edge[k].symbol != p[i])
+        {
+            k = A->edge[k].sibling;
+        }
+
+        if (k >= 0)
+        {
+            u = A->edge[k].child;
+            continue;
+        }
+
+        if (A->edgeCount == A->edgeSize)
+        {
+            int size = A->edgeSize ? 2 * A->edgeSize : 64;
+            ACEdge *newbase = realloc(A->edge, sizeof(ACEdge) * (size_t)size);
+            /* 内存分配失败. */
+            if (!newbase)
+            {
+                exit(OVERFLOW);
+            }
+
+            A->edge = newbase;
+            A->edgeSize = size;
+        }
+
+        int v = NewACNode(A);
+        k = A->edgeCount++;
+        A->edge[k].parent = u;
+        A->edge[k].symbol = p[i];
+        A->edge[k].child = v;
+        A->edge[k].sibling = A->node[u].edge;
+        A->node[u].edge = k;
+        ++A->node[u].edgeCount;
+        u = v;
+    }
+
+    if (A->node[u].pattern < 0)
+    {
+        A->node[u].pattern = id;
+    }
+
+    return OK;
+}
+
+Status ACBuild(ACAutomaton *A)
+{
+    if (A->built)
+    {
+        return OK;
+    }
+
+    /* 孩子边按 (parent, symbol) 排序, 每个结点的边连续存放. */
+    qsort(A->edge, (size_t)A->edgeCount, sizeof(ACEdge), CompareEdge);
+    for (int k = A->edgeCount - 1; k >= 0; --k)
+    {
+        A->node[A->edge[k].parent].edge = k;
+    }
+
+    /* 按层 (BFS) 求失败链接, 父结点的失败链接总是先求出. */
+    int *queue = malloc(sizeof(int) * (size_t)A->nodeCount);
+    /* 内存分配失败. */
+    if (!queue)
+    {
+        exit(OVERFLOW);
+    }
+
+    int head = 0, tail = 0;
+    queue[tail++] = 0;
+    while (head < tail)
+    {
+        int u = queue[head++];
+        ACNode *U = &A->node[u];
+
+        for (int k = U->edge; k < U->edge + U->edgeCount; ++k)
+        {
+            int v = A->edge[k].child, f = 0;
+            ElemType e = A->edge[k].symbol;
+
+            if (u != 0)
+            {
+                int g = U->fail;
+                while (g != 0 && Goto(A, g, e) < 0)
+                {
+                    g = A->node[g].fail;
+                }
+
+                f = Goto(A, g, e);
+                if (f < 0)
+                {
+                    f = 0;
+                }
+            }
+
+            A->node[v].fail = f;
+            A->node[v].output =
+                A->node[f].pattern >= 0 ? f : A->node[f].output;
+            queue[tail++] = v;
+        }
+    }
+
+    free(queue);
+    A->built = TRUE;
+
+    return OK;
+}
+
+int ACPush(ACAutomaton *A, ElemType e, ACMatch match, void *arg)
+{
+    int s = A->state, g, count = 0;
+
+    while ((g = Goto(A, s, e)) < 0 && s != 0)
+    {
+        s = A->node[s].fail;
+    }
+    s = g < 0 ? 0 : g;
+    A->state = s;
+
+    /* 本结点及沿输出链接的各结点上结束的模式都在此匹配. */
+    for (int o = A->node[s].pattern >= 0 ? s : A->node[s].output; o;
+         o = A->node[o].output)
+    {
+        if (match)
+        {
+            match(A->node[o].pattern, A->position, arg);
+        }
+        ++count;
+    }
+
+    ++A->position;
+
+    return count;
+}
+
+long long ACFeed(ACAutomaton *A, const ElemType *t, int n, ACMatch match,
+                 void *arg)
+{
+    long long count = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        count += ACPush(A, t[i], match, arg);
+    }
+
+    return count;
+}
+
+void ACReset(ACAutomaton *A)
+{
+    A->state = 0;
+    A->position = 0;
+}
+
+Status DestroyAC(ACAutomaton *A)
+{
+    free(A->node);
+    free(A->edge);
+    A->node = NULL;
+    A->edge = NULL;
+    A->nodeCount = A->nodeSize = 0;
+    A->edgeCount = A->edgeSize = 0;
+
+    return OK;
+}
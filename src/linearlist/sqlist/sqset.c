@@ -0,0 +1,377 @@
+﻿/**
+ * @file sqset.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 有序集合的交, 并, 差.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include <linearlist/sqlist/sqset.h>
+
+/**
+ * x86 上 SSE2 总是可用, 4 x 4 的块比较直接编译; AVX2 的 8 x 8 版本用 target
+ * 属性单独编译, 运行时检测 CPU 后选用. 其他平台只用标量版本.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SET_HAVE_AVX2 1
+#define SET_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SET_HAVE_AVX2 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SET_HAVE_SSE2 1
+#else
+#define SET_HAVE_SSE2 0
+#endif
+
+/**
+ * @brief 倍增查找: 在 b[lo..n) 中找第一个不小于 x 的位置, 不存在时返回 n.
+ * 先以 1, 2, 4, ... 为步长向后跳, 再在最后一步内二分.
+ */
+static int Gallop(const ElemType *b, int lo, int n, ElemType x)
+{
+    int step = 1, hi = lo;
+
+    /* 先与 n - hi 比较再相加, hi + step 不会溢出. 设起点为 lo0, 始终有
+     * hi = lo0 + step - 1, 跳过后 hi < n, 所以加倍后的 step 不超过 n. */
+    while (hi < n && b[hi] < x)
+    {
+        lo = hi + 1;
+        if (step >= n - hi)
+        {
+            hi = n;
+            break;
+        }
+        hi += step;
+        step <<= 1;
+    }
+
+    /* 答案在 [lo, hi] 中. */
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if (b[mid] < x)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/* 小集合 a 的每个元素在大集合 b 中倍增查找. */
+static int IntersectGallop(const ElemType *a, int m, const ElemType *b, int n,
+                           ElemType *c)
+{
+    int k = 0, j = 0;
+
+    for (int i = 0; i < m && j < n; ++i)
+    {
+        j = Gallop(b, j, n, a[i]);
+        if (j < n && b[j] == a[i])
+        {
+            c[k++] = a[i];
+        }
+    }
+
+    return k;
+}
+
+/* 标量归并, 没有分支: 先写出 a[i], 相等时才移动写位置. */
+static int IntersectScalar(const ElemType *a, int i, int m, const ElemType *b,
+                           int j, int n, ElemType *c, int k)
+{
+    while (i < m && j < n)
+    {
+        ElemType x = a[i], y = b[j];
+
+        c[k] = x;
+        k += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+
+    return k;
+}
+
+#if SET_HAVE_SSE2
+/* 4 x 4 块比较. 块内没有相等元素, 所以 a 的每个元素至多被写出一次. */
+static int IntersectSse2(const ElemType *a, int m, const ElemType *b, int n,
+                         ElemType *c)
+{
+    int i = 0, j = 0, k = 0;
+
+    while (m - i >= 4 && n - j >= 4)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(
+                                  va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(
+                                  va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(
+                                  va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (mask)
+        {
+            int t = __builtin_ctz(mask);
+            c[k++] = a[i + t];
+            mask &= mask - 1;
+        }
+
+        ElemType amax = a[i + 3], bmax = b[j + 3];
+        i += amax <= bmax ? 4 : 0;
+        j += bmax <= amax ? 4 : 0;
+    }
+
+    return IntersectScalar(a, i, m, b, j, n, c, k);
+}
+#endif
+
+#if SET_HAVE_AVX2
+/* 8 x 8 块比较, b 块用 7 次跨 128 位的循环移位. */
+SET_TARGET_AVX2 static int IntersectAvx2(const ElemType *a, int m,
+                                         const ElemType *b, int n, ElemType *c)
+{
+    int i = 0, j = 0, k = 0;
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+    while (m - i >= 8 && n - j >= 8)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+        __m256i eq = _mm256_cmpeq_epi32(va, vb);
+
+        for (int r = 1; r < 8; ++r)
+        {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+        }
+
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        while (mask)
+        {
+            int t = __builtin_ctz(mask);
+            c[k++] = a[i + t];
+            mask &= mask - 1;
+        }
+
+        ElemType amax = a[i + 7], bmax = b[j + 7];
+        i += amax <= bmax ? 8 : 0;
+        j += bmax <= amax ? 8 : 0;
+    }
+
+    return IntersectScalar(a, i, m, b, j, n, c, k);
+}
+
+static int HasAvx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+int IntersectArray(const ElemType *a, int m, const ElemType *b, int n,
+                   ElemType *c)
+{
+    /* 让 a 为较小的集合. */
+    if (m > n)
+    {
+        const ElemType *t = a;
+        int s = m;
+        a = b;
+        b = t;
+        m = n;
+        n = s;
+    }
+
+    if (m == 0)
+    {
+        return 0;
+    }
+    if (n / m >= SET_GALLOP_RATIO)
+    {
+        return IntersectGallop(a, m, b, n, c);
+    }
+
+#if SET_HAVE_AVX2
+    if (HasAvx2())
+    {
+        return IntersectAvx2(a, m, b, n, c);
+    }
+#endif
+#if SET_HAVE_SSE2
+    return IntersectSse2(a, m, b, n, c);
+#else
+    return IntersectScalar(a, 0, m, b, 0, n, c, 0);
+#endif
+}
+
+/* b 远小于 a: 对 b 的每个元素在 a 中倍增查找, 之间的部分整段复制. */
+static int UnionGallop(const ElemType *a, int m, const ElemType *b, int n,
+                       ElemType *c)
+{
+    int i = 0, k = 0;
+
+    for (int j = 0; j < n; ++j)
+    {
+        int p = Gallop(a, i, m, b[j]);
+
+        memcpy(c + k, a + i, sizeof(ElemType) * (size_t)(p - i));
+        k += p - i;
+        c[k++] = b[j];
+        i = p < m && a[p] == b[j] ? p + 1 : p;
+    }
+
+    memcpy(c + k, a + i, sizeof(ElemType) * (size_t)(m - i));
+
+    return k + m - i;
+}
+
+int UnionArray(const ElemType *a, int m, const ElemType *b, int n, ElemType *c)
+{
+    if (m < n)
+    {
+        const ElemType *t = a;
+        int s = m;
+        a = b;
+        b = t;
+        m = n;
+        n = s;
+    }
+
+    if (n == 0 || m / n >= SET_GALLOP_RATIO)
+    {
+        return UnionGallop(a, m, b, n, c);
+    }
+
+    int i = 0, j = 0, k = 0;
+
+    /* 写出较小者, 相等时两边同时前进. */
+    while (i < m && j < n)
+    {
+        ElemType x = a[i], y = b[j];
+
+        c[k++] = x < y ? x : y;
+        i += x <= y;
+        j += y <= x;
+    }
+
+    memcpy(c + k, a + i, sizeof(ElemType) * (size_t)(m - i));
+    k += m - i;
+    memcpy(c + k, b + j, sizeof(ElemType) * (size_t)(n - j));
+
+    return k + n - j;
+}
+
+int DifferenceArray(const ElemType *a, int m, const ElemType *b, int n,
+                    ElemType *c)
+{
+    int i = 0, j = 0, k = 0;
+
+    if (m == 0 || n == 0)
+    {
+        memcpy(c, a, sizeof(ElemType) * (size_t)m);
+        return m;
+    }
+
+    /* a 远小于 b: a 的每个元素在 b 中查找. */
+    if (n / m >= SET_GALLOP_RATIO)
+    {
+        for (; i < m; ++i)
+        {
+            j = Gallop(b, j, n, a[i]);
+            if (j == n || b[j] != a[i])
+            {
+                c[k++] = a[i];
+            }
+        }
+
+        return k;
+    }
+
+    /* b 远小于 a: b 的每个元素在 a 中查找, 之间的部分整段复制. */
+    if (m / n >= SET_GALLOP_RATIO)
+    {
+        for (; j < n; ++j)
+        {
+            int p = Gallop(a, i, m, b[j]);
+
+            memcpy(c + k, a + i, sizeof(ElemType) * (size_t)(p - i));
+            k += p - i;
+            i = p < m && a[p] == b[j] ? p + 1 : p;
+        }
+    }
+    else
+    {
+        /* 写出 a[i], 只有 a[i] < b[j] 时才保留. */
+        while (i < m && j < n)
+        {
+            ElemType x = a[i], y = b[j];
+
+            c[k] = x;
+            k += x < y;
+            i += x <= y;
+            j += y <= x;
+        }
+    }
+
+    memcpy(c + k, a + i, sizeof(ElemType) * (size_t)(m - i));
+
+    return k + m - i;
+}
+
+Status Intersect_Sq(SqList A, SqList B, SqList *C)
+{
+    if (ListReserve_Sq(C, A.length < B.length ? A.length : B.length) != OK)
+    {
+        return ERROR;
+    }
+    C->length = IntersectArray(A.elem, A.length, B.elem, B.length, C->elem);
+
+    return OK;
+}
+
+Status Union_Sq(SqList A, SqList B, SqList *C)
+{
+    if (A.length > INT_MAX - B.length)
+    {
+        return ERROR;
+    }
+
+    if (ListReserve_Sq(C, A.length + B.length) != OK)
+    {
+        return ERROR;
+    }
+    C->length = UnionArray(A.elem, A.length, B.elem, B.length, C->elem);
+
+    return OK;
+}
+
+Status Difference_Sq(SqList A, SqList B, SqList *C)
+{
+    if (ListReserve_Sq(C, A.length) != OK)
+    {
+        return ERROR;
+    }
+    C->length = DifferenceArray(A.elem, A.length, B.elem, B.length, C->elem);
+
+    return OK;
+}
@@ -0,0 +1,282 @@
+﻿/**
+ * @file sqsorted.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 有序顺序表的查找实现.
+ * @version 0.2
+ * @date 2020-12-01
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <stdint.h>
+
+#include <linearlist/sqlist/sqsorted.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define PREFETCH(p) ((void)(p))
+#endif
+
+/* 批量查找时同步推进的关键字个数. */
+#define BATCH_SIZE 16
+
+/* 缓存行字节数. */
+#define CACHE_LINE 64
+
+Status ListSorted_Sq(SqList L)
+{
+    for (int i = 1; i < L.length; ++i)
+    {
+        if (L.elem[i] < L.elem[i - 1])
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * 返回 a[0..n-1] 中第一个不小于 e (upper 为真时为大于 e) 的元素的下标. 每步
+ * 把区间 [base, base + n) 砍掉一半, 中点比较的结果只用来选择 base, 编译器
+ * 生成条件传送而不是分支. 可能的两个下一个中点都提前预取.
+ */
+static int BranchlessSearch(const ElemType *a, int n, ElemType e, int upper)
+{
+    const ElemType *base = a;
+
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    while (n > 1)
+    {
+        int half = n >> 1;
+
+        PREFETCH(base + (half >> 1));
+        PREFETCH(base + half + (half >> 1));
+
+        base = (upper ? base[half] <= e : base[half] < e) ? base + half : base;
+        n -= half;
+    }
+
+    return (int)(base - a) + (upper ? *base <= e : *base < e);
+}
+
+int LowerBound_Sq(SqList L, ElemType e)
+{
+    return BranchlessSearch(L.elem, L.length, e, 0) + 1;
+}
+
+int UpperBound_Sq(SqList L, ElemType e)
+{
+    return BranchlessSearch(L.elem, L.length, e, 1) + 1;
+}
+
+Status LowerBoundBatch_Sq(SqList L, const ElemType *e, int n, int *pos)
+{
+    const ElemType *base[BATCH_SIZE];
+
+    for (int i = 0; i < n; i += BATCH_SIZE)
+    {
+        int m = n - i < BATCH_SIZE ? n - i : BATCH_SIZE;
+        int len = L.length;
+
+        if (len == 0)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                pos[i + j] = 1;
+            }
+            continue;
+        }
+
+        for (int j = 0; j < m; ++j)
+        {
+            base[j] = L.elem;
+        }
+
+        /* 一组关键字同步二分, 每层发出 m 个互不依赖的访存. */
+        while (len > 1)
+        {
+            int half = len >> 1;
+
+            for (int j = 0; j < m; ++j)
+            {
+                PREFETCH(base[j] + (half >> 1));
+                PREFETCH(base[j] + half + (half >> 1));
+                base[j] = base[j][half] < e[i + j] ? base[j] + half : base[j];
+            }
+            len -= half;
+        }
+
+        for (int j = 0; j < m; ++j)
+        {
+            pos[i + j] = (int)(base[j] - L.elem) + (*base[j] < e[i + j]) + 1;
+        }
+    }
+
+    return OK;
+}
+
+Status SortedInsert_Sq(SqList *L, ElemType e)
+{
+    return ListInsert_Sq(L, UpperBound_Sq(*L, e), e);
+}
+
+Status InitEytzinger_Sq(SqEytzinger *E, SqList L)
+{
+    int n = L.length;
+
+    /* 多分配一个缓存行用于对齐, 使 tree[16k] 总在缓存行起始处. */
+    E->block = malloc(sizeof(ElemType) * ((size_t)n + 1) + CACHE_LINE);
+    E->rank = (int *)malloc(sizeof(int) * ((size_t)n + 1));
+    if (!E->block || !E->rank)
+    {
+        exit(OVERFLOW);
+    }
+
+    E->tree = (ElemType *)(((uintptr_t)E->block + CACHE_LINE - 1) &
+                           ~(uintptr_t)(CACHE_LINE - 1));
+    E->length = n;
+
+    /**
+     * 按中序遍历完全二叉树 1..n, 依次填入有序表中的元素. 用栈模拟递归: 一路
+     * 向左孩子下行, 回溯时访问结点再转向右孩子.
+     */
+    unsigned int stack[64];
+    int top = 0, i = 0;
+    unsigned int k = 1;
+
+    while (k <= (unsigned int)n || top > 0)
+    {
+        if (k <= (unsigned int)n)
+        {
+            stack[top++] = k;
+            k = 2 * k;
+        }
+        else
+        {
+            k = stack[--top];
+            E->tree[k] = L.elem[i];
+            E->rank[k] = ++i;
+            k = 2 * k + 1;
+        }
+    }
+
+    return OK;
+}
+
+Status DestroyEytzinger_Sq(SqEytzinger *E)
+{
+    free(E->block);
+    free(E->rank);
+
+    E->block = NULL;
+    E->tree = NULL;
+    E->rank = NULL;
+    E->length = 0;
+
+    return OK;
+}
+
+/**
+ * 下行结束时 k 的二进制表示记录了路径: 最后一次向左之后全是向右. 去掉末尾的
+ * 1 和最后一个 0, 就回到了最后一次向左的结点, 即所求结点. k 为 0 表示一直
+ * 向右, 所有元素都比 e 小.
+ */
+static unsigned int LastLeftTurn(unsigned int k)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> (__builtin_ctz(~k) + 1);
+#else
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+    return k >> 1;
+#endif
+}
+
+static int EytzingerSearch(const SqEytzinger *E, ElemType e, int upper)
+{
+    const ElemType *tree = E->tree;
+    unsigned int n = (unsigned int)E->length;
+    unsigned int k = 1;
+
+    while (k <= n)
+    {
+        /* tree[16k..16k+15] 是 k 往下第 4 层的全部后代. */
+        PREFETCH(tree + 16 * (size_t)k);
+        k = 2 * k + (upper ? tree[k] <= e : tree[k] < e);
+    }
+
+    k = LastLeftTurn(k);
+
+    return k ? E->rank[k] : E->length + 1;
+}
+
+int EytzingerLowerBound_Sq(const SqEytzinger *E, ElemType e)
+{
+    return EytzingerSearch(E, e, 0);
+}
+
+int EytzingerUpperBound_Sq(const SqEytzinger *E, ElemType e)
+{
+    return EytzingerSearch(E, e, 1);
+}
+
+Status EytzingerLowerBoundBatch_Sq(const SqEytzinger *E, const ElemType *e,
+                                   int n, int *pos)
+{
+    const ElemType *tree = E->tree;
+    unsigned int length = (unsigned int)E->length;
+    unsigned int k[BATCH_SIZE];
+
+    /* 前 depth 层是满的, 所有关键字都要走完这几层, 可以同步推进. */
+    int depth = 0;
+    while (((2u << depth) - 1) <= length && depth < 31)
+    {
+        ++depth;
+    }
+
+    for (int i = 0; i < n; i += BATCH_SIZE)
+    {
+        int m = n - i < BATCH_SIZE ? n - i : BATCH_SIZE;
+
+        for (int j = 0; j < m; ++j)
+        {
+            k[j] = 1;
+        }
+
+        for (int d = 0; d < depth; ++d)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                PREFETCH(tree + 16 * (size_t)k[j]);
+                k[j] = 2 * k[j] + (tree[k[j]] < e[i + j]);
+            }
+        }
+
+        /* 最后一层不满, 有的关键字还要再走一步. */
+        for (int j = 0; j < m; ++j)
+        {
+            unsigned int x = k[j];
+            if (x <= length)
+            {
+                x = 2 * x + (tree[x] < e[i + j]);
+            }
+
+            x = LastLeftTurn(x);
+            pos[i + j] = x ? E->rank[x] : E->length + 1;
+        }
+    }
+
+    return OK;
+}
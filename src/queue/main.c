@@ -9,14 +9,17 @@
  * 
  */
 #include <linkqueue.h>
+#include <ringqueue.h>
 #include <sqqueue.h>
 
 void UseSqqueue();
 void UseLinkqueue();
+void UseRingqueue();
 
 int main()
 {
     UseSqqueue();
+    UseRingqueue();
 
     system("pause");
 
@@ -54,7 +57,7 @@ void UseSqqueue()
     SqQueue P;
     InitQueueSq(&P);
 
-    DestoryQueueSq(&Q);
+    DestoryQueueSq(&P);
 
     return;
 }
@@ -97,3 +100,44 @@ void UseLinkqueue()
 
     return;
 }
+
+void UseRingqueue()
+{
+    RingQueue Q;
+    QueueElemType e;
+
+    /* 初始容量为 4, 入队 5 个元素时扩充为 8. */
+    InitQueueRing(&Q, 4, FALSE);
+
+    for (int i = 1; i <= 3; ++i)
+    {
+        EnQueueRing(&Q, i);
+    }
+
+    /* 出队两个后再入队, 队尾回绕到存储空间的开头. */
+    DeQueueRing(&Q, &e);
+    DeQueueRing(&Q, &e);
+    for (int i = 4; i <= 7; ++i)
+    {
+        EnQueueRing(&Q, i);
+    }
+
+    PrintQueueRing(Q);
+    printf("length = %zu, capacity = %zu\n", QueueLengthRing(Q),
+           QueueCapacityRing(Q));
+
+    DestoryQueueRing(&Q);
+
+    /* 固定容量的队列满时入队返回 ERROR. */
+    InitQueueRing(&Q, 2, TRUE);
+    EnQueueRing(&Q, 1);
+    EnQueueRing(&Q, 2);
+    if (EnQueueRing(&Q, 3) == ERROR)
+    {
+        printf("fixed queue full, capacity = %zu\n", QueueCapacityRing(Q));
+    }
+
+    DestoryQueueRing(&Q);
+
+    return;
+}
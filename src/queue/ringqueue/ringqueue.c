@@ -0,0 +1,194 @@
+﻿/**
+ * @file ringqueue.c
+ * @author tianshihao4944@126.com
+ * @brief 环形缓冲队列方法实现.
+ * @version 0.2
+ * @date 2020-11-22
+ * @copyright Copyright (c) 2020
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <ringqueue.h>
+
+/* 不小于 n 的 2 的幂, 超出范围时返回 0. */
+static size_t RoundUpPower(size_t n)
+{
+    size_t capacity = 1;
+
+    while (capacity < n)
+    {
+        if (capacity > SIZE_MAX / 2 / sizeof(QueueElemType))
+        {
+            return 0;
+        }
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+/* 把存储空间扩充为 capacity, capacity 为 2 的幂且大于当前容量. */
+static void Resize(RingQueue *Q, size_t capacity)
+{
+    size_t old = Q->mask + 1;
+    size_t length = Q->tail - Q->head;
+    size_t first = Q->head & Q->mask;
+
+    QueueElemType *base = realloc(Q->base, capacity * sizeof(QueueElemType));
+    /* 如果内存分配失败. */
+    if (!base)
+    {
+        exit(OVERFLOW);
+    }
+
+    /**
+     * 展开环: realloc 后 [first, old) 一段原地不动, 回绕到开头的 wrapped 个元素
+     * 接到 old 之后. 新容量至少是原来的两倍, 接上后不会再回绕.
+     */
+    if (first + length > old)
+    {
+        size_t wrapped = first + length - old;
+        memcpy(base + old, base, wrapped * sizeof(QueueElemType));
+    }
+
+    Q->base = base;
+    Q->mask = capacity - 1;
+    Q->head = first;
+    Q->tail = first + length;
+}
+
+Status InitQueueRing(RingQueue *Q, size_t capacity, Status fixed)
+{
+    capacity = RoundUpPower(capacity ? capacity : RING_QUEUE_INIT_SIZE);
+    if (capacity == 0)
+    {
+        return ERROR;
+    }
+
+    /* 为队列申请内存空间. */
+    Q->base = (QueueElemType *)malloc(capacity * sizeof(QueueElemType));
+    /* 如果内存分配失败. */
+    if (!Q->base)
+    {
+        exit(OVERFLOW);
+    }
+
+    Q->mask = capacity - 1;
+    Q->head = Q->tail = 0;
+    Q->fixed = fixed;
+
+    return OK;
+}
+
+Status QueueEmptyRing(RingQueue Q)
+{
+    return Q.head == Q.tail;
+}
+
+Status QueueFullRing(RingQueue Q)
+{
+    return Q.tail - Q.head == Q.mask + 1;
+}
+
+Status ReserveQueueRing(RingQueue *Q, size_t n)
+{
+    if (n <= Q->mask + 1)
+    {
+        return OK;
+    }
+
+    size_t capacity = RoundUpPower(n);
+    if (capacity == 0)
+    {
+        return ERROR;
+    }
+
+    Resize(Q, capacity);
+
+    return OK;
+}
+
+Status EnQueueRing(RingQueue *Q, QueueElemType e)
+{
+    /* 如果队列已满. */
+    if (Q->tail - Q->head == Q->mask + 1)
+    {
+        if (Q->fixed || Q->mask + 1 > SIZE_MAX / 2 / sizeof(QueueElemType))
+        {
+            return ERROR;
+        }
+
+        /* 容量加倍, 入队均摊 O(1). */
+        Resize(Q, 2 * (Q->mask + 1));
+    }
+
+    /* 新元素入队尾. */
+    Q->base[Q->tail & Q->mask] = e;
+    ++Q->tail;
+
+    return OK;
+}
+
+Status DeQueueRing(RingQueue *Q, QueueElemType *e)
+{
+    /* 如果队列为空. */
+    if (Q->head == Q->tail)
+    {
+        return ERROR;
+    }
+
+    /* 队头元素出队. */
+    *e = Q->base[Q->head & Q->mask];
+    ++Q->head;
+
+    return OK;
+}
+
+Status GetHeadRing(RingQueue Q, QueueElemType *e)
+{
+    /* 如果队列为空. */
+    if (Q.head == Q.tail)
+    {
+        return ERROR;
+    }
+
+    *e = Q.base[Q.head & Q.mask];
+
+    return OK;
+}
+
+size_t QueueLengthRing(RingQueue Q)
+{
+    return Q.tail - Q.head;
+}
+
+size_t QueueCapacityRing(RingQueue Q)
+{
+    return Q.mask + 1;
+}
+
+Status DestoryQueueRing(RingQueue *Q)
+{
+    free(Q->base);
+
+    Q->base = NULL;
+    Q->mask = 0;
+    Q->head = Q->tail = 0;
+
+    return OK;
+}
+
+void PrintQueueRing(RingQueue Q)
+{
+    printf("Print ring queue:\n");
+    printf("        <-front ");
+
+    for (size_t p = Q.head; p != Q.tail; ++p)
+    {
+        printf(" %d ", Q.base[p & Q.mask]);
+    }
+
+    printf(" <-rear\n");
+}
@@ -0,0 +1,269 @@
+﻿/**
+ * @file spscbench.c
+ * @author tianshihao4944@126.com
+ * @brief 单生产者单消费者队列的吞吐量测试.
+ * @version 0.2
+ * @date 2020-11-22
+ * @copyright Copyright (c) 2020
+ */
+
+/* 绑定 CPU 用到 GNU 扩展. */
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <ringqueue.h>
+#include <spscqueue.h>
+
+/* 队列容量. */
+#define SPSC_BENCH_CAPACITY 4096
+
+/* 自旋这么多次仍然队满或队空时让出 CPU. */
+#define SPSC_BENCH_SPIN 64
+
+/* 测试方式. */
+typedef enum BenchMode
+{
+    MODE_MUTEX,  // 互斥锁保护的 RingQueue, 即原来的做法.
+    MODE_SINGLE, // SpscQueue, 逐个入队出队.
+    MODE_BATCH   // SpscQueue, 批量入队出队.
+} BenchMode;
+
+/* 测试参数和共享状态. */
+typedef struct Bench
+{
+    BenchMode mode;
+    long long items;
+    size_t batch;
+    int cpu[2];
+    SpscQueue spsc;
+    RingQueue ring;
+    pthread_mutex_t lock;
+    /* 消费者校验的结果, 顺序和内容都正确时为 OK. */
+    Status valid;
+} Bench;
+
+static double Now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 把当前线程绑定到 CPU cpu 上, cpu 为负数或不支持时不绑定. */
+static void Pin(int cpu)
+{
+#if defined(__linux__)
+    if (cpu >= 0)
+    {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        {
+            fprintf(stderr, "spscbench: cannot pin to cpu %d\n", cpu);
+        }
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+/* 队满或队空时等待另一端. 先自旋, 久等不到再让出 CPU. */
+static void Wait(int *spins)
+{
+    if (++*spins >= SPSC_BENCH_SPIN)
+    {
+        sched_yield();
+        *spins = 0;
+    }
+}
+
+/* 第 i 个元素的值. */
+static QueueElemType Item(long long i)
+{
+    return (QueueElemType)(i & 0x7fffffff);
+}
+
+static void *Producer(void *arg)
+{
+    Bench *B = arg;
+    QueueElemType buffer[SPSC_BENCH_CAPACITY];
+    int spins = 0;
+
+    Pin(B->cpu[0]);
+
+    for (long long i = 0; i < B->items;)
+    {
+        if (B->mode == MODE_BATCH)
+        {
+            size_t n = B->batch;
+            if ((long long)n > B->items - i)
+            {
+                n = (size_t)(B->items - i);
+            }
+            for (size_t k = 0; k < n; ++k)
+            {
+                buffer[k] = Item(i + (long long)k);
+            }
+
+            /* 队列剩余空间不足时分几次入队. */
+            for (size_t done = 0; done < n;)
+            {
+                size_t m = EnQueueBatchSpsc(&B->spsc, buffer + done, n - done);
+                if (m == 0)
+                {
+                    Wait(&spins);
+                }
+                done += m;
+            }
+            i += (long long)n;
+            continue;
+        }
+
+        Status s;
+        if (B->mode == MODE_SINGLE)
+        {
+            s = EnQueueSpsc(&B->spsc, Item(i));
+        }
+        else
+        {
+            pthread_mutex_lock(&B->lock);
+            s = EnQueueRing(&B->ring, Item(i));
+            pthread_mutex_unlock(&B->lock);
+        }
+
+        if (s == OK)
+        {
+            ++i;
+        }
+        else
+        {
+            Wait(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+static void *Consumer(void *arg)
+{
+    Bench *B = arg;
+    QueueElemType buffer[SPSC_BENCH_CAPACITY];
+    int spins = 0;
+
+    Pin(B->cpu[1]);
+
+    for (long long i = 0; i < B->items;)
+    {
+        size_t n = 0;
+
+        if (B->mode == MODE_BATCH)
+        {
+            n = DeQueueBatchSpsc(&B->spsc, buffer, B->batch);
+        }
+        else if (B->mode == MODE_SINGLE)
+        {
+            n = DeQueueSpsc(&B->spsc, &buffer[0]) == OK;
+        }
+        else
+        {
+            pthread_mutex_lock(&B->lock);
+            n = DeQueueRing(&B->ring, &buffer[0]) == OK;
+            pthread_mutex_unlock(&B->lock);
+        }
+
+        if (n == 0)
+        {
+            Wait(&spins);
+            continue;
+        }
+
+        /* 元素必须按入队的顺序一个不少地到达. */
+        for (size_t k = 0; k < n; ++k, ++i)
+        {
+            if (buffer[k] != Item(i))
+            {
+                B->valid = ERROR;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* 按 mode 测试一次, 返回每秒传递的元素个数 (百万). */
+static double Run(Bench *B, BenchMode mode)
+{
+    pthread_t producer, consumer;
+
+    B->mode = mode;
+    B->valid = OK;
+    InitQueueSpsc(&B->spsc, SPSC_BENCH_CAPACITY);
+    InitQueueRing(&B->ring, SPSC_BENCH_CAPACITY, TRUE);
+
+    double start = Now();
+    if (pthread_create(&consumer, NULL, Consumer, B) != 0 ||
+        pthread_create(&producer, NULL, Producer, B) != 0)
+    {
+        fprintf(stderr, "spscbench: cannot create threads\n");
+        exit(1);
+    }
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    double seconds = Now() - start;
+
+    DestoryQueueSpsc(&B->spsc);
+    DestoryQueueRing(&B->ring);
+
+    if (B->valid != OK)
+    {
+        fprintf(stderr, "spscbench: items lost or reordered\n");
+        exit(1);
+    }
+
+    return seconds > 0 ? B->items / seconds / 1e6 : 0.0;
+}
+
+/**
+ * 用法: spscbench [items] [batch] [producerCpu consumerCpu]. 一个线程生产
+ * items 个元素, 另一个线程消费并校验, 分别用互斥锁保护的 RingQueue, 逐个
+ * 操作的 SpscQueue 和批量操作的 SpscQueue 传递, 输出每秒传递的元素个数. 两个
+ * 线程应当绑定在不同的物理核上, 默认为 0 号和 1 号 CPU, 传入 -1 不绑定.
+ */
+int main(int argc, char *argv[])
+{
+    static Bench B;
+
+    B.items = argc > 1 ? atoll(argv[1]) : 100000000;
+    B.batch = argc > 2 ? (size_t)atoi(argv[2]) : 256;
+    B.cpu[0] = argc > 4 ? atoi(argv[3]) : 0;
+    B.cpu[1] = argc > 4 ? atoi(argv[4]) : 1;
+
+    if (B.items < 1 || B.batch < 1 || B.batch > SPSC_BENCH_CAPACITY)
+    {
+        fprintf(stderr, "usage: spscbench [items] [batch <= %d] "
+                        "[producerCpu consumerCpu]\n",
+                SPSC_BENCH_CAPACITY);
+        return 1;
+    }
+
+    pthread_mutex_init(&B.lock, NULL);
+
+    printf("%lld items, capacity %d, batch %zu, cpu %d -> %d\n", B.items,
+           SPSC_BENCH_CAPACITY, B.batch, B.cpu[0], B.cpu[1]);
+    printf("%-14s %10.1f M items/s\n", "mutex ring", Run(&B, MODE_MUTEX));
+    printf("%-14s %10.1f M items/s\n", "spsc single", Run(&B, MODE_SINGLE));
+    printf("%-14s %10.1f M items/s\n", "spsc batch", Run(&B, MODE_BATCH));
+
+    pthread_mutex_destroy(&B.lock);
+
+    return 0;
+}
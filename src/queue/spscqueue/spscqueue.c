@@ -0,0 +1,163 @@
+﻿/**
+ * @file spscqueue.c
+ * @author tianshihao4944@126.com
+ * @brief 单生产者单消费者无锁环形队列方法实现.
+ * @version 0.2
+ * @date 2020-11-22
+ * @copyright Copyright (c) 2020
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <spscqueue.h>
+
+Status InitQueueSpsc(SpscQueue *Q, size_t capacity)
+{
+    size_t size = 1;
+
+    while (size < capacity)
+    {
+        if (size > SIZE_MAX / 2 / sizeof(QueueElemType))
+        {
+            return ERROR;
+        }
+        size *= 2;
+    }
+
+    /* 为队列申请内存空间. */
+    Q->base = (QueueElemType *)malloc(size * sizeof(QueueElemType));
+    /* 如果内存分配失败. */
+    if (!Q->base)
+    {
+        exit(OVERFLOW);
+    }
+
+    Q->mask = size - 1;
+    atomic_init(&Q->tail, 0);
+    atomic_init(&Q->head, 0);
+    Q->headCache = Q->tailCache = 0;
+
+    return OK;
+}
+
+Status DestoryQueueSpsc(SpscQueue *Q)
+{
+    free(Q->base);
+    Q->base = NULL;
+
+    return OK;
+}
+
+Status EnQueueSpsc(SpscQueue *Q, QueueElemType e)
+{
+    /* tail 只有自己写, 读自己的值不需要同步. */
+    size_t tail = atomic_load_explicit(&Q->tail, memory_order_relaxed);
+
+    /* 按缓存的 head 看来队满时, 才去读消费者的 head. */
+    if (tail - Q->headCache > Q->mask)
+    {
+        Q->headCache = atomic_load_explicit(&Q->head, memory_order_acquire);
+        if (tail - Q->headCache > Q->mask)
+        {
+            return ERROR;
+        }
+    }
+
+    Q->base[tail & Q->mask] = e;
+
+    /* 元素写完之后才让消费者看到新的 tail. */
+    atomic_store_explicit(&Q->tail, tail + 1, memory_order_release);
+
+    return OK;
+}
+
+Status DeQueueSpsc(SpscQueue *Q, QueueElemType *e)
+{
+    size_t head = atomic_load_explicit(&Q->head, memory_order_relaxed);
+
+    /* 按缓存的 tail 看来队空时, 才去读生产者的 tail. */
+    if (head == Q->tailCache)
+    {
+        Q->tailCache = atomic_load_explicit(&Q->tail, memory_order_acquire);
+        if (head == Q->tailCache)
+        {
+            return ERROR;
+        }
+    }
+
+    *e = Q->base[head & Q->mask];
+
+    /* 元素读完之后才把槽位还给生产者. */
+    atomic_store_explicit(&Q->head, head + 1, memory_order_release);
+
+    return OK;
+}
+
+size_t EnQueueBatchSpsc(SpscQueue *Q, const QueueElemType *e, size_t n)
+{
+    size_t tail = atomic_load_explicit(&Q->tail, memory_order_relaxed);
+    size_t space = Q->mask + 1 - (tail - Q->headCache);
+
+    if (space < n)
+    {
+        Q->headCache = atomic_load_explicit(&Q->head, memory_order_acquire);
+        space = Q->mask + 1 - (tail - Q->headCache);
+    }
+    if (n > space)
+    {
+        n = space;
+    }
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    /* 写入的一段可能回绕到存储空间开头, 分两段复制. */
+    size_t first = tail & Q->mask;
+    size_t part = Q->mask + 1 - first < n ? Q->mask + 1 - first : n;
+    memcpy(Q->base + first, e, part * sizeof(QueueElemType));
+    memcpy(Q->base, e + part, (n - part) * sizeof(QueueElemType));
+
+    atomic_store_explicit(&Q->tail, tail + n, memory_order_release);
+
+    return n;
+}
+
+size_t DeQueueBatchSpsc(SpscQueue *Q, QueueElemType *e, size_t n)
+{
+    size_t head = atomic_load_explicit(&Q->head, memory_order_relaxed);
+    size_t ready = Q->tailCache - head;
+
+    if (ready < n)
+    {
+        Q->tailCache = atomic_load_explicit(&Q->tail, memory_order_acquire);
+        ready = Q->tailCache - head;
+    }
+    if (n > ready)
+    {
+        n = ready;
+    }
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    size_t first = head & Q->mask;
+    size_t part = Q->mask + 1 - first < n ? Q->mask + 1 - first : n;
+    memcpy(e, Q->base + first, part * sizeof(QueueElemType));
+    memcpy(e + part, Q->base, (n - part) * sizeof(QueueElemType));
+
+    atomic_store_explicit(&Q->head, head + n, memory_order_release);
+
+    return n;
+}
+
+size_t QueueLengthSpsc(SpscQueue *Q)
+{
+    /* 先读 head 再读 tail, 差值不会是负数. */
+    size_t head = atomic_load_explicit(&Q->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&Q->tail, memory_order_acquire);
+
+    return tail - head;
+}
@@ -0,0 +1,522 @@
+﻿/**
+ * @file huffmancode.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 范式赫夫曼编码, 位流编码与查表译码.
+ * @version 0.2
+ * @date 2020-04-28
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <huffmantree.h>
+#include <string.h>
+
+/**
+ * 一级表项的布局 (64 位):
+ *   位 0-5   本表项共消耗的码流位数;
+ *   位 6-7   本表项给出的符号个数, 0 表示指向二级表或非法码字;
+ *   位 8-12  第一个符号的码长;
+ *   位 16-63 至多 3 个符号, 每个 16 位.
+ * 指向二级表的表项: 消耗 tableBits 位, 位 8-12 为二级表位数, 位 32-63 为二级
+ * 表在 table 中的偏移. 全 0 的表项表示非法码字.
+ */
+#define ENTRY_BITS(e) ((unsigned int)(e)&0x3f)
+#define ENTRY_COUNT(e) ((unsigned int)((e) >> 6) & 0x3)
+#define ENTRY_FIRST(e) ((unsigned int)((e) >> 8) & 0x1f)
+#define ENTRY_SYMBOL(e, k) ((unsigned int)((e) >> (16 + 16 * (k))) & 0xffff)
+#define ENTRY_OFFSET(e) ((unsigned int)((e) >> 32))
+
+/* 编码和译码的公共部分必须内联, 才能按符号宽度展开成两份无分支的循环. */
+#if defined(__GNUC__)
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define FORCE_INLINE static __forceinline
+#else
+#define FORCE_INLINE static inline
+#endif
+
+/* 按小端序读写 8 个字节. 用 memcpy 做非对齐访问, 编译器会生成一条指令. */
+static inline unsigned long long Load64LE(const unsigned char *p) {
+  unsigned long long v;
+
+  memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+
+  return v;
+}
+
+static inline void Store64LE(unsigned char *p, unsigned long long v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  memcpy(p, &v, 8);
+}
+
+/* 将 code 的低 len 位反转. */
+static unsigned int ReverseBits(unsigned int code, int len) {
+  unsigned int r = 0;
+
+  for (int i = 0; i < len; ++i) {
+    r = (r << 1) | (code & 1);
+    code >>= 1;
+  }
+
+  return r;
+}
+
+Status CreateCanonicalHuffman(CanonicalHuffman *H, const unsigned char *length,
+                              int n) {
+  if (n < 1 || n > HUFFMAN_MAX_SYMBOLS) {
+    return ERROR;
+  }
+
+  /* 统计各码长的符号个数. */
+  unsigned int count[HUFFMAN_MAX_CODE_LENGTH + 1] = {0};
+  int maxLength = 0;
+
+  for (int i = 0; i < n; ++i) {
+    if (length[i] > HUFFMAN_MAX_CODE_LENGTH) {
+      return ERROR;
+    }
+    ++count[length[i]];
+    maxLength = length[i] > maxLength ? length[i] : maxLength;
+  }
+
+  if (maxLength == 0) {
+    return ERROR;
+  }
+
+  /* 检查 Kraft 不等式, 并求出每个码长的第一个码字. */
+  unsigned int next[HUFFMAN_MAX_CODE_LENGTH + 1] = {0};
+  unsigned long long code = 0;
+
+  for (int len = 1; len <= maxLength; ++len) {
+    code = (code + count[len - 1] * (len > 1)) << 1;
+    next[len] = (unsigned int)code;
+    if (code + count[len] > (1ULL << len)) {
+      return ERROR;
+    }
+  }
+
+  H->n = n;
+  H->maxLength = maxLength;
+  H->length = malloc(n);
+  H->code = malloc(n * sizeof(unsigned int));
+  if (!H->length || !H->code) {
+    exit(OVERFLOW);
+  }
+
+  memcpy(H->length, length, n);
+  for (int i = 0; i < n; ++i) {
+    H->code[i] = length[i] ? ReverseBits(next[length[i]]++, length[i]) : 0;
+  }
+
+  return OK;
+}
+
+Status BuildCanonicalHuffman(CanonicalHuffman *H, const HTWeight *w, int n,
+                             int maxLength) {
+  unsigned char *length = malloc(n > 0 ? n : 1);
+  if (!length) {
+    exit(OVERFLOW);
+  }
+
+  Status s = LimitedCodeLengths(w, n, maxLength, length);
+  if (s == OK) {
+    s = CreateCanonicalHuffman(H, length, n);
+  }
+
+  free(length);
+
+  return s;
+}
+
+Status DestroyCanonicalHuffman(CanonicalHuffman *H) {
+  free(H->length);
+  free(H->code);
+  H->length = NULL;
+  H->code = NULL;
+  H->n = H->maxLength = 0;
+
+  return OK;
+}
+
+size_t HuffmanEncodeBound(size_t count, int maxLength) {
+  return (count * maxLength + 7) / 8 + 64;
+}
+
+/**
+ * @brief 编码的公共部分, wide 的用法同 DecodeCore().
+ * @note 位累加器中不足 8 位的部分留到下一次. 每次放入两个码字后整块写出 8 个
+ * 字节, 再按实际写满的字节数前移: 7 + 2 * 24 < 64, 不会溢出.
+ */
+FORCE_INLINE size_t EncodeCore(const CanonicalHuffman *H, const void *src,
+                               size_t count, unsigned char *dst, int wide) {
+  const unsigned int *code = H->code;
+  const unsigned char *length = H->length;
+  unsigned char *out = dst;
+  unsigned long long acc = 0;
+  unsigned int bits = 0;
+  size_t i = 0;
+
+  for (; i + 2 <= count; i += 2) {
+    unsigned int s0 = wide ? ((const HuffmanSymbol *)src)[i]
+                           : ((const unsigned char *)src)[i];
+    unsigned int s1 = wide ? ((const HuffmanSymbol *)src)[i + 1]
+                           : ((const unsigned char *)src)[i + 1];
+
+    acc |= (unsigned long long)code[s0] << bits;
+    bits += length[s0];
+    acc |= (unsigned long long)code[s1] << bits;
+    bits += length[s1];
+
+    Store64LE(out, acc);
+    out += bits >> 3;
+    acc >>= bits & ~7u;
+    bits &= 7;
+  }
+  if (i < count) {
+    unsigned int s0 = wide ? ((const HuffmanSymbol *)src)[i]
+                           : ((const unsigned char *)src)[i];
+
+    acc |= (unsigned long long)code[s0] << bits;
+    bits += length[s0];
+  }
+
+  Store64LE(out, acc);
+
+  return (size_t)(out - dst) + (bits + 7) / 8;
+}
+
+size_t HuffmanEncode(const CanonicalHuffman *H, const HuffmanSymbol *src,
+                     size_t count, unsigned char *dst) {
+  return EncodeCore(H, src, count, dst, 1);
+}
+
+size_t HuffmanEncodeBytes(const CanonicalHuffman *H, const unsigned char *src,
+                          size_t count, unsigned char *dst) {
+  return EncodeCore(H, src, count, dst, 0);
+}
+
+Status CreateHuffmanDecoder(HuffmanDecoder *D, const CanonicalHuffman *H) {
+  int tb = H->maxLength < HUFFMAN_TABLE_BITS ? H->maxLength
+                                             : HUFFMAN_TABLE_BITS;
+  unsigned int size = 1u << tb;
+  unsigned int mask = size - 1;
+
+  /* 第一步, 单符号表: 码长不超过 tb 的符号占据所有低位与其码字相同的表项. */
+  unsigned int *single = calloc(size, sizeof(unsigned int));
+  unsigned char *subBits = calloc(size, 1);
+  if (!single || !subBits) {
+    exit(OVERFLOW);
+  }
+
+  for (int s = 0; s < H->n; ++s) {
+    int len = H->length[s];
+    if (len == 0) {
+      continue;
+    }
+    if (len <= tb) {
+      for (unsigned int i = H->code[s]; i < size; i += 1u << len) {
+        single[i] = (unsigned int)s | (unsigned int)len << 16;
+      }
+    } else if (len - tb > subBits[H->code[s] & mask]) {
+      /* 长码字按低 tb 位分组, 每组的二级表位数取组内最长的剩余码长. */
+      subBits[H->code[s] & mask] = (unsigned char)(len - tb);
+    }
+  }
+
+  /* 第二步, 为各二级表分配空间. */
+  unsigned int total = size;
+  for (unsigned int i = 0; i < size; ++i) {
+    if (subBits[i]) {
+      total += 1u << subBits[i];
+    }
+  }
+
+  unsigned long long *table = calloc(total, sizeof(unsigned long long));
+  unsigned int *offset = calloc(size, sizeof(unsigned int));
+  if (!table || !offset) {
+    exit(OVERFLOW);
+  }
+
+  total = size;
+  for (unsigned int i = 0; i < size; ++i) {
+    if (subBits[i]) {
+      offset[i] = total;
+      table[i] = (unsigned long long)tb |
+                 (unsigned long long)subBits[i] << 8 |
+                 (unsigned long long)total << 32;
+      total += 1u << subBits[i];
+    }
+  }
+
+  for (int s = 0; s < H->n; ++s) {
+    int len = H->length[s];
+    if (len <= tb) {
+      continue;
+    }
+    unsigned int p = H->code[s] & mask;
+    unsigned int rest = len - tb;
+    for (unsigned int i = H->code[s] >> tb; i < (1u << subBits[p]);
+         i += 1u << rest) {
+      table[offset[p] + i] = (unsigned long long)rest | 1ULL << 6 |
+                             (unsigned long long)rest << 8 |
+                             (unsigned long long)s << 16;
+    }
+  }
+
+  /**
+   * 第三步, 多符号表项: 第一个符号译出后, 若剩余的已知位中还包含完整的码字,
+   * 就把后续符号也放进同一个表项, 至多 3 个.
+   */
+  for (unsigned int i = 0; i < size; ++i) {
+    if (!single[i]) {
+      continue;
+    }
+
+    unsigned long long e = 0;
+    unsigned int used = 0, k = 0, first = single[i] >> 16;
+    unsigned int idx = i;
+
+    while (k < 3) {
+      unsigned int t = single[idx];
+      unsigned int len = t >> 16;
+      if (!t || used + len > (unsigned int)tb) {
+        break;
+      }
+      e |= (unsigned long long)(t & 0xffff) << (16 + 16 * k);
+      used += len;
+      idx = i >> used;
+      ++k;
+    }
+
+    table[i] = e | used | (unsigned long long)k << 6 |
+               (unsigned long long)first << 8;
+  }
+
+  free(offset);
+  free(subBits);
+  free(single);
+
+  D->tableBits = tb;
+  D->tableSize = (int)total;
+  D->table = table;
+
+  return OK;
+}
+
+/* 低位先出的位流读取器. buf 中低 bits 位有效, 对应 in 之前已读入的字节. */
+typedef struct BitReader {
+  const unsigned char *in, *end;
+  unsigned long long buf;
+  unsigned int bits;
+} BitReader;
+
+/**
+ * @brief 快速路径的一步: 无分支地把位缓冲补到至少 56 位, 再连续查两次表, 每次
+ * 最多消耗 HUFFMAN_MAX_CODE_LENGTH 位. 每个表项都写 3 个符号, 再按实际个数
+ * 前移, 所以调用者要保证输出至少还剩 6 个位置, 输入至少还剩 8 个字节.
+ * @note wide 为常量, 内联后按符号宽度展开成两份循环.
+ */
+FORCE_INLINE Status DecodeStep(const HuffmanDecoder *D, BitReader *r,
+                               void *dst, size_t *pos, int wide) {
+  const unsigned long long *table = D->table;
+  const unsigned int tb = D->tableBits;
+  const unsigned long long mask = (1ULL << tb) - 1;
+
+  r->buf |= Load64LE(r->in) << r->bits;
+  r->in += (63 - r->bits) >> 3;
+  r->bits |= 56;
+
+  for (int k = 0; k < 2; ++k) {
+    unsigned long long e = table[r->buf & mask];
+    if (ENTRY_COUNT(e) == 0) {
+      if (ENTRY_BITS(e) == 0) {
+        return ERROR;
+      }
+      r->buf >>= tb;
+      r->bits -= tb;
+      e = table[ENTRY_OFFSET(e) + (r->buf & ((1ULL << ENTRY_FIRST(e)) - 1))];
+      if (ENTRY_COUNT(e) == 0) {
+        return ERROR;
+      }
+    }
+
+    if (wide) {
+      HuffmanSymbol *out = (HuffmanSymbol *)dst + *pos;
+      out[0] = (HuffmanSymbol)ENTRY_SYMBOL(e, 0);
+      out[1] = (HuffmanSymbol)ENTRY_SYMBOL(e, 1);
+      out[2] = (HuffmanSymbol)ENTRY_SYMBOL(e, 2);
+    } else {
+      unsigned char *out = (unsigned char *)dst + *pos;
+      out[0] = (unsigned char)ENTRY_SYMBOL(e, 0);
+      out[1] = (unsigned char)ENTRY_SYMBOL(e, 1);
+      out[2] = (unsigned char)ENTRY_SYMBOL(e, 2);
+    }
+    *pos += ENTRY_COUNT(e);
+    r->buf >>= ENTRY_BITS(e);
+    r->bits -= ENTRY_BITS(e);
+  }
+
+  return OK;
+}
+
+/**
+ * @brief 译出一段码流中 [pos, count) 的符号. 先走快速路径, 剩余部分逐字节补充
+ * 位缓冲, 每次只取表项中的第一个符号, 并检查码流是否越界.
+ */
+FORCE_INLINE Status DecodeStream(const HuffmanDecoder *D, BitReader *r,
+                                 void *dst, size_t pos, size_t count,
+                                 int wide) {
+  const unsigned long long *table = D->table;
+  const unsigned int tb = D->tableBits;
+  const unsigned long long mask = (1ULL << tb) - 1;
+
+  while (pos + 6 <= count && r->in + 8 <= r->end) {
+    if (DecodeStep(D, r, dst, &pos, wide) != OK) {
+      return ERROR;
+    }
+  }
+
+  while (pos < count) {
+    while (r->bits <= 56 && r->in < r->end) {
+      r->buf |= (unsigned long long)*r->in++ << r->bits;
+      r->bits += 8;
+    }
+
+    unsigned long long e = table[r->buf & mask];
+    if (ENTRY_COUNT(e) == 0) {
+      if (ENTRY_BITS(e) == 0 || r->bits < tb) {
+        return ERROR;
+      }
+      r->buf >>= tb;
+      r->bits -= tb;
+      e = table[ENTRY_OFFSET(e) + (r->buf & ((1ULL << ENTRY_FIRST(e)) - 1))];
+      if (ENTRY_COUNT(e) == 0) {
+        return ERROR;
+      }
+    }
+
+    unsigned int len = ENTRY_FIRST(e);
+    if (len > r->bits) {
+      return ERROR;
+    }
+
+    if (wide) {
+      ((HuffmanSymbol *)dst)[pos] = (HuffmanSymbol)ENTRY_SYMBOL(e, 0);
+    } else {
+      ((unsigned char *)dst)[pos] = (unsigned char)ENTRY_SYMBOL(e, 0);
+    }
+    ++pos;
+    r->buf >>= len;
+    r->bits -= len;
+  }
+
+  return OK;
+}
+
+Status HuffmanDecode(const HuffmanDecoder *D, const unsigned char *src,
+                     size_t srcSize, HuffmanSymbol *dst, size_t count) {
+  BitReader r = {src, src + srcSize, 0, 0};
+
+  return DecodeStream(D, &r, dst, 0, count, 1);
+}
+
+Status HuffmanDecodeBytes(const HuffmanDecoder *D, const unsigned char *src,
+                          size_t srcSize, unsigned char *dst, size_t count) {
+  BitReader r = {src, src + srcSize, 0, 0};
+
+  return DecodeStream(D, &r, dst, 0, count, 0);
+}
+
+/* 按小端序读写 4 个字节. */
+static unsigned int Load32LE(const unsigned char *p) {
+  return (unsigned int)p[0] | (unsigned int)p[1] << 8 |
+         (unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+}
+
+static void Store32LE(unsigned char *p, unsigned int v) {
+  for (int i = 0; i < 4; ++i) {
+    p[i] = (unsigned char)(v >> (8 * i));
+  }
+}
+
+size_t HuffmanEncodeBytes4(const CanonicalHuffman *H, const unsigned char *src,
+                           size_t count, unsigned char *dst) {
+  size_t q = (count + 3) / 4;
+  unsigned char *out = dst + 12;
+
+  for (int k = 0; k < 4; ++k) {
+    size_t begin = q * k < count ? q * k : count;
+    size_t end = q * (k + 1) < count ? q * (k + 1) : count;
+    size_t size = EncodeCore(H, src + begin, end - begin, out, 0);
+
+    if (k < 3) {
+      Store32LE(dst + 4 * k, (unsigned int)size);
+    }
+    out += size;
+  }
+
+  return (size_t)(out - dst);
+}
+
+Status HuffmanDecodeBytes4(const HuffmanDecoder *D, const unsigned char *src,
+                           size_t srcSize, unsigned char *dst, size_t count) {
+  if (srcSize < 12) {
+    return ERROR;
+  }
+
+  /* 解析跳转表, 建立 4 个互相独立的读取器. */
+  BitReader r[4];
+  size_t pos[4], end[4];
+  size_t q = (count + 3) / 4;
+  const unsigned char *in = src + 12;
+  const unsigned char *srcEnd = src + srcSize;
+
+  for (int k = 0; k < 4; ++k) {
+    size_t size = k < 3 ? Load32LE(src + 4 * k) : (size_t)(srcEnd - in);
+    if (size > (size_t)(srcEnd - in)) {
+      return ERROR;
+    }
+    r[k].in = in;
+    r[k].end = in + size;
+    r[k].buf = 0;
+    r[k].bits = 0;
+    pos[k] = q * k < count ? q * k : count;
+    end[k] = q * (k + 1) < count ? q * (k + 1) : count;
+    in += size;
+  }
+
+  /* 4 条查表依赖链交错执行, 互相掩盖访存延迟. */
+  while (pos[0] + 6 <= end[0] && pos[1] + 6 <= end[1] &&
+         pos[2] + 6 <= end[2] && pos[3] + 6 <= end[3] &&
+         r[0].in + 8 <= r[0].end && r[1].in + 8 <= r[1].end &&
+         r[2].in + 8 <= r[2].end && r[3].in + 8 <= r[3].end) {
+    if (DecodeStep(D, &r[0], dst, &pos[0], 0) != OK ||
+        DecodeStep(D, &r[1], dst, &pos[1], 0) != OK ||
+        DecodeStep(D, &r[2], dst, &pos[2], 0) != OK ||
+        DecodeStep(D, &r[3], dst, &pos[3], 0) != OK) {
+      return ERROR;
+    }
+  }
+
+  for (int k = 0; k < 4; ++k) {
+    if (DecodeStream(D, &r[k], dst, pos[k], end[k], 0) != OK) {
+      return ERROR;
+    }
+  }
+
+  return OK;
+}
+
+Status DestroyHuffmanDecoder(HuffmanDecoder *D) {
+  free(D->table);
+  D->table = NULL;
+  D->tableBits = D->tableSize = 0;
+
+  return OK;
+}
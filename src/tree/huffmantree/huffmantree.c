@@ -0,0 +1,380 @@
+﻿/**
+ * @file huffmantree.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 赫夫曼树方法实现.
+ * @version 0.2
+ * @date 2020-04-28
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <huffmantree.h>
+#include <string.h>
+
+/* 排序用的 (权值, 叶结点下标) 对. */
+typedef struct HTLeaf {
+  HTWeight weight;
+  unsigned int index;
+} HTLeaf;
+
+/**
+ * @brief 按权值对叶结点做 LSD 基数排序, 每趟 8 位. 基数排序是稳定的, 输入按
+ * 下标有序, 所以权值相同时仍按下标排列. 所有元素该位都相同的趟直接跳过.
+ * @param leaf 待排序叶结点.
+ * @param n 叶结点个数.
+ */
+static void RadixSortLeaves(HTLeaf *leaf, int n) {
+  HTLeaf *orig = leaf;
+  HTLeaf *tmp = malloc(n * sizeof(HTLeaf));
+  if (!tmp) {
+    exit(OVERFLOW);
+  }
+
+  HTWeight all = 0;
+  for (int i = 0; i < n; ++i) {
+    all |= leaf[i].weight;
+  }
+
+  for (int shift = 0; shift < 64 && (all >> shift) != 0; shift += 8) {
+    int count[257] = {0};
+
+    for (int i = 0; i < n; ++i) {
+      ++count[((leaf[i].weight >> shift) & 0xff) + 1];
+    }
+    if (count[((leaf[0].weight >> shift) & 0xff) + 1] == n) {
+      continue;
+    }
+    for (int d = 0; d < 256; ++d) {
+      count[d + 1] += count[d];
+    }
+    for (int i = 0; i < n; ++i) {
+      tmp[count[(leaf[i].weight >> shift) & 0xff]++] = leaf[i];
+    }
+
+    HTLeaf *t = leaf;
+    leaf = tmp;
+    tmp = t;
+  }
+
+  /* 奇数趟后结果在辅助数组中, 需要拷回. */
+  if (leaf != orig) {
+    memcpy(orig, leaf, n * sizeof(HTLeaf));
+    tmp = leaf;
+  }
+
+  free(tmp);
+}
+
+Status CreateHuffmanTree(HuffmanTree *HT, const HTWeight *w, int n) {
+  if (n < 1 || n > HUFFMAN_MAX_SYMBOLS || !w) {
+    return ERROR;
+  }
+
+  /* 叶结点有 n 个, 所有结点有 2n - 1 个, 0 号空间未用. */
+  int m = 2 * n - 1;
+
+  *HT = malloc((m + 1) * sizeof(HTNode));
+  if (!*HT) {
+    exit(OVERFLOW);
+  }
+
+  HuffmanTree T = *HT;
+
+  memset(T, 0, (m + 1) * sizeof(HTNode));
+  for (int i = 1; i <= n; ++i) {
+    T[i].weight = w[i - 1];
+  }
+
+  if (n == 1) {
+    return OK;
+  }
+
+  /* 第一个队列: 按权值递增排列的叶结点. */
+  HTLeaf *leaf = malloc(n * sizeof(HTLeaf));
+  if (!leaf) {
+    exit(OVERFLOW);
+  }
+  for (int i = 0; i < n; ++i) {
+    leaf[i].weight = w[i];
+    leaf[i].index = i + 1;
+  }
+  RadixSortLeaves(leaf, n);
+
+  /**
+   * 第二个队列: 已生成的内部结点 T[n + 1 .. i - 1]. 每次合并的两个结点都是
+   * 当前最小的, 所以新结点的权值不会小于之前生成的任何内部结点, 这个队列天然
+   * 有序, 不需要堆.
+   */
+  int front1 = 0;     /* 叶结点队头. */
+  int front2 = n + 1; /* 内部结点队头. */
+
+  for (int i = n + 1; i <= m; ++i) {
+    unsigned int s[2];
+
+    for (int k = 0; k < 2; ++k) {
+      /* 权值相同时优先取叶结点, 可以使码长的方差更小. */
+      if (front1 < n &&
+          (front2 >= i || leaf[front1].weight <= T[front2].weight)) {
+        s[k] = leaf[front1++].index;
+      } else {
+        s[k] = front2++;
+      }
+    }
+
+    /* 新建结点, 编号为 i, 为 s1 和 s2 的父结点. */
+    T[s[0]].parent = i;
+    T[s[1]].parent = i;
+    T[i].lchild = s[0];
+    T[i].rchild = s[1];
+    T[i].weight = T[s[0]].weight + T[s[1]].weight;
+  }
+
+  free(leaf);
+
+  return OK;
+}
+
+Status HuffmanCodeLengths(HuffmanTree HT, int n, unsigned int *length) {
+  if (n == 1) {
+    length[0] = 1;
+    return OK;
+  }
+
+  int m = 2 * n - 1;
+
+  /* 借用 0 号单元之外的临时数组记录结点深度. */
+  unsigned int *depth = malloc((m + 1) * sizeof(unsigned int));
+  if (!depth) {
+    exit(OVERFLOW);
+  }
+
+  /* 父结点的下标总大于孩子, 从根开始倒序扫描时父结点的深度已求出. */
+  depth[m] = 0;
+  for (int i = m - 1; i >= 1; --i) {
+    depth[i] = depth[HT[i].parent] + 1;
+  }
+
+  for (int i = 1; i <= n; ++i) {
+    length[i - 1] = depth[i];
+  }
+
+  free(depth);
+
+  return OK;
+}
+
+HTWeight HuffmanWPL(HuffmanTree HT, int n) {
+  /* WPL 等于所有内部结点权值之和. */
+  HTWeight wpl = 0;
+
+  for (int i = n + 1; i <= 2 * n - 1; ++i) {
+    wpl += HT[i].weight;
+  }
+
+  return n == 1 ? HT[1].weight : wpl;
+}
+
+Status HuffmanCoding(HuffmanTree *HT, HuffmanCode *HC, const HTWeight *w,
+                     int n) {
+  if (CreateHuffmanTree(HT, w, n) != OK) {
+    return ERROR;
+  }
+
+  unsigned int *length = malloc(n * sizeof(unsigned int));
+  if (!length) {
+    exit(OVERFLOW);
+  }
+  HuffmanCodeLengths(*HT, n, length);
+
+  /* 分配 n 个字符编码的头指针向量, 0 号单元未用. */
+  *HC = malloc((n + 1) * sizeof(char *));
+  if (!*HC) {
+    exit(OVERFLOW);
+  }
+  (*HC)[0] = NULL;
+
+  for (int i = 1; i <= n; ++i) {
+    unsigned int len = length[i - 1];
+    char *cd = malloc(len + 1);
+    if (!cd) {
+      exit(OVERFLOW);
+    }
+    cd[len] = '\0';
+
+    if (n == 1) {
+      cd[0] = '0';
+    }
+
+    /* 从叶子到根逆向求编码, 左孩子为 '0', 右孩子为 '1'. */
+    unsigned int start = len;
+    for (unsigned int c = i, f = (*HT)[i].parent; f != 0;
+         c = f, f = (*HT)[f].parent) {
+      cd[--start] = (*HT)[f].lchild == c ? '0' : '1';
+    }
+
+    (*HC)[i] = cd;
+  }
+
+  free(length);
+
+  return OK;
+}
+
+Status DestroyHuffmanTree(HuffmanTree *HT) {
+  free(*HT);
+  *HT = NULL;
+
+  return OK;
+}
+
+Status DestroyHuffmanCode(HuffmanCode *HC, int n) {
+  if (*HC) {
+    for (int i = 1; i <= n; ++i) {
+      free((*HC)[i]);
+    }
+    free(*HC);
+    *HC = NULL;
+  }
+
+  return OK;
+}
+
+Status LimitedCodeLengths(const HTWeight *w, int n, int maxLength,
+                          unsigned char *length) {
+  if (n < 1 || n > HUFFMAN_MAX_SYMBOLS || maxLength < 1 ||
+      maxLength > HUFFMAN_MAX_CODE_LENGTH) {
+    return ERROR;
+  }
+
+  memset(length, 0, n);
+
+  /* 只为权值不为 0 的符号编码, 按权值递增排列. */
+  HTLeaf *leaf = malloc(n * sizeof(HTLeaf));
+  if (!leaf) {
+    exit(OVERFLOW);
+  }
+
+  int m = 0;
+  for (int i = 0; i < n; ++i) {
+    if (w[i] != 0) {
+      leaf[m].weight = w[i];
+      leaf[m].index = i;
+      ++m;
+    }
+  }
+
+  if (m <= 1) {
+    if (m == 1) {
+      length[leaf[0].index] = 1;
+    }
+    free(leaf);
+    return OK;
+  }
+
+  if ((1LL << maxLength) < m) {
+    free(leaf);
+    return ERROR;
+  }
+
+  /* 先试普通赫夫曼树, 大多数输入不会超过码长限制. */
+  HuffmanTree HT;
+  HTWeight *lw = malloc(m * sizeof(HTWeight));
+  unsigned int *len = malloc(m * sizeof(unsigned int));
+  if (!lw || !len) {
+    exit(OVERFLOW);
+  }
+  for (int i = 0; i < m; ++i) {
+    lw[i] = leaf[i].weight;
+  }
+  CreateHuffmanTree(&HT, lw, m);
+  HuffmanCodeLengths(HT, m, len);
+  DestroyHuffmanTree(&HT);
+
+  unsigned int longest = 0;
+  for (int i = 0; i < m; ++i) {
+    longest = len[i] > longest ? len[i] : longest;
+  }
+
+  if (longest <= (unsigned int)maxLength) {
+    for (int i = 0; i < m; ++i) {
+      length[leaf[i].index] = (unsigned char)len[i];
+    }
+    free(len);
+    free(lw);
+    free(leaf);
+    return OK;
+  }
+
+  free(len);
+  free(lw);
+
+  RadixSortLeaves(leaf, m);
+
+  /**
+   * package-merge. 第 j 层 (j = 0 为最深层) 的元素序列是叶结点与 pkg[j] 的
+   * 有序归并, pkg[j] 由第 j - 1 层序列中相邻两个元素打包而成. 每层最多只会
+   * 用到前 2m - 2 个元素, 所以每层的包不超过 m - 1 个.
+   */
+  int L = maxLength;
+  HTWeight *pkg = malloc((size_t)L * m * sizeof(HTWeight));
+  int *npkg = malloc(L * sizeof(int));
+  if (!pkg || !npkg) {
+    exit(OVERFLOW);
+  }
+
+  npkg[0] = 0;
+  for (int j = 1; j < L; ++j) {
+    const HTWeight *prev = pkg + (size_t)(j - 1) * m;
+    HTWeight *cur = pkg + (size_t)j * m;
+    int total = m + npkg[j - 1];
+    if (total > 2 * m - 2) {
+      total = 2 * m - 2;
+    }
+
+    /* 归并第 j - 1 层, 同时两两打包. 权值相同时叶结点在前. */
+    int a = 0, b = 0, k = 0;
+    HTWeight first = 0;
+    npkg[j] = 0;
+    while (k < total) {
+      HTWeight x;
+      if (b >= npkg[j - 1] || (a < m && leaf[a].weight <= prev[b])) {
+        x = leaf[a++].weight;
+      } else {
+        x = prev[b++];
+      }
+      if (k & 1) {
+        cur[npkg[j]++] = first + x;
+      } else {
+        first = x;
+      }
+      ++k;
+    }
+  }
+
+  /* 自顶向下: 被选中的前 c 个叶结点码长加 1, 被选中的包展开到下一层. */
+  int take = 2 * m - 2;
+  for (int j = L - 1; j >= 0 && take > 0; --j) {
+    const HTWeight *cur = pkg + (size_t)j * m;
+    int a = 0, b = 0;
+
+    for (int k = 0; k < take; ++k) {
+      if (b >= npkg[j] || (a < m && leaf[a].weight <= cur[b])) {
+        ++a;
+      } else {
+        ++b;
+      }
+    }
+
+    for (int i = 0; i < a; ++i) {
+      ++length[leaf[i].index];
+    }
+    take = 2 * b;
+  }
+
+  free(npkg);
+  free(pkg);
+  free(leaf);
+
+  return OK;
+}
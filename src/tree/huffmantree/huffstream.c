@@ -0,0 +1,592 @@
+﻿/**
+ * @file huffstream.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 分块流式压缩方法实现.
+ * @version 0.1
+ * @date 2020-04-28
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <huffstream.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/* 每个线程每批分到的块数. */
+#define BLOCKS_PER_THREAD 8
+
+static const unsigned char FILE_MAGIC[4] = {'H', 'U', 'F', 'Z'};
+static const unsigned char TAIL_MAGIC[4] = {'H', 'U', 'F', 'X'};
+static const unsigned int VERSION = 1;
+
+static unsigned int crcTable[8][256];
+static pthread_once_t crcOnce = PTHREAD_ONCE_INIT;
+
+static void InitCrcTable(void) {
+  for (unsigned int i = 0; i < 256; ++i) {
+    unsigned int c = i;
+    for (int k = 0; k < 8; ++k) {
+      c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    crcTable[0][i] = c;
+  }
+
+  /* crcTable[k][i] 为字节 i 后面再跟 k 个 0 字节的 CRC. */
+  for (unsigned int i = 0; i < 256; ++i) {
+    for (int k = 1; k < 8; ++k) {
+      unsigned int c = crcTable[k - 1][i];
+      crcTable[k][i] = crcTable[0][c & 0xff] ^ (c >> 8);
+    }
+  }
+}
+
+unsigned int Crc32(unsigned int crc, const unsigned char *data, size_t size) {
+  pthread_once(&crcOnce, InitCrcTable);
+
+  crc = ~crc;
+
+  /* slicing-by-8: 8 次查表互不依赖, 每次处理 8 个字节. */
+  for (; size >= 8; size -= 8, data += 8) {
+    unsigned int lo = crc ^ ((unsigned int)data[0] | data[1] << 8 |
+                             data[2] << 16 | (unsigned int)data[3] << 24);
+    unsigned int hi = (unsigned int)data[4] | data[5] << 8 | data[6] << 16 |
+                      (unsigned int)data[7] << 24;
+
+    crc = crcTable[7][lo & 0xff] ^ crcTable[6][(lo >> 8) & 0xff] ^
+          crcTable[5][(lo >> 16) & 0xff] ^ crcTable[4][lo >> 24] ^
+          crcTable[3][hi & 0xff] ^ crcTable[2][(hi >> 8) & 0xff] ^
+          crcTable[1][(hi >> 16) & 0xff] ^ crcTable[0][hi >> 24];
+  }
+  for (; size > 0; --size, ++data) {
+    crc = crcTable[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+  }
+
+  return ~crc;
+}
+
+static unsigned int Get32(const unsigned char *p) {
+  return (unsigned int)p[0] | (unsigned int)p[1] << 8 |
+         (unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+}
+
+static void Put32(unsigned char *p, unsigned int v) {
+  for (int i = 0; i < 4; ++i) {
+    p[i] = (unsigned char)(v >> (8 * i));
+  }
+}
+
+static unsigned long long Get64(const unsigned char *p) {
+  return (unsigned long long)Get32(p) | (unsigned long long)Get32(p + 4) << 32;
+}
+
+static void Put64(unsigned char *p, unsigned long long v) {
+  Put32(p, (unsigned int)v);
+  Put32(p + 4, (unsigned int)(v >> 32));
+}
+
+static void PutFrameHeader(unsigned char *p, size_t rawSize,
+                           size_t payloadSize, unsigned int crc, int type) {
+  Put32(p, (unsigned int)rawSize);
+  Put32(p + 4, (unsigned int)payloadSize);
+  Put32(p + 8, crc);
+  p[12] = (unsigned char)type;
+  p[13] = p[14] = p[15] = 0;
+}
+
+size_t HuffstreamFrameBound(size_t rawSize) {
+  return HUFFSTREAM_FRAME_HEADER + 128 +
+         HuffmanEncodeBound(rawSize, HUFFSTREAM_MAX_CODE_LENGTH);
+}
+
+size_t HuffstreamCompressBlock(const unsigned char *src, size_t rawSize,
+                               unsigned char *dst) {
+  unsigned int crc = Crc32(0, src, rawSize);
+  unsigned char *payload = dst + HUFFSTREAM_FRAME_HEADER;
+
+  /* 4 张子直方图轮流计数, 避免相邻相同字节造成的写后读依赖. */
+  unsigned int hist[4][256] = {{0}};
+  size_t i = 0;
+  for (; i + 4 <= rawSize; i += 4) {
+    ++hist[0][src[i]];
+    ++hist[1][src[i + 1]];
+    ++hist[2][src[i + 2]];
+    ++hist[3][src[i + 3]];
+  }
+  for (; i < rawSize; ++i) {
+    ++hist[0][src[i]];
+  }
+
+  HTWeight w[256];
+  int used = 0;
+  for (int s = 0; s < 256; ++s) {
+    w[s] = (HTWeight)hist[0][s] + hist[1][s] + hist[2][s] + hist[3][s];
+    used += w[s] != 0;
+  }
+
+  if (used == 1) {
+    payload[0] = src[0];
+    PutFrameHeader(dst, rawSize, 1, crc, HUFFSTREAM_RLE);
+    return HUFFSTREAM_FRAME_HEADER + 1;
+  }
+
+  CanonicalHuffman H;
+  if (used > 1 &&
+      BuildCanonicalHuffman(&H, w, 256, HUFFSTREAM_MAX_CODE_LENGTH) == OK) {
+    /* 码长不超过 15, 每个占 4 位. */
+    for (int s = 0; s < 256; s += 2) {
+      payload[s / 2] = (unsigned char)(H.length[s] | H.length[s + 1] << 4);
+    }
+
+    size_t size = 128 + HuffmanEncodeBytes4(&H, src, rawSize, payload + 128);
+    DestroyCanonicalHuffman(&H);
+
+    if (size < rawSize) {
+      PutFrameHeader(dst, rawSize, size, crc, HUFFSTREAM_HUFFMAN);
+      return HUFFSTREAM_FRAME_HEADER + size;
+    }
+  }
+
+  memcpy(payload, src, rawSize);
+  PutFrameHeader(dst, rawSize, rawSize, crc, HUFFSTREAM_STORED);
+
+  return HUFFSTREAM_FRAME_HEADER + rawSize;
+}
+
+Status HuffstreamDecompressBlock(const unsigned char *frame, size_t frameSize,
+                                 unsigned char *dst, size_t capacity,
+                                 size_t *rawSize) {
+  if (frameSize < HUFFSTREAM_FRAME_HEADER) {
+    return ERROR;
+  }
+
+  size_t raw = Get32(frame);
+  size_t size = Get32(frame + 4);
+  unsigned int crc = Get32(frame + 8);
+  const unsigned char *payload = frame + HUFFSTREAM_FRAME_HEADER;
+
+  if (raw > capacity || size > frameSize - HUFFSTREAM_FRAME_HEADER) {
+    return ERROR;
+  }
+
+  switch (frame[12]) {
+    case HUFFSTREAM_STORED:
+      if (size != raw) {
+        return ERROR;
+      }
+      memcpy(dst, payload, raw);
+      break;
+
+    case HUFFSTREAM_RLE:
+      if (size != 1) {
+        return ERROR;
+      }
+      memset(dst, payload[0], raw);
+      break;
+
+    case HUFFSTREAM_HUFFMAN: {
+      if (size < 128) {
+        return ERROR;
+      }
+
+      unsigned char length[256];
+      for (int s = 0; s < 256; s += 2) {
+        length[s] = payload[s / 2] & 0xf;
+        length[s + 1] = payload[s / 2] >> 4;
+      }
+
+      CanonicalHuffman H;
+      HuffmanDecoder D;
+      if (CreateCanonicalHuffman(&H, length, 256) != OK) {
+        return ERROR;
+      }
+      CreateHuffmanDecoder(&D, &H);
+      Status s = HuffmanDecodeBytes4(&D, payload + 128, size - 128, dst, raw);
+      DestroyHuffmanDecoder(&D);
+      DestroyCanonicalHuffman(&H);
+
+      if (s != OK) {
+        return ERROR;
+      }
+      break;
+    }
+
+    default:
+      return ERROR;
+  }
+
+  if (Crc32(0, dst, raw) != crc) {
+    return ERROR;
+  }
+
+  *rawSize = raw;
+
+  return OK;
+}
+
+/* 一个块的压缩或解压任务. */
+typedef struct HuffstreamJob {
+  unsigned char *src;
+  size_t srcSize;
+  unsigned char *dst;
+  size_t dstSize;
+  size_t capacity;
+  Status status;
+} HuffstreamJob;
+
+/* 一批任务, 各线程用原子计数器领取. */
+typedef struct HuffstreamBatch {
+  HuffstreamJob *job;
+  int count;
+  int decompress;
+  atomic_int next;
+} HuffstreamBatch;
+
+static void *HuffstreamWorker(void *arg) {
+  HuffstreamBatch *batch = arg;
+  int i;
+
+  while ((i = atomic_fetch_add(&batch->next, 1)) < batch->count) {
+    HuffstreamJob *job = &batch->job[i];
+
+    if (batch->decompress) {
+      job->status = HuffstreamDecompressBlock(job->src, job->srcSize, job->dst,
+                                              job->capacity, &job->dstSize);
+    } else {
+      job->dstSize = HuffstreamCompressBlock(job->src, job->srcSize, job->dst);
+      job->status = OK;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief 用 threads 个线程处理一批任务, 调用线程也参与. 任一任务失败则返回
+ * ERROR.
+ */
+static Status RunBatch(HuffstreamJob *job, int count, int decompress,
+                       int threads) {
+  HuffstreamBatch batch;
+  pthread_t tid[64];
+  int spawned = 0;
+
+  batch.job = job;
+  batch.count = count;
+  batch.decompress = decompress;
+  atomic_init(&batch.next, 0);
+
+  if (threads > count) {
+    threads = count;
+  }
+  for (int t = 1; t < threads && t < 64; ++t) {
+    if (pthread_create(&tid[spawned], NULL, HuffstreamWorker, &batch) == 0) {
+      ++spawned;
+    }
+  }
+
+  HuffstreamWorker(&batch);
+
+  for (int t = 0; t < spawned; ++t) {
+    pthread_join(tid[t], NULL);
+  }
+
+  for (int i = 0; i < count; ++i) {
+    if (job[i].status != OK) {
+      return ERROR;
+    }
+  }
+
+  return OK;
+}
+
+/* 写出并累计偏移. */
+static Status WriteAll(FILE *out, const void *p, size_t size,
+                       unsigned long long *offset) {
+  if (fwrite(p, 1, size, out) != size) {
+    return ERROR;
+  }
+  *offset += size;
+
+  return OK;
+}
+
+Status HuffstreamCompress(FILE *in, FILE *out, size_t blockSize, int threads,
+                          HuffstreamStat *stat) {
+  if (blockSize == 0) {
+    blockSize = HUFFSTREAM_BLOCK_SIZE;
+  }
+  if (blockSize > HUFFSTREAM_MAX_BLOCK_SIZE || threads < 1) {
+    return ERROR;
+  }
+
+  int slots = threads * BLOCKS_PER_THREAD;
+  size_t bound = HuffstreamFrameBound(blockSize);
+  unsigned char *inBuf = malloc((size_t)slots * blockSize);
+  unsigned char *outBuf = malloc((size_t)slots * bound);
+  HuffstreamJob *job = malloc(slots * sizeof(HuffstreamJob));
+  if (!inBuf || !outBuf || !job) {
+    exit(OVERFLOW);
+  }
+
+  /* 块索引, 按需倍增. */
+  unsigned int blocks = 0, indexSize = 1024;
+  unsigned long long *index = malloc(indexSize * sizeof(unsigned long long));
+  if (!index) {
+    exit(OVERFLOW);
+  }
+
+  unsigned long long offset = 0, rawBytes = 0;
+  unsigned char header[16];
+  Status status = OK;
+
+  memcpy(header, FILE_MAGIC, 4);
+  Put32(header + 4, VERSION);
+  Put32(header + 8, (unsigned int)blockSize);
+  Put32(header + 12, 0);
+  status = WriteAll(out, header, 16, &offset);
+
+  while (status == OK) {
+    /* 一次读入一整批, 大块顺序读. */
+    size_t got = fread(inBuf, 1, (size_t)slots * blockSize, in);
+    if (got == 0) {
+      status = ferror(in) ? ERROR : OK;
+      break;
+    }
+
+    int count = (int)((got + blockSize - 1) / blockSize);
+    for (int i = 0; i < count; ++i) {
+      size_t begin = (size_t)i * blockSize;
+      job[i].src = inBuf + begin;
+      job[i].srcSize = got - begin < blockSize ? got - begin : blockSize;
+      job[i].dst = outBuf + (size_t)i * bound;
+    }
+
+    RunBatch(job, count, 0, threads);
+
+    for (int i = 0; i < count && status == OK; ++i) {
+      if (blocks == indexSize) {
+        indexSize *= 2;
+        index = realloc(index, indexSize * sizeof(unsigned long long));
+        if (!index) {
+          exit(OVERFLOW);
+        }
+      }
+      index[blocks++] = offset;
+      rawBytes += job[i].srcSize;
+      status = WriteAll(out, job[i].dst, job[i].dstSize, &offset);
+    }
+
+    /* 读到文件尾. */
+    if (got < (size_t)slots * blockSize) {
+      if (ferror(in)) {
+        status = ERROR;
+      }
+      break;
+    }
+  }
+
+  if (status == OK) {
+    /* 结束块和文件尾. */
+    size_t size = 4 + (size_t)blocks * 8;
+    unsigned char *tail = malloc(HUFFSTREAM_FRAME_HEADER + size + 20);
+    if (!tail) {
+      exit(OVERFLOW);
+    }
+
+    unsigned char *p = tail + HUFFSTREAM_FRAME_HEADER;
+    Put32(p, blocks);
+    for (unsigned int i = 0; i < blocks; ++i) {
+      Put64(p + 4 + 8 * i, index[i]);
+    }
+    PutFrameHeader(tail, 0, size, Crc32(0, p, size), HUFFSTREAM_END);
+
+    p += size;
+    Put64(p, offset);
+    Put64(p + 8, rawBytes);
+    memcpy(p + 16, TAIL_MAGIC, 4);
+
+    status = WriteAll(out, tail, HUFFSTREAM_FRAME_HEADER + size + 20, &offset);
+    free(tail);
+  }
+
+  if (status == OK && fflush(out) != 0) {
+    status = ERROR;
+  }
+
+  if (stat) {
+    stat->rawBytes = rawBytes;
+    stat->packedBytes = offset;
+    stat->blocks = blocks;
+  }
+
+  free(index);
+  free(job);
+  free(outBuf);
+  free(inBuf);
+
+  return status;
+}
+
+Status HuffstreamDecompress(FILE *in, FILE *out, int threads,
+                            HuffstreamStat *stat) {
+  unsigned char header[16];
+
+  if (threads < 1 || fread(header, 1, 16, in) != 16 ||
+      memcmp(header, FILE_MAGIC, 4) != 0 || Get32(header + 4) != VERSION) {
+    return ERROR;
+  }
+
+  size_t blockSize = Get32(header + 8);
+  if (blockSize == 0 || blockSize > HUFFSTREAM_MAX_BLOCK_SIZE) {
+    return ERROR;
+  }
+
+  int slots = threads * BLOCKS_PER_THREAD;
+  size_t bound = HuffstreamFrameBound(blockSize);
+  unsigned char *inBuf = malloc((size_t)slots * bound);
+  unsigned char *outBuf = malloc((size_t)slots * blockSize);
+  HuffstreamJob *job = malloc(slots * sizeof(HuffstreamJob));
+  if (!inBuf || !outBuf || !job) {
+    exit(OVERFLOW);
+  }
+
+  unsigned long long packedBytes = 16, rawBytes = 0;
+  unsigned int blocks = 0;
+  Status status = OK;
+  int end = 0;
+
+  while (status == OK && !end) {
+    int count = 0;
+
+    /* 读入一批块, 遇到结束块为止. */
+    while (count < slots) {
+      unsigned char *frame = inBuf + (size_t)count * bound;
+
+      if (fread(frame, 1, HUFFSTREAM_FRAME_HEADER, in) !=
+          HUFFSTREAM_FRAME_HEADER) {
+        status = ERROR;
+        break;
+      }
+      packedBytes += HUFFSTREAM_FRAME_HEADER;
+
+      size_t size = Get32(frame + 4);
+      if (frame[12] == HUFFSTREAM_END) {
+        end = 1;
+        break;
+      }
+      if (Get32(frame) > blockSize ||
+          size > bound - HUFFSTREAM_FRAME_HEADER ||
+          fread(frame + HUFFSTREAM_FRAME_HEADER, 1, size, in) != size) {
+        status = ERROR;
+        break;
+      }
+      packedBytes += size;
+
+      job[count].src = frame;
+      job[count].srcSize = HUFFSTREAM_FRAME_HEADER + size;
+      job[count].dst = outBuf + (size_t)count * blockSize;
+      job[count].capacity = blockSize;
+      ++count;
+    }
+
+    if (status == OK && count > 0) {
+      status = RunBatch(job, count, 1, threads);
+    }
+
+    for (int i = 0; i < count && status == OK; ++i) {
+      if (fwrite(job[i].dst, 1, job[i].dstSize, out) != job[i].dstSize) {
+        status = ERROR;
+      }
+      rawBytes += job[i].dstSize;
+      ++blocks;
+    }
+  }
+
+  if (status == OK && fflush(out) != 0) {
+    status = ERROR;
+  }
+
+  if (stat) {
+    stat->rawBytes = rawBytes;
+    stat->packedBytes = packedBytes;
+    stat->blocks = blocks;
+  }
+
+  free(job);
+  free(outBuf);
+  free(inBuf);
+
+  return status;
+}
+
+Status HuffstreamReadIndex(FILE *in, unsigned long long **offset,
+                           unsigned int *count, unsigned long long *rawBytes) {
+  unsigned char tail[20], frame[HUFFSTREAM_FRAME_HEADER];
+
+  if (fseek(in, -20, SEEK_END) != 0 || fread(tail, 1, 20, in) != 20 ||
+      memcmp(tail + 16, TAIL_MAGIC, 4) != 0) {
+    return ERROR;
+  }
+
+  unsigned long long end = Get64(tail);
+  if (fseek(in, (long)end, SEEK_SET) != 0 ||
+      fread(frame, 1, HUFFSTREAM_FRAME_HEADER, in) != HUFFSTREAM_FRAME_HEADER ||
+      frame[12] != HUFFSTREAM_END) {
+    return ERROR;
+  }
+
+  size_t size = Get32(frame + 4);
+  unsigned char *p = malloc(size > 4 ? size : 4);
+  if (!p) {
+    exit(OVERFLOW);
+  }
+  if (size < 4 || fread(p, 1, size, in) != size ||
+      Crc32(0, p, size) != Get32(frame + 8) ||
+      size != 4 + (size_t)Get32(p) * 8) {
+    free(p);
+    return ERROR;
+  }
+
+  *count = Get32(p);
+  *offset = malloc((*count + 1) * sizeof(unsigned long long));
+  if (!*offset) {
+    exit(OVERFLOW);
+  }
+  for (unsigned int i = 0; i < *count; ++i) {
+    (*offset)[i] = Get64(p + 4 + 8 * i);
+  }
+  /* 哨兵: 最后一块的结束位置即结束块的偏移. */
+  (*offset)[*count] = end;
+  *rawBytes = Get64(tail + 8);
+
+  free(p);
+
+  return OK;
+}
+
+Status HuffstreamReadBlock(FILE *in, const unsigned long long *offset,
+                           unsigned int k, unsigned char *dst,
+                           size_t capacity, size_t *rawSize) {
+  if (offset[k + 1] <= offset[k] ||
+      offset[k + 1] - offset[k] > HuffstreamFrameBound(capacity)) {
+    return ERROR;
+  }
+
+  size_t size = (size_t)(offset[k + 1] - offset[k]);
+  unsigned char *frame = malloc(size);
+  if (!frame) {
+    exit(OVERFLOW);
+  }
+
+  Status status = ERROR;
+  if (fseek(in, (long)offset[k], SEEK_SET) == 0 &&
+      fread(frame, 1, size, in) == size) {
+    status = HuffstreamDecompressBlock(frame, size, dst, capacity, rawSize);
+  }
+
+  free(frame);
+
+  return status;
+}
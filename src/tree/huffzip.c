@@ -0,0 +1,139 @@
+﻿/**
+ * @file huffzip.c
+ * @author 田世豪 (tianshihao@4944@126.com)
+ * @brief 赫夫曼分块压缩命令行工具.
+ * @version 0.1
+ * @date 2020-04-28
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <huffstream.h>
+#include <string.h>
+#include <time.h>
+
+/* 输入输出缓冲区大小. */
+#define IO_BUFFER_SIZE (4 * 1024 * 1024)
+
+static void Usage() {
+  fprintf(stderr,
+          "usage: huffzip [-d] [-t threads] [-b blockKB] input output\n"
+          "       huffzip -l input\n"
+          "  -d  decompress\n"
+          "  -t  worker threads (default 1, at most 64)\n"
+          "  -b  block size in KB (default 128)\n"
+          "  -l  list blocks through the random-access index\n");
+}
+
+static double Now() {
+  struct timespec ts;
+
+  timespec_get(&ts, TIME_UTC);
+
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 打印块索引, 并逐块随机读取校验. */
+static int List(const char *path) {
+  FILE *in = fopen(path, "rb");
+  if (!in) {
+    perror(path);
+    return 1;
+  }
+
+  unsigned long long *offset, rawBytes;
+  unsigned int count;
+  if (HuffstreamReadIndex(in, &offset, &count, &rawBytes) != OK) {
+    fprintf(stderr, "%s: no valid index\n", path);
+    fclose(in);
+    return 1;
+  }
+
+  unsigned char *block = malloc(HUFFSTREAM_MAX_BLOCK_SIZE);
+  if (!block) {
+    exit(OVERFLOW);
+  }
+
+  int bad = 0;
+  printf("%u blocks, %llu bytes\n", count, rawBytes);
+  for (unsigned int k = 0; k < count; ++k) {
+    size_t raw = 0;
+    Status s = HuffstreamReadBlock(in, offset, k, block,
+                                   HUFFSTREAM_MAX_BLOCK_SIZE, &raw);
+    printf("%8u  offset %12llu  packed %8llu  raw %8zu  %s\n", k, offset[k],
+           offset[k + 1] - offset[k], raw, s == OK ? "ok" : "CORRUPT");
+    bad += s != OK;
+  }
+
+  free(block);
+  free(offset);
+  fclose(in);
+
+  return bad != 0;
+}
+
+int main(int argc, char *argv[]) {
+  int decompress = 0, threads = 1, i = 1;
+  size_t blockSize = HUFFSTREAM_BLOCK_SIZE;
+
+  for (; i < argc && argv[i][0] == '-'; ++i) {
+    if (strcmp(argv[i], "-d") == 0) {
+      decompress = 1;
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      threads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      blockSize = (size_t)atoi(argv[++i]) * 1024;
+    } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+      return List(argv[i + 1]);
+    } else {
+      Usage();
+      return 1;
+    }
+  }
+
+  if (argc - i != 2 || threads < 1 || threads > 64 || blockSize == 0 ||
+      blockSize > HUFFSTREAM_MAX_BLOCK_SIZE) {
+    Usage();
+    return 1;
+  }
+
+  FILE *in = fopen(argv[i], "rb");
+  FILE *out = fopen(argv[i + 1], "wb");
+  if (!in || !out) {
+    perror(!in ? argv[i] : argv[i + 1]);
+    return 1;
+  }
+
+  /* 大缓冲顺序读写, 减少系统调用. */
+  setvbuf(in, NULL, _IOFBF, IO_BUFFER_SIZE);
+  setvbuf(out, NULL, _IOFBF, IO_BUFFER_SIZE);
+
+  HuffstreamStat stat;
+  double start = Now();
+  Status s = decompress ? HuffstreamDecompress(in, out, threads, &stat)
+                        : HuffstreamCompress(in, out, blockSize, threads, &stat);
+  double seconds = Now() - start;
+
+  fclose(in);
+  if (fclose(out) != 0) {
+    s = ERROR;
+  }
+
+  if (s != OK) {
+    fprintf(stderr, "huffzip: %s failed\n",
+            decompress ? "decompression" : "compression");
+    return 1;
+  }
+
+  fprintf(stderr,
+          "%llu -> %llu bytes (%.2f%%), %u blocks, %d threads, %.3f s, "
+          "%.1f MB/s\n",
+          decompress ? stat.packedBytes : stat.rawBytes,
+          decompress ? stat.rawBytes : stat.packedBytes,
+          stat.rawBytes ? 100.0 * stat.packedBytes / stat.rawBytes : 0.0,
+          stat.blocks, threads, seconds,
+          seconds > 0 ? stat.rawBytes / seconds / 1e6 : 0.0);
+
+  return 0;
+}
@@ -11,11 +11,13 @@
 
 #include <bitree.h>
 #include <bstree.h>
+#include <huffmantree.h>
 #include <threadtree.h>
 
 void TestBinaryTree();
 void TestThreadTree();
 void TestBSTree();
+void TestHuffmanTree();
 Status MyVisit(BiTElemType e);
 
 int main() {
@@ -31,6 +33,8 @@ int main() {
 
   // TestBSTree();
 
+  // TestHuffmanTree();
+
   system("pause");
 
   return 0;
@@ -153,6 +157,48 @@ void TestBSTree() {
   return;
 }
 
+void TestHuffmanTree() {
+  HuffmanTree HT;
+  HuffmanCode HC;
+
+  HTWeight w[8] = {5, 29, 7, 8, 14, 23, 3, 11};
+
+  HuffmanCoding(&HT, &HC, w, 8);
+
+  for (int i = 1; i <= 8; ++i) {
+    printf("w = %2llu, code = %s\n", w[i - 1], HC[i]);
+  }
+
+  printf("wpl = %llu\n", HuffmanWPL(HT, 8));
+
+  DestroyHuffmanCode(&HC, 8);
+  DestroyHuffmanTree(&HT);
+
+  // 码长不超过 4 的范式编码, 编码后再译码.
+  CanonicalHuffman H;
+  HuffmanDecoder D;
+  HuffmanSymbol text[8] = {1, 5, 1, 4, 0, 7, 6, 1};
+  HuffmanSymbol out[8];
+  unsigned char buf[128];
+
+  BuildCanonicalHuffman(&H, w, 8, 4);
+  CreateHuffmanDecoder(&D, &H);
+
+  size_t size = HuffmanEncode(&H, text, 8, buf);
+  if (OK == HuffmanDecode(&D, buf, size, out, 8)) {
+    printf("%zu bytes, decoded:", size);
+    for (int i = 0; i < 8; ++i) {
+      printf(" %d", out[i]);
+    }
+    printf("\n");
+  }
+
+  DestroyHuffmanDecoder(&D);
+  DestroyCanonicalHuffman(&H);
+
+  return;
+}
+
 Status MyVisit(BiTElemType e) {
   printf("%c", e);
 